@@ -22,12 +22,15 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 05/04/2024 | Document creation		                         						|
+ * | 19/10/2026 | Character range macros		                         						|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
 /*==================[macros]=================================================*/
+#define FONT_FIRST_CHAR	' '		/*!< First character of every font (info[0]) */
+#define FONT_LAST_CHAR	'~'		/*!< Last character of every font */
 
 /*==================[typedef]================================================*/
 /**
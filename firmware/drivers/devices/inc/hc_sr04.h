@@ -14,6 +14,12 @@
  * 
  * @note When disconnected return 0.
  * 
+ * @note HcSr04ReadDistanceInCentimeters() and HcSr04ReadDistanceInInches() 
+ * block until the echo ends (up to ~24ms, 10us resolution). For non-blocking 
+ * measurements use HcSr04AsyncInit(), HcSr04Trigger() and HcSr04GetMeasure():
+ * the echo width is captured by the MCPWM capture unit (sub-usec resolution)
+ * and delivered through a queue.
+ * 
  * @note When ussing dedicated connector in ESP-EDU:
  * |   HC_SR04      |   EDU-CIAA	|
  * |:--------------:|:-------------:|
@@ -29,6 +35,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Non-blocking capture based measurement		   						|
  * 
  **/
 
@@ -37,8 +44,26 @@
 #include <stdint.h>
 #include "gpio_mcu.h"
 /*==================[macros]=================================================*/
-
+#define HC_SR04_NO_TIMEOUT	0xFFFFFFFF	/*!< Wait forever on HcSr04GetMeasure() */
 /*==================[typedef]================================================*/
+/**
+ * @brief Result of an asynchronous measurement
+ */
+typedef enum {
+	HC_SR04_OK = 0,			/*!< Valid measurement */
+	HC_SR04_TIMEOUT,		/*!< No echo received (sensor disconnected) */
+	HC_SR04_OUT_OF_RANGE,	/*!< Echo longer than maximum distance */
+} hc_sr04_status_t;
+
+/**
+ * @brief Asynchronous measurement
+ */
+typedef struct {
+	hc_sr04_status_t status;	/*!< Measurement result */
+	uint32_t echo_ns;			/*!< Echo pulse width (in ns) */
+	uint16_t distance_mm;		/*!< Measured distance (in mm) */
+	uint32_t timestamp;			/*!< Time of the trigger (in usec) */
+} hc_sr04_measure_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -69,10 +94,43 @@ uint16_t HcSr04ReadDistanceInInches(void);
 /**
  * @brief HC_SR04 de-initialization.
  * 
+ * Frees the capture channel and timer, the echo timeout and the measurement 
+ * queue of HcSr04AsyncInit(), so it can be initialized again.
+ * 
  * @return true 
  */
 bool HcSr04Deinit(void);
 
+/**
+ * @brief HC_SR04 initialization for non-blocking measurements.
+ * 
+ * @note Uses one MCPWM capture channel on the echo pin.
+ * 
+ * @param echo GPIO number wher echo pin is connected
+ * @param trigger GPIO number wher trigger pin is connected
+ * @return true 
+ * @return false if the capture channel could not be configured
+ */
+bool HcSr04AsyncInit(gpio_t echo, gpio_t trigger);
+
+/**
+ * @brief Starts a measurement and returns immediately.
+ * 
+ * @return true Measurement started
+ * @return false A measurement is already in progress (or HcSr04AsyncInit() was not called)
+ */
+bool HcSr04Trigger(void);
+
+/**
+ * @brief Gets the result of the last measurement started with HcSr04Trigger().
+ * 
+ * @param measure Pointer to variable where the result will be stored
+ * @param timeout_ms Maximum time to wait (0: don't wait, HC_SR04_NO_TIMEOUT: wait forever)
+ * @return true A result was read
+ * @return false No result before timeout
+ */
+bool HcSr04GetMeasure(hc_sr04_measure_t *measure, uint32_t timeout_ms);
+
 /*==================[end of file]============================================*/
 #endif /* #ifndef HC_SR04_H */
 
@@ -0,0 +1,113 @@
+#ifndef HC_SR04_ARRAY_H
+#define HC_SR04_ARRAY_H
+
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup HC_SR04_ARRAY HC SR04 Array
+ ** @{ */
+
+/** \brief Driver for arrays of HC-SR04 modules.
+ *
+ * A scheduler task fires the sensors by groups: sensors in the same group are
+ * triggered together (they must not hear each other's echoes), groups are
+ * fired one after the other. A group slot ends as soon as every echo of the
+ * group is received (or after the echo timeout), followed by a guard time to
+ * let the ultrasonic burst decay before the next group. With one sensor per
+ * group the array works in round-robin mode.
+ *
+ * Echo edges are timestamped with the GPIO capture driver (1us resolution),
+ * so any GPIO can be used as echo input. Each sensor has an optional
+ * streaming median filter that rejects isolated spikes and timeouts.
+ *
+ * @note The GPIO capture event queue is consumed by this driver while the
+ * scheduler is running.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "gpio_mcu.h"
+#include "hc_sr04.h"
+/*==================[macros]=================================================*/
+#define HC_SR04_ARRAY_MAX			8	/*!< Maximum number of sensors in the array */
+#define HC_SR04_ARRAY_MEDIAN_MAX	7	/*!< Maximum size of the median filter window */
+/*==================[typedef]================================================*/
+/**
+ * @brief Sensor of the array
+ */
+typedef struct {
+	gpio_t echo;		/*!< GPIO number where echo pin is connected */
+	gpio_t trigger;		/*!< GPIO number where trigger pin is connected */
+	uint8_t group;		/*!< Firing group (sensors in the same group are triggered together) */
+} hc_sr04_sensor_t;
+
+/**
+ * @brief Array configuration
+ */
+typedef struct {
+	hc_sr04_sensor_t *sensors;	/*!< Pointer to array of sensors */
+	uint8_t sensors_qty;		/*!< Number of sensors (up to HC_SR04_ARRAY_MAX) */
+	uint16_t guard_us;			/*!< Silence time after each group to avoid crosstalk (in usec) */
+	uint8_t median_size;		/*!< Median filter window (1: disabled, odd up to HC_SR04_ARRAY_MEDIAN_MAX) */
+} hc_sr04_array_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Sensors array initialization.
+ *
+ * @param config Pointer to array configuration
+ * @return true
+ * @return false if the configuration is not valid
+ */
+bool HcSr04ArrayInit(hc_sr04_array_config_t *config);
+
+/**
+ * @brief Starts the scheduler task (measurements run continuously).
+ *
+ * @return true
+ * @return false if the scheduler is already running or the task could not be created
+ */
+bool HcSr04ArrayStart(void);
+
+/**
+ * @brief Stops the scheduler after the group in progress.
+ *
+ * @note Blocks until the scheduler task ends (up to one echo timeout, ~25 ms).
+ */
+void HcSr04ArrayStop(void);
+
+/**
+ * @brief Reads the last (filtered) measurement of a sensor.
+ *
+ * @param sensor Sensor index in the configuration array
+ * @param measure Pointer to variable where the measurement will be stored
+ * @return true
+ * @return false if the sensor doesn't exist or has no measurements yet
+ */
+bool HcSr04ArrayRead(uint8_t sensor, hc_sr04_measure_t *measure);
+
+/**
+ * @brief Aggregate measurement rate achieved by the scheduler.
+ *
+ * @return uint32_t Measurements per second (all sensors) since HcSr04ArrayStart()
+ */
+uint32_t HcSr04ArrayRate(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef HC_SR04_ARRAY_H */
+
+/*==================[end of file]============================================*/
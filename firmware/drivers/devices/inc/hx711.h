@@ -10,6 +10,13 @@
 /** \brief The HX711 amplifier is a breakout board that allows you to easily read load cells to measure weight. It communicates with the EDU-ESP
  * board via I2C.
  * 
+ * @note HX711_read() and the functions built on it block until a conversion is 
+ * ready (~100 ms at 10 SPS). For non-blocking use call HX711_AsyncInit(): a 
+ * driver task waits for the DOUT falling edge (data ready interruption), clocks 
+ * the bits out in a short critical section and stores timestamped samples in a 
+ * buffer read with HX711_readSamples(). Tare is also done in background with 
+ * HX711_tareAsync().
+ * 
  * @author Juan Ignacio Cerrudo
  *
  * @section changelog
@@ -17,14 +24,24 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         						|
+ * | 19/10/2026 | Interrupt driven, non-blocking reader	     						|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <gpio_mcu.h>
 /*==================[macros]=================================================*/
-
+#define HX711_BUFFER_SIZE	32			/*!< Samples stored by the asynchronous reader */
+#define HX711_NO_TIMEOUT	0xFFFFFFFF	/*!< Wait forever on HX711_readSamples() */
 /*==================[typedef]================================================*/
+/**
+ * @brief Sample delivered by the asynchronous reader
+ */
+typedef struct {
+	int32_t raw;			/*!< Conversion result (signed 24 bits) */
+	int32_t value;			/*!< raw minus the tare offset */
+	uint32_t timestamp;		/*!< Time when the conversion was ready (in usec) */
+} hx711_sample_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -120,6 +137,43 @@ void HX711_powerDown(void);
  */
 void HX711_powerUp(void);
 
+/** @fn HX711_AsyncInit(uint8_t gain, gpio_t pd_sck, gpio_t dout)
+ * @brief Define clock and data pin, gain factor and starts the asynchronous reader
+ * @param[in] gain Gain
+ * @param[in] pd_sck Clock pin
+ * @param[in] dout Datapin
+ * @return true if the reader was started
+ */
+bool HX711_AsyncInit(uint8_t gain, gpio_t pd_sck, gpio_t dout);
+
+/** @fn HX711_available(void)
+ * @brief Number of samples waiting in the buffer
+ * @return Number of samples
+ */
+uint16_t HX711_available(void);
+
+/** @fn HX711_readSamples(hx711_sample_t *samples, uint16_t max_samples, uint32_t timeout_ms)
+ * @brief Reads samples from the buffer. Waits up to timeout_ms only if the buffer is empty.
+ * @note When the buffer is full the oldest sample is discarded
+ * @param[out] samples Pointer to array where samples will be stored
+ * @param[in] max_samples Size of the array
+ * @param[in] timeout_ms Maximum time to wait for the first sample (0: don't wait, HX711_NO_TIMEOUT: wait forever)
+ * @return Number of samples read
+ */
+uint16_t HX711_readSamples(hx711_sample_t *samples, uint16_t max_samples, uint32_t timeout_ms);
+
+/** @fn HX711_tareAsync(uint8_t times)
+ * @brief Starts a background tare: the offset is the average of the next times samples
+ * @param[in] times How many samples to average
+ */
+void HX711_tareAsync(uint8_t times);
+
+/** @fn HX711_tareDone(void)
+ * @brief Checks if the background tare finished
+ * @return true if there is no tare in progress
+ */
+bool HX711_tareDone(void);
+
 /*==================[internal functions declaration]=========================*/
 // Sends/receives data. 
 uint8_t shiftIn(void);
@@ -12,6 +12,27 @@
  * TFT color display connected to the ESP-EDU. It uses a SPI port and 3 GPIOs to 
  * communicate with the ILI9341 LCD driver chip.
  *
+ * @note Commands and pixel data are queued as SPI DMA transactions (the D/C
+ * line is set by the SPI driver before each one), so drawing functions return
+ * while the data is still being sent.
+ *
+ * @note An optional framebuffer can hold a stripe of rows of the screen
+ * (ILI9341FramebufferInit()): drawing functions write the rows inside the
+ * stripe in RAM and record the changed areas, and ILI9341Flush() sends only
+ * those areas. Rows outside the stripe are still drawn directly on the panel.
+ *
+ * @note Characters are kept rendered in RGB565 in a cache (least recently
+ * used ones are freed), and each line of a string or integer is sent in a
+ * single window.
+ *
+ * @note The trace renderer (ILI9341TraceInit()) plots samples in landscape
+ * orientation using the vertical scrolling of the controller: each new column
+ * is written once and the plot is scrolled, so the rest of the plot is never
+ * redrawn.
+ *
+ * @note Images can be stored compressed (palette and run length encoding,
+ * see ILI9341DrawImage() and firmware/tools/ili9341_image.py).
+ *
  * @author Albano Peñalva
  *
  * @note Hardware connections:
@@ -33,11 +54,18 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 18/01/2024 | Document creation		                         |
+ * | 19/10/2026 | Persistent SPI device and queued DMA transfers |
+ * | 19/10/2026 | Framebuffer stripe with dirty areas			 |
+ * | 19/10/2026 | Lines and circles drawn as spans				 |
+ * | 19/10/2026 | Glyph cache and single window text			 |
+ * | 19/10/2026 | Scrolling trace renderer						 |
+ * | 19/10/2026 | Compressed images (palette + RLE)				 |
  *
  */
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include "spi_mcu.h"
 #include "fonts.h"
 #include "icons.h"
@@ -46,6 +74,11 @@
 #define ILI9341_WIDTH       240			/*!< LCD width in pixels */
 #define ILI9341_HEIGHT      320			/*!< LCD height in pixels */
 #define ILI9341_PIXEL_MAX	76800
+#define ILI9341_DIRTY_MAX	8			/*!< Dirty areas tracked by the framebuffer (then they are merged) */
+#define ILI9341_GLYPH_CACHE_SIZE	32		/*!< Characters kept rendered */
+#define ILI9341_GLYPH_CACHE_BYTES	16384	/*!< Memory for rendered characters (larger ones are not cached) */
+#define ILI9341_TRACES_MAX	4			/*!< Traces of the trace renderer */
+#define ILI9341_PALETTE_MAX	256			/*!< Colors of a compressed image */
 /* 16bits colors (RGB565) */			/*	 R,   G,   B */
 #define ILI9341_BLACK          	0x0000  /*   0,   0,   0 */
 #define ILI9341_NAVY           	0x000F 	/*   0,   0, 128 */
@@ -80,6 +113,52 @@ typedef enum ili9341_orientation {
 	ILI9341_Landscape_1, 	/*!< Landscape orientation mode 1 */
 	ILI9341_Landscape_2  	/*!< Landscape orientation mode 2 */
 } ili9341_orientation_t;
+
+/**
+ * @brief  Rectangular area of the LCD (inclusive coordinates)
+ */
+typedef struct {
+	uint16_t x0;	/*!< First column */
+	uint16_t y0;	/*!< First row */
+	uint16_t x1;	/*!< Last column */
+	uint16_t y1;	/*!< Last row */
+} ili9341_rect_t;
+
+/**
+ * @brief  Compressed image
+ *
+ * Pixels are palette indexes, stored row after row as packets (packets can
+ * continue on the next row). Each packet starts with a header byte:
+ * - 0x80 | (n - 1): run of n pixels (1 to 128) of the color in the next byte.
+ * - (n - 1): n literal pixels (1 to 128), one index per byte.
+ */
+typedef struct {
+	uint16_t width;				/*!< Image width in pixels */
+	uint16_t height;			/*!< Image height in pixels */
+	uint16_t palette_size;		/*!< Colors in palette (up to ILI9341_PALETTE_MAX) */
+	const uint16_t *palette;	/*!< Colors (RGB565) */
+	const uint8_t *data;		/*!< Packets */
+	uint32_t data_size;			/*!< Bytes in data */
+} ili9341_image_t;
+
+/**
+ * @brief  Trace renderer configuration
+ */
+typedef struct {
+	uint16_t x;								/*!< First column of the plot */
+	uint16_t width;							/*!< Columns of the plot (the whole width scrolls) */
+	uint16_t y;								/*!< First row of the plot */
+	uint16_t height;						/*!< Rows of the plot */
+	int32_t min;							/*!< Value at the bottom of the plot */
+	int32_t max;							/*!< Value at the top of the plot */
+	uint16_t decimation;					/*!< Samples per column (min and max of them are drawn) */
+	uint8_t traces;							/*!< Number of traces (up to ILI9341_TRACES_MAX) */
+	uint16_t colors[ILI9341_TRACES_MAX];	/*!< Color of each trace (RGB565) */
+	uint16_t background;					/*!< Background color (RGB565) */
+	uint16_t grid_color;					/*!< Grid color (RGB565) */
+	uint16_t grid_x;						/*!< Columns between vertical grid lines (0: none) */
+	uint16_t grid_y;						/*!< Rows between horizontal grid lines (0: none) */
+} ili9341_trace_config_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -267,6 +346,81 @@ void ILI9341DrawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, i
  */
 void ILI9341DrawPicture(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* pic);
 
+/**
+ * @brief  		Draw a compressed image on the LCD
+ * @note		Images are converted from PNG files with firmware/tools/ili9341_image.py.
+ * 				Rows are decoded straight into the DMA buffers (or the framebuffer).
+ * 				Images with palette_size 0 or above ILI9341_PALETTE_MAX, or wider than
+ * 				2046 pixels (a row per SPI transaction) are not drawn. Indexes past
+ * 				the palette are drawn with its last color, and pixels past the end of
+ * 				data with its first one.
+ * @param[in] 	x: X position of top left corner of image
+ * @param[in]  	y: Y position of top left corner of image
+ * @param[in]  	image: Compressed image
+ * @retval 		None
+ */
+void ILI9341DrawImage(uint16_t x, uint16_t y, const ili9341_image_t *image);
+
+/**
+ * @brief  		Enables a framebuffer for a stripe of rows of the LCD
+ * @note		Uses width * rows * 2 bytes of RAM (a full screen is 150 KB).
+ * 				Its content is not read from the panel: draw the whole stripe
+ * 				(e.g. with a filled rectangle) before the first flush.
+ * 				ILI9341Rotate() disables the framebuffer.
+ * @param[in]  	y0: First row of the stripe
+ * @param[in]  	rows: Number of rows of the stripe
+ * @retval 		true when success, false when there is no memory or the stripe is out of the screen
+ */
+bool ILI9341FramebufferInit(uint16_t y0, uint16_t rows);
+
+/**
+ * @brief  		Disables the framebuffer and frees its memory (pending changes are lost)
+ * @retval 		None
+ */
+void ILI9341FramebufferDeInit(void);
+
+/**
+ * @brief  		Sends the changed areas of the framebuffer to the LCD
+ * @note		Transfers are queued: this function returns before they end, and
+ * 				full width areas are read straight from the framebuffer.
+ * @retval 		Number of pixel bytes sent
+ */
+uint32_t ILI9341Flush(void);
+
+/**
+ * @brief  		Starts the trace renderer: clears the plot and enables vertical scrolling
+ * @note		Only in landscape orientations. The plot scrolls across the whole
+ * 				height of its columns: anything drawn in those columns moves with it,
+ * 				and the framebuffer must not include them. Columns outside the
+ * 				plot are not affected. ILI9341Rotate() stops the renderer.
+ * @param[in]  	config: Plot area, scale, decimation, traces and grid
+ * @retval 		true when success, false if the configuration or orientation is not valid
+ */
+bool ILI9341TraceInit(const ili9341_trace_config_t *config);
+
+/**
+ * @brief  		Adds a sample to every trace
+ * @note		Each config.decimation samples a new column is written at the
+ * 				right of the plot (a window of one column) and the plot scrolls
+ * 				one column to the left.
+ * @param[in]  	values: One value for each trace
+ * @retval 		None
+ */
+void ILI9341TraceAdd(const int32_t *values);
+
+/**
+ * @brief  		Stops the trace renderer and the vertical scrolling
+ * @retval 		None
+ */
+void ILI9341TraceStop(void);
+
+/**
+ * @brief  		Frees every rendered character of the glyph cache
+ * @note		Call it after modifying a font in RAM.
+ * @retval 		None
+ */
+void ILI9341GlyphCacheClear(void);
+
 /**
  * @brief  	De-initializes ILI9341 LCD
  * @param	None
@@ -17,6 +17,8 @@
  * |   Date	| Description                                    			|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         		|
+ * | 19/10/2026 | MPU6050_ReadRegister() in a single transaction   		|
+ * | 19/10/2026 | Shadow of the configuration registers            		|
  * 
  **/
 
@@ -422,6 +424,11 @@
  */
 void MPU6050_Address(uint8_t address);
 
+/** Read consecutive registers (single transaction with repeated start).
+ * @param reg First register
+ * @param data Buffer for the read bytes
+ * @param len Number of bytes to read
+ */
 void MPU6050_ReadRegister(uint8_t reg, uint8_t *data, uint8_t len);
 
 /** Power on and prepare for general usage.
@@ -433,6 +440,33 @@ void MPU6050_ReadRegister(uint8_t reg, uint8_t *data, uint8_t len);
  */
 void MPU6050_initialize();
 
+/** Drop the register shadow (and the writes not flushed yet).
+ * Configuration registers (offsets, sample rate, filters, interrupt, FIFO, 
+ * slaves and power settings) are kept in a shadow: reads of their fields are 
+ * served from it, and field writes only transfer the whole register. Call 
+ * this function if the device could have been reset or written elsewhere 
+ * (e.g. by the DMP or after a power cycle).
+ */
+void MPU6050_shadowInvalidate(void);
+
+/** Flush pending writes and load the shadow from the device (one burst read 
+ * for each range of configuration registers).
+ */
+void MPU6050_shadowSync(void);
+
+/** Defer configuration writes.
+ * While deferred, configuration writes are only stored in the shadow, and 
+ * are written by MPU6050_shadowFlush() in bursts of adjacent registers. 
+ * Writes that reset the device, the FIFO or the signal paths are never 
+ * deferred (pending writes are flushed before them).
+ * @param defer true to defer writes, false to flush them and write through
+ */
+void MPU6050_shadowDefer(bool defer);
+
+/** Write the deferred configuration registers.
+ */
+void MPU6050_shadowFlush(void);
+
 /** Verify the I2C connection.
  * Make sure the device is connected and responds as expected.
  * @return True if connection is valid, false otherwise
@@ -2642,11 +2676,14 @@ uint16_t MPU6050_getFIFOCount();
 uint8_t MPU6050_getFIFOByte();
 void MPU6050_setFIFOByte(uint8_t data);
 
-/** Write byte to FIFO buffer.
+/** Read bytes from FIFO buffer, in a single burst.
+ * @param data Buffer for the bytes read
+ * @param length Number of bytes (up to the FIFO size)
+ * @return Status of read operation (true = success)
  * @see getFIFOByte()
  * @see MPU6050_RA_FIFO_R_W
  */
-void MPU6050_getFIFOBytes(uint8_t *data, uint8_t length);
+bool MPU6050_getFIFOBytes(uint8_t *data, uint16_t length);
 
 // WHO_AM_I register
 /** Get Device ID.
@@ -0,0 +1,124 @@
+#ifndef MPU6050_FIFO_H
+#define MPU6050_FIFO_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup MPU6050_FIFO MPU6050 FIFO
+ ** @{ */
+
+/** \brief FIFO acquisition mode for the MPU6050.
+ *
+ * The MPU6050 samples at a fixed rate and stores each sample (accelerometer,
+ * temperature and/or gyroscope) in its 1024 bytes FIFO. Its INT pin pulses on
+ * every sample (data ready): an ISR records the time of each pulse, and wakes
+ * the reading task only when a burst of samples is waiting. Samples are then
+ * read from the FIFO in a few long transactions and delivered as structure of
+ * arrays buffers (one int16_t array per axis), each sample with the time of
+ * its data ready pulse.
+ *
+ * If the FIFO overflows (the task was late), frames are no longer aligned:
+ * the FIFO is reset, pending timestamps are dropped and the overflow is
+ * counted. Pulses without a frame (e.g. while the FIFO was being reset) are
+ * dropped, oldest first.
+ *
+ * @note At 1 kHz with accelerometer and gyroscope (12 bytes per sample) the
+ * FIFO holds 85 ms of samples: read it at least every ~50 ms.
+ *
+ * @note Only one task should call MPU6050FifoRead().
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "gpio_mcu.h"
+#include "mpu6050.h"
+/*==================[macros]=================================================*/
+#define MPU6050_FIFO_BYTES		1024		/*!< Size of the MPU6050 FIFO */
+#define MPU6050_FIFO_STAMPS		256			/*!< Data ready pulses kept (must be a power of 2) */
+#define MPU6050_FIFO_NO_TIMEOUT	0xFFFFFFFF	/*!< Wait forever on MPU6050FifoRead() */
+
+#define MPU6050_FIFO_ACCEL		(1 << 3)	/*!< Accelerometer X, Y and Z (FIFO_EN register bits) */
+#define MPU6050_FIFO_TEMP		(1 << 7)	/*!< Temperature */
+#define MPU6050_FIFO_GYRO		(7 << 4)	/*!< Gyroscope X, Y and Z */
+/*==================[typedef]================================================*/
+/**
+ * @brief FIFO mode configuration
+ */
+typedef struct {
+	uint16_t rate_hz;		/*!< Sample rate (up to 1000 Hz, 8000 Hz gyro only with MPU6050_DLPF_BW_256) */
+	uint8_t dlpf_mode;		/*!< Digital low pass filter (MPU6050_DLPF_BW_xxx) */
+	uint8_t contents;		/*!< Data stored: MPU6050_FIFO_ACCEL | MPU6050_FIFO_TEMP | MPU6050_FIFO_GYRO */
+	gpio_t int_pin;			/*!< GPIO where the INT pin is connected */
+	uint16_t burst;			/*!< Samples waiting before MPU6050FifoRead() returns */
+} mpu6050_fifo_config_t;
+
+/**
+ * @brief Sample buffers (structure of arrays)
+ *
+ * Each array must have room for size samples. Arrays of data not wanted (or
+ * not stored in the FIFO) can be NULL.
+ */
+typedef struct {
+	int16_t *ax;			/*!< Accelerometer X (raw) */
+	int16_t *ay;			/*!< Accelerometer Y (raw) */
+	int16_t *az;			/*!< Accelerometer Z (raw) */
+	int16_t *temp;			/*!< Temperature (raw) */
+	int16_t *gx;			/*!< Gyroscope X (raw) */
+	int16_t *gy;			/*!< Gyroscope Y (raw) */
+	int16_t *gz;			/*!< Gyroscope Z (raw) */
+	uint32_t *timestamp;	/*!< Time of each sample (usec, from esp_timer) */
+	uint16_t size;			/*!< Capacity of the arrays */
+} mpu6050_samples_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Configure sample rate, filter, FIFO contents and data ready interrupt,
+ * and start the acquisition.
+ *
+ * @note The MPU6050 must be initialized (MPU6050_initialize()) and the INT pin
+ * configured as input with GPIOInit().
+ *
+ * @param config FIFO mode configuration
+ * @return true
+ * @return false if the configuration is not valid
+ */
+bool MPU6050FifoStart(const mpu6050_fifo_config_t *config);
+
+/**
+ * @brief Wait for a burst of samples and read them.
+ *
+ * @param samples Buffers where samples are stored (from position 0)
+ * @param timeout_ms Maximum time to wait for the burst (MPU6050_FIFO_NO_TIMEOUT to wait forever)
+ * @return uint16_t Number of samples read (0 on timeout, after an overflow or a failed read)
+ */
+uint16_t MPU6050FifoRead(mpu6050_samples_t *samples, uint32_t timeout_ms);
+
+/**
+ * @brief Stop the acquisition (disables the FIFO and the interrupt).
+ */
+void MPU6050FifoStop(void);
+
+/**
+ * @brief Number of FIFO overflows (each one loses the samples in the FIFO)
+ *
+ * @return uint32_t
+ */
+uint32_t MPU6050FifoOverflows(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* MPU6050_FIFO_H */
+
+/*==================[end of file]============================================*/
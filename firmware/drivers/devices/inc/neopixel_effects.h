@@ -0,0 +1,137 @@
+#ifndef NEOPIXEL_EFFECTS_H
+#define NEOPIXEL_EFFECTS_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup NeoPixel_Effects NeoPixel_Effects
+ ** @{ */
+
+/** \brief Animated effects for NeoPixel stripes.
+ *
+ * Effects (rainbow, chase, fade, breathe and sparkle) are stacked in layers
+ * and rendered on fixed frame ticks: each call to NeoPixelFxRender() draws
+ * one frame and advances every layer one step. Layers are blended in place
+ * into the color array of the stripe, from layer 0 up.
+ *
+ * Only integer arithmetic is used: hues come from a 256 entries table, the
+ * hue of each led is obtained by adding a fixed step to the previous one,
+ * and the phase of each effect is a 32 bits accumulator (a full turn is 2^32).
+ *
+ * @note NeoPixelFxRender() doesn't touch the hardware, so it can be used
+ * without a stripe connected. NeoPixelFxStart() creates a task that renders
+ * and sends a frame each period. The effect math is in neopixel_fx_render.c,
+ * which has no RTOS dependencies (firmware/tools/neopixel_bench builds it on
+ * the host).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "neopixel_stripe.h"
+/*==================[macros]=================================================*/
+#define NEOPIXEL_FX_LAYERS		4		/*!< Number of effect layers */
+/*==================[typedef]================================================*/
+/**
+ * @brief Effects
+ */
+typedef enum {
+	NEOPIXEL_FX_NONE,		/*!< Layer disabled */
+	NEOPIXEL_FX_RAINBOW,	/*!< Rotating hue gradient */
+	NEOPIXEL_FX_CHASE,		/*!< Groups of leds moving along the stripe */
+	NEOPIXEL_FX_FADE,		/*!< Transition between two colors (then holds the last one) */
+	NEOPIXEL_FX_BREATHE,	/*!< Color brightness going up and down */
+	NEOPIXEL_FX_SPARKLE,	/*!< Random leds flashing */
+} neopixel_fx_type_t;
+
+/**
+ * @brief How a layer is combined with the layers below it
+ */
+typedef enum {
+	NEOPIXEL_BLEND_REPLACE,	/*!< Layer overwrites the frame */
+	NEOPIXEL_BLEND_ADD,		/*!< Colors are added (saturated at 255) */
+	NEOPIXEL_BLEND_MAX,		/*!< Highest value of each component */
+	NEOPIXEL_BLEND_ALPHA,	/*!< Mix: alpha = 255 is the layer, 0 is the frame */
+} neopixel_blend_t;
+
+/**
+ * @brief Effect configuration
+ */
+typedef struct {
+	neopixel_fx_type_t type;	/*!< Effect */
+	neopixel_blend_t blend;		/*!< Blend mode */
+	uint8_t alpha;				/*!< Opacity for NEOPIXEL_BLEND_ALPHA */
+	uint16_t period;			/*!< Frames per cycle: hue turn, chase step, fade length, breath, sparkle life */
+	neopixel_color_t color;		/*!< Chase, breathe and sparkle color, fade start color */
+	neopixel_color_t color_end;	/*!< Fade end color */
+	uint8_t sat;				/*!< Rainbow saturation */
+	uint8_t val;				/*!< Rainbow value */
+	uint8_t reps;				/*!< Rainbow repetitions along the stripe */
+	uint8_t size;				/*!< Chase: lit leds of each group */
+	uint8_t spacing;			/*!< Chase: dark leds between groups */
+	uint8_t density;			/*!< Sparkle: probability of a led to flash in each cycle (0 to 255) */
+} neopixel_fx_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Effects engine initialization.
+ *
+ * @param frame     Color array where frames are rendered (usually the one given to NeoPixelInit())
+ * @param len       Number of leds
+ */
+void NeoPixelFxInit(neopixel_color_t *frame, uint16_t len);
+
+/**
+ * @brief Set (and restart) the effect of a layer.
+ *
+ * @param layer     Layer number (0 to NEOPIXEL_FX_LAYERS - 1)
+ * @param fx        Effect configuration
+ * @return true
+ * @return false if the layer or the configuration are not valid
+ */
+bool NeoPixelFxSetLayer(uint8_t layer, const neopixel_fx_t *fx);
+
+/**
+ * @brief Disable a layer.
+ *
+ * @param layer     Layer number
+ */
+void NeoPixelFxClearLayer(uint8_t layer);
+
+/**
+ * @brief Render one frame and advance every layer one frame tick.
+ */
+void NeoPixelFxRender(void);
+
+/**
+ * @brief Start a task that renders and sends one frame each period.
+ *
+ * @param frame_period_ms   Frame period (in ms)
+ * @return true
+ * @return false if the task is already running or could not be created
+ */
+bool NeoPixelFxStart(uint16_t frame_period_ms);
+
+/**
+ * @brief Stop the effects task.
+ *
+ * @note Blocks until the task ends (up to one frame period).
+ */
+void NeoPixelFxStop(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* NEOPIXEL_EFFECTS_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,80 @@
+#ifndef NEOPIXEL_FX_RENDER_H
+#define NEOPIXEL_FX_RENDER_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Devices Drivers devices
+ ** @{ */
+/** \addtogroup NeoPixel_Effects NeoPixel_Effects
+ ** @{ */
+
+/** \brief Frame rendering of the NeoPixel effects (no RTOS, no hardware).
+ *
+ * Layer state and effect math behind neopixel_effects. These functions
+ * don't lock: the firmware must use the NeoPixelFx* functions of
+ * neopixel_effects.h, which call them with the layers mutex taken. They are
+ * exported for host builds (benchmarks, tests) of the effects.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "neopixel_effects.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Set the frame and build the hue table. Disables every layer.
+ *
+ * @param frame     Color array where frames are rendered
+ * @param len       Number of leds
+ */
+void NeoPixelFxRenderInit(neopixel_color_t *frame, uint16_t len);
+
+/**
+ * @brief Set (and restart) the effect of a layer, without locking.
+ *
+ * @param layer     Layer number (0 to NEOPIXEL_FX_LAYERS - 1)
+ * @param fx        Effect configuration
+ * @return true
+ * @return false if the layer or the configuration are not valid
+ */
+bool NeoPixelFxRenderSetLayer(uint8_t layer, const neopixel_fx_t *fx);
+
+/**
+ * @brief Disable a layer, without locking.
+ *
+ * @param layer     Layer number
+ */
+void NeoPixelFxRenderClearLayer(uint8_t layer);
+
+/**
+ * @brief Render one frame and advance every layer one frame tick, without locking.
+ */
+void NeoPixelFxRenderFrame(void);
+
+/**
+ * @brief Frame given to NeoPixelFxRenderInit().
+ *
+ * @return neopixel_color_t* Color array, NULL before initialization
+ */
+neopixel_color_t *NeoPixelFxRenderGetFrame(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* NEOPIXEL_FX_RENDER_H */
+
+/*==================[end of file]============================================*/
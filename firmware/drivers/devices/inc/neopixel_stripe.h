@@ -13,6 +13,14 @@
  * (with no limits in the qty of leds in the array).
  * 
  * @note ESP-EDU have one individual NeoPixel connected to GPIO_8, that can be used with this driver.
+ *
+ * @note Frames are sent in background by the RMT peripheral: functions that
+ * update the stripe return as soon as the new frame is queued.
+ *
+ * @note Colors are kept already encoded (brightness and gamma applied, wire
+ * order), only the leds up to the last changed one are sent. With a refresh
+ * period set (NeoPixelSetRefreshPeriod()) changes are gathered by a task that
+ * sends at most one frame per period.
  * 
  * @author Albano Peñalva
  *
@@ -21,17 +29,21 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Non-blocking frames (RMT) and frame done callback						|
+ * | 19/10/2026 | Encoded frame buffer, dirty tracking and rate-limited refresh			|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include "sdkconfig.h"
 #include "esp_err.h"
 #include "gpio_mcu.h"
 /*==================[macros]=================================================*/
 #define BUILT_IN_RGB_LED_PIN          GPIO_8        /*> ESP32-C6-DevKitC-1 NeoPixel it's connected at GPIO_8 */
 #define BUILT_IN_RGB_LED_LENGTH       1             /*> ESP32-C6-DevKitC-1 NeoPixel has one pixel */
+#define NEOPIXEL_NO_TIMEOUT           0xFFFFFFFF    /*> Wait without timeout */
 
 #define NEOPIXEL_COLOR_WHITE          0x00FFFFFF  /*> Color white */
 #define NEOPIXEL_COLOR_RED            0x00FF0000  /*> Color red */
@@ -106,10 +118,42 @@ void NeoPixelSetPixel(uint16_t pixel, neopixel_color_t color);
 /**
  * @brief Set all NeoPixels in the array with the color stored in an array.
  * 
+ * @note The frame is queued and sent in background, color_array can be
+ * modified as soon as the function returns.
  * @param color_array Array of 24 bits color
  */
 void NeoPixelSetArray(neopixel_color_t *color_array);
 
+/**
+ * @brief Set a function to be called each time a frame was sent to the stripe.
+ * 
+ * @note The function is called from interrupt context.
+ * @param ptr_done_func Pointer to function (void func(void *args)), NULL to disable
+ * @param args          Pointer to arguments of the function
+ */
+void NeoPixelSetDoneCallback(void *ptr_done_func, void *args);
+
+/**
+ * @brief Wait until the stripe shows the last color set.
+ * 
+ * @param timeout_ms    Maximum time to wait (in ms), or NEOPIXEL_NO_TIMEOUT
+ * @return true
+ * @return false on timeout
+ */
+bool NeoPixelWaitDone(uint32_t timeout_ms);
+
+/**
+ * @brief Set the minimum time between frames.
+ * 
+ * @note With a period > 0 a refresh task sends the changes, so many updates
+ * made within one period (e.g. several NeoPixelSetPixel()) cost one frame.
+ * With period 0 (default) every change is sent immediately.
+ * @param period_ms Minimum time between frames (in ms)
+ * @return true
+ * @return false if the refresh task could not be created
+ */
+bool NeoPixelSetRefreshPeriod(uint16_t period_ms);
+
 /**
  * @brief Shift the all NeoPixel colors in the array 1 position (up or down)
  * 
@@ -12,6 +12,11 @@
  * @note ESP-EDU have 2 switches connected to GPIO_4 and GPIO_15. 
  * The latter is also routed to J2 connector.
  *
+ * @note The event service (SwitchEvents* functions) samples every key from a
+ * single periodic esp_timer callback (task context), debounces them with an
+ * integrator and reports press, release, long-press and repeat events through
+ * a queue. Extra keys (e.g. a keypad) can be added without extra timers.
+ *
  * @author Albano Peñalva
  *
  * @section changelog
@@ -19,19 +24,53 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Event service with debouncing, long-press and repeat					|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdbool.h>
 #include <stdint.h>
+#include "gpio_mcu.h"
 /*==================[macros]=================================================*/
+#define SWITCH_EVENTS_MAX_KEYS		16			/*!< Maximum number of keys handled by the event service */
+#define SWITCH_EVENTS_QUEUE_SIZE	16			/*!< Number of events stored in the queue */
+#define SWITCH_EVENTS_NO_TIMEOUT	0xFFFFFFFF	/*!< Wait forever on SwitchEventsGet() */
 
 /*==================[typedef]================================================*/
 typedef enum switches {
     SWITCH_1 = (1 << 0),  /**< Routed to GPIO_4 */
     SWITCH_2 = (1 << 1),  /**< Routed to GPIO_15 */
 } switch_t;
+
+/**
+ * @brief Events reported by the switch event service
+ */
+typedef enum {
+    SWITCH_EV_PRESS = 0,    /**< Key pressed (debounced) */
+    SWITCH_EV_RELEASE,      /**< Key released (debounced) */
+    SWITCH_EV_LONG_PRESS,   /**< Key held for long_press_ms */
+    SWITCH_EV_REPEAT,       /**< Key still held, emitted every repeat_ms */
+} switch_event_type_t;
+
+/**
+ * @brief Switch event
+ */
+typedef struct {
+    uint8_t key;                /**< Key id (SWITCH_1, SWITCH_2 or the id given in SwitchEventsAddKey()) */
+    switch_event_type_t type;   /**< Event type */
+    uint32_t timestamp;         /**< Time of the event (in ms) */
+} switch_event_t;
+
+/**
+ * @brief Switch event service configuration
+ */
+typedef struct {
+    uint16_t sample_period_ms;  /**< Sampling period of all keys (in ms) */
+    uint16_t debounce_ms;       /**< Time a key must be stable to change its state (in ms) */
+    uint16_t long_press_ms;     /**< Hold time to emit SWITCH_EV_LONG_PRESS (0: disabled) */
+    uint16_t repeat_ms;         /**< Period of SWITCH_EV_REPEAT while held after a long-press (0: disabled) */
+} switch_events_config_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -58,6 +97,38 @@ int8_t SwitchesRead(void);
  */
 void SwitchActivInt(switch_t tec, void *ptrIntFunc, void *args);
 
+/**
+ * @brief Starts the switch event service on SWITCH_1 and SWITCH_2.
+ * 
+ * @note Do not combine with SwitchActivInt() on the same switch.
+ * 
+ * @param config Pointer to service configuration
+ * @return int8_t false if the service could not be started
+ */
+int8_t SwitchEventsInit(switch_events_config_t *config);
+
+/**
+ * @brief Adds an extra key (active low, with pull-up) to the event service.
+ * 
+ * @note The key also gets a GPIO glitch filter (GPIOInputFilter()) while
+ * there are free ones (8 in total, shared with the rest of the program).
+ * 
+ * @param pin GPIO number where the key is connected
+ * @param key Key id reported in the events (must not be SWITCH_1 or SWITCH_2)
+ * @return int8_t false if there is no room for more keys
+ */
+int8_t SwitchEventsAddKey(gpio_t pin, uint8_t key);
+
+/**
+ * @brief Gets the next event from the queue.
+ * 
+ * @param event Pointer to variable where the event will be stored
+ * @param timeout_ms Maximum time to wait (0: don't wait, SWITCH_EVENTS_NO_TIMEOUT: wait forever)
+ * @return true An event was read
+ * @return false No event before timeout
+ */
+bool SwitchEventsGet(switch_event_t *event, uint32_t timeout_ms);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -9,6 +9,12 @@
  ** @{ */
 
 /** \brief Driver for handling WS2812B RGB leds.
+ *
+ * Bits are generated by the RMT peripheral: a frame (G, R, B bytes of each
+ * led) is queued and encoded in background (refilling the RMT memory from
+ * its interrupt, or by DMA on targets that support it), followed by the
+ * reset (ret) code. The CPU is free while the frame is being sent and the
+ * timing is not affected by other interrupts.
  *
  * @note For handling NeoPixels arrays use "neopixel_stripe.h".
  * 
@@ -19,15 +25,19 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | RMT output with non-blocking frames and completion callback			|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 #include "sdkconfig.h"
 #include "esp_err.h"
 #include "gpio_mcu.h"
 /*==================[macros]=================================================*/
+#define WS2812B_QUEUE_DEPTH		2			/*!< Frames that can be queued (including the one being sent) */
+#define WS2812B_NO_TIMEOUT		0xFFFFFFFF	/*!< Wait without timeout */
 
 /*==================[typedef]================================================*/
 /**
@@ -53,6 +63,7 @@ void ws2812bInit(gpio_t pin);
 /**
  * @brief Send color information to NeoPixel.
  * 
+ * @note Colors are accumulated and sent as one frame by ws2812bSendRet().
  * @param data NeoPixel color
  */
 void ws2812bSend(rgb_led_t led_color);
@@ -60,9 +71,50 @@ void ws2812bSend(rgb_led_t led_color);
 /**
  * @brief Send a ret command to NeoPixel.
  * 
+ * @note Sends the colors accumulated by ws2812bSend() and waits until every
+ * queued frame is out.
  */
 void ws2812bSendRet(void);
 
+/**
+ * @brief Queue a frame and return without waiting it to be sent.
+ * 
+ * @note Blocks only if WS2812B_QUEUE_DEPTH frames are already queued.
+ * The buffer must not be modified until the frame is sent (see
+ * ws2812bSetDoneCallback() and ws2812bWaitDone()).
+ * @param data  Bytes in wire order (green, red, blue of each led), gamma already applied
+ * @param len   Number of leds in the frame
+ * @return true
+ * @return false if the frame could not be queued
+ */
+bool ws2812bSendFrame(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Set a function to be called each time a frame was completely sent.
+ * 
+ * @note The function is called from interrupt context.
+ * @param ptr_done_func Pointer to function (void func(void *args)), NULL to disable
+ * @param args          Pointer to arguments of the function
+ */
+void ws2812bSetDoneCallback(void *ptr_done_func, void *args);
+
+/**
+ * @brief Wait until every queued frame was sent.
+ * 
+ * @param timeout_ms    Maximum time to wait (in ms), or WS2812B_NO_TIMEOUT
+ * @return true
+ * @return false on timeout
+ */
+bool ws2812bWaitDone(uint32_t timeout_ms);
+
+/**
+ * @brief Gamma correction applied to each color component.
+ * 
+ * @param component Color component (0 to 255)
+ * @return uint8_t  Gamma corrected component
+ */
+uint8_t ws2812bGammaCorrection(uint8_t component);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -12,6 +12,10 @@
 /*==================[inclusions]=============================================*/
 #include "hc_sr04.h"
 #include "delay_mcu.h"
+#include "driver/mcpwm_cap.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 /*==================[macros and definitions]=================================*/
 #define MAX_US		17700	/* maximun distance time in us (300cm or 118inch) */
 #define MAX_CM		300		/* maximun distance time in cm */
@@ -19,15 +23,124 @@
 #define US2CM		59		/* scale factor to conver pulse width to cm */
 #define US2INCH		150		/* scale factor to conver pulse width to inch */
 #define WAIT_MAX	5900	/* maximun time to wait for echo signal */
+#define ECHO_TIMEOUT_US	(WAIT_MAX + MAX_US + 1000)	/* maximun time from trigger to echo end */
+#define TRIGGER_US	10		/* trigger pulse width */
+#define NS_PER_SEC	1000000000ULL
 /*==================[internal data declaration]==============================*/
 static gpio_t echo_st, trigger_st; /**<  Stores the pin inicilization*/
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
+static mcpwm_cap_timer_handle_t cap_timer = NULL;		/*!< MCPWM capture timer */
+static mcpwm_cap_channel_handle_t cap_channel = NULL;	/*!< MCPWM capture channel on echo pin */
+static uint32_t cap_resolution_hz;						/*!< Capture timer resolution */
+static bool cap_enabled = false;						/*!< Capture channel and timer enabled and started */
+static esp_timer_handle_t timeout_timer = NULL;			/*!< Echo timeout */
+static QueueHandle_t measure_queue = NULL;				/*!< Last measurement */
+static portMUX_TYPE measure_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool measuring = false;					/*!< A measurement is in progress */
+static volatile bool echo_started = false;				/*!< Rising edge of the echo captured */
+static uint32_t echo_rise;								/*!< Capture value at echo rising edge */
+static uint32_t trigger_time;							/*!< Time of the trigger (in usec) */
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Capture ISR: timestamps both echo edges in hardware and posts the
+ * result at the falling edge.
+ */
+static bool IRAM_ATTR HcSr04EchoIsr(mcpwm_cap_channel_handle_t channel, const mcpwm_capture_event_data_t *edata, void *user_data){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	hc_sr04_measure_t measure;
+
+	portENTER_CRITICAL_ISR(&measure_lock);
+	if(!measuring){
+		portEXIT_CRITICAL_ISR(&measure_lock);
+		return false;
+	}
+	if(edata->cap_edge == MCPWM_CAP_EDGE_POS){
+		echo_rise = edata->cap_value;
+		echo_started = true;
+		portEXIT_CRITICAL_ISR(&measure_lock);
+		return false;
+	}
+	if(!echo_started){
+		portEXIT_CRITICAL_ISR(&measure_lock);
+		return false;
+	}
+	measuring = false;
+	portEXIT_CRITICAL_ISR(&measure_lock);
+
+	measure.echo_ns = (uint32_t)(((uint64_t)(edata->cap_value - echo_rise) * NS_PER_SEC) / cap_resolution_hz);
+	measure.timestamp = trigger_time;
+	if(measure.echo_ns > (MAX_US * 1000UL)){
+		measure.status = HC_SR04_OUT_OF_RANGE;
+		measure.distance_mm = MAX_CM * 10;
+	} else{
+		measure.status = HC_SR04_OK;
+		measure.distance_mm = measure.echo_ns / (US2CM * 100);
+	}
+	xQueueOverwriteFromISR(measure_queue, &measure, &xHigherPriorityTaskWoken);
+	return (xHigherPriorityTaskWoken == pdTRUE);
+}
+
+/**
+ * @brief Echo timeout (esp_timer task): reports the measurement if the echo never ended.
+ */
+static void HcSr04Timeout(void *param){
+	hc_sr04_measure_t measure = {
+		.echo_ns = 0,
+		.distance_mm = 0,
+	};
+
+	portENTER_CRITICAL(&measure_lock);
+	if(!measuring){
+		portEXIT_CRITICAL(&measure_lock);
+		return;
+	}
+	measuring = false;
+	measure.status = echo_started ? HC_SR04_OUT_OF_RANGE : HC_SR04_TIMEOUT;
+	portEXIT_CRITICAL(&measure_lock);
+
+	if(measure.status == HC_SR04_OUT_OF_RANGE){
+		measure.echo_ns = MAX_US * 1000UL;
+		measure.distance_mm = MAX_CM * 10;
+	}
+	measure.timestamp = trigger_time;
+	xQueueOverwrite(measure_queue, &measure);
+}
+
+/**
+ * @brief Free everything HcSr04AsyncInit() allocates (also after a partial initialization)
+ */
+static void HcSr04AsyncFree(void){
+	if(cap_enabled){
+		mcpwm_capture_timer_stop(cap_timer);
+		mcpwm_capture_timer_disable(cap_timer);
+		mcpwm_capture_channel_disable(cap_channel);
+		cap_enabled = false;
+	}
+	/* Channels must be deleted before their timer */
+	if(cap_channel != NULL){
+		mcpwm_del_capture_channel(cap_channel);
+		cap_channel = NULL;
+	}
+	if(cap_timer != NULL){
+		mcpwm_del_capture_timer(cap_timer);
+		cap_timer = NULL;
+	}
+	if(timeout_timer != NULL){
+		esp_timer_stop(timeout_timer);
+		esp_timer_delete(timeout_timer);
+		timeout_timer = NULL;
+	}
+	if(measure_queue != NULL){
+		vQueueDelete(measure_queue);
+		measure_queue = NULL;
+	}
+	measuring = false;
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -86,7 +199,99 @@ uint16_t HcSr04ReadDistanceInInches(void){
 	return (distance/US2INCH);
 }
 
+bool HcSr04AsyncInit(gpio_t echo, gpio_t trigger){
+	echo_st = echo;
+	trigger_st = trigger;
+	GPIOInit(trigger, GPIO_OUTPUT);
+
+	/* Initializing again: free the previous resources first */
+	HcSr04AsyncFree();
+	measure_queue = xQueueCreate(1, sizeof(hc_sr04_measure_t));
+	if(measure_queue == NULL){
+		return false;
+	}
+	const esp_timer_create_args_t timeout_args = {
+		.callback = HcSr04Timeout,
+		.arg = NULL,
+		.dispatch_method = ESP_TIMER_TASK,
+		.name = "hc_sr04",
+	};
+	if(esp_timer_create(&timeout_args, &timeout_timer) != ESP_OK){
+		timeout_timer = NULL;
+		HcSr04AsyncFree();
+		return false;
+	}
+
+	mcpwm_capture_timer_config_t cap_timer_config = {
+		.group_id = 0,
+		.clk_src = MCPWM_CAPTURE_CLK_SRC_DEFAULT,
+	};
+	if(mcpwm_new_capture_timer(&cap_timer_config, &cap_timer) != ESP_OK){
+		cap_timer = NULL;
+		HcSr04AsyncFree();
+		return false;
+	}
+	mcpwm_capture_channel_config_t cap_channel_config = {
+		.gpio_num = echo,
+		.prescale = 1,
+		.flags.pos_edge = true,
+		.flags.neg_edge = true,
+		.flags.pull_up = true,
+	};
+	if(mcpwm_new_capture_channel(cap_timer, &cap_channel_config, &cap_channel) != ESP_OK){
+		cap_channel = NULL;
+		HcSr04AsyncFree();
+		return false;
+	}
+	mcpwm_capture_event_callbacks_t cap_callbacks = {
+		.on_cap = HcSr04EchoIsr,
+	};
+	mcpwm_capture_channel_register_event_callbacks(cap_channel, &cap_callbacks, NULL);
+	mcpwm_capture_channel_enable(cap_channel);
+	mcpwm_capture_timer_get_resolution(cap_timer, &cap_resolution_hz);
+	mcpwm_capture_timer_enable(cap_timer);
+	mcpwm_capture_timer_start(cap_timer);
+	cap_enabled = true;
+	return true;
+}
+
+bool HcSr04Trigger(void){
+	if(measure_queue == NULL){
+		return false;
+	}
+	portENTER_CRITICAL(&measure_lock);
+	if(measuring){
+		portEXIT_CRITICAL(&measure_lock);
+		return false;
+	}
+	measuring = true;
+	echo_started = false;
+	portEXIT_CRITICAL(&measure_lock);
+
+	xQueueReset(measure_queue);
+	trigger_time = (uint32_t)esp_timer_get_time();
+	/* A previous timeout could still be armed if the echo ended before it */
+	esp_timer_stop(timeout_timer);
+	esp_timer_start_once(timeout_timer, ECHO_TIMEOUT_US);
+	GPIOOn(trigger_st);
+	DelayUs(TRIGGER_US);
+	GPIOOff(trigger_st);
+	return true;
+}
+
+bool HcSr04GetMeasure(hc_sr04_measure_t *measure, uint32_t timeout_ms){
+	TickType_t ticks = portMAX_DELAY;
+	if(measure_queue == NULL){
+		return false;
+	}
+	if(timeout_ms != HC_SR04_NO_TIMEOUT){
+		ticks = pdMS_TO_TICKS(timeout_ms);
+	}
+	return (xQueueReceive(measure_queue, measure, ticks) == pdTRUE);
+}
+
 bool HcSr04Deinit(void){
+	HcSr04AsyncFree();
 	GPIODeinit();
 	return true;
 }
@@ -0,0 +1,290 @@
+/**
+ * @file hc_sr04_array.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "hc_sr04_array.h"
+#include "gpio_capture_mcu.h"
+#include "delay_mcu.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define MAX_US			17700	/* maximun distance time in us (300cm or 118inch) */
+#define MAX_CM			300		/* maximun distance time in cm */
+#define US2CM			59		/* scale factor to conver pulse width to cm */
+#define WAIT_MAX		5900	/* maximun time to wait for echo signal */
+#define ECHO_TIMEOUT_US	(WAIT_MAX + MAX_US + 1000)	/* maximun time from trigger to echo end */
+#define TRIGGER_US		10		/* trigger pulse width */
+#define EVENTS_BATCH	(2 * HC_SR04_ARRAY_MAX)		/* edges read at once from the capture queue */
+#define US_PER_SEC		1000000ULL
+/*==================[internal data declaration]==============================*/
+/**
+ * @brief State of each sensor
+ */
+typedef struct {
+	hc_sr04_sensor_t cfg;						/*!< Sensor pins and group */
+	uint32_t rise;								/*!< Timestamp of the echo rising edge */
+	bool started;								/*!< Echo rising edge received */
+	bool done;									/*!< Measurement of the current slot finished */
+	hc_sr04_measure_t last;						/*!< Last filtered measurement */
+	bool valid;									/*!< last holds a measurement */
+	uint16_t window[HC_SR04_ARRAY_MEDIAN_MAX];	/*!< Median filter window (in mm) */
+	uint8_t window_count;						/*!< Valid samples in window */
+	uint8_t window_pos;							/*!< Next position to write in window */
+	uint8_t misses;								/*!< Consecutive timeouts */
+} sensor_state_t;
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static sensor_state_t sensors[HC_SR04_ARRAY_MAX];	/*!< Sensors of the array */
+static uint8_t sensors_qty = 0;						/*!< Number of sensors */
+static uint8_t groups_qty = 0;						/*!< Number of firing groups */
+static uint16_t guard_us;							/*!< Silence time between groups */
+static uint8_t median_size;							/*!< Median filter window */
+static TaskHandle_t scheduler_task = NULL;			/*!< Scheduler task */
+static volatile bool running = false;				/*!< Scheduler enabled */
+static uint32_t measure_count;						/*!< Measurements since start */
+static int64_t start_time;							/*!< Time of HcSr04ArrayStart() */
+static portMUX_TYPE results_lock = portMUX_INITIALIZER_UNLOCKED;
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Median of the filter window (insertion sort, window is at most 7 samples)
+ */
+static uint16_t HcSr04ArrayMedian(sensor_state_t *s){
+	uint16_t sorted[HC_SR04_ARRAY_MEDIAN_MAX];
+	uint8_t n = s->window_count;
+	for(uint8_t i = 0; i < n; i++){
+		uint16_t v = s->window[i];
+		int8_t j = i - 1;
+		while((j >= 0) && (sorted[j] > v)){
+			sorted[j + 1] = sorted[j];
+			j--;
+		}
+		sorted[j + 1] = v;
+	}
+	return sorted[n / 2];
+}
+
+/**
+ * @brief Filters and stores the result of a slot
+ */
+static void HcSr04ArrayStore(sensor_state_t *s, hc_sr04_measure_t *m){
+	if(median_size > 1){
+		if(m->status == HC_SR04_TIMEOUT){
+			/* Timeouts are treated as outliers until they fill the window */
+			if(s->misses < UINT8_MAX){
+				s->misses++;
+			}
+			if(s->misses < median_size){
+				return;
+			}
+			s->window_count = 0;
+		} else{
+			s->misses = 0;
+			s->window[s->window_pos] = m->distance_mm;
+			s->window_pos = (s->window_pos + 1) % median_size;
+			if(s->window_count < median_size){
+				s->window_count++;
+			}
+			m->distance_mm = HcSr04ArrayMedian(s);
+		}
+	}
+	portENTER_CRITICAL(&results_lock);
+	s->last = *m;
+	s->valid = true;
+	measure_count++;
+	portEXIT_CRITICAL(&results_lock);
+}
+
+/**
+ * @brief Converts an echo width into a measurement
+ */
+static void HcSr04ArrayFinish(sensor_state_t *s, uint32_t width_us, uint32_t trigger_time){
+	hc_sr04_measure_t m = {
+		.timestamp = trigger_time,
+	};
+	if(!s->started){
+		m.status = HC_SR04_TIMEOUT;
+		m.echo_ns = 0;
+		m.distance_mm = 0;
+	} else if(width_us > MAX_US){
+		m.status = HC_SR04_OUT_OF_RANGE;
+		m.echo_ns = MAX_US * 1000UL;
+		m.distance_mm = MAX_CM * 10;
+	} else{
+		m.status = HC_SR04_OK;
+		m.echo_ns = width_us * 1000UL;
+		m.distance_mm = (width_us * 10) / US2CM;
+	}
+	s->done = true;
+	HcSr04ArrayStore(s, &m);
+}
+
+/**
+ * @brief Fires one group and collects its echoes
+ *
+ * @return false if the group has no sensors
+ */
+static bool HcSr04ArrayFireGroup(uint8_t group){
+	gpio_capture_event_t events[EVENTS_BATCH];
+	uint8_t pending = 0;
+	uint32_t echo_mask = 0;
+	uint32_t trigger_time;
+	int64_t elapsed;
+
+	for(uint8_t i = 0; i < sensors_qty; i++){
+		if(sensors[i].cfg.group == group){
+			echo_mask |= (1UL << sensors[i].cfg.echo);
+		}
+	}
+	if(echo_mask == 0){
+		return false;
+	}
+	/* Discard edges of this group left from a previous slot (late echoes), 
+	 * edges of other pins stay in the capture queue */
+	GPIOCaptureDiscard(echo_mask);
+
+	for(uint8_t i = 0; i < sensors_qty; i++){
+		sensor_state_t *s = &sensors[i];
+		if(s->cfg.group == group){
+			s->started = false;
+			s->done = false;
+			pending++;
+			GPIOOn(s->cfg.trigger);
+		}
+	}
+	trigger_time = (uint32_t)esp_timer_get_time();
+	DelayUs(TRIGGER_US);
+	for(uint8_t i = 0; i < sensors_qty; i++){
+		if(sensors[i].cfg.group == group){
+			GPIOOff(sensors[i].cfg.trigger);
+		}
+	}
+
+	elapsed = 0;
+	while((pending > 0) && (elapsed < ECHO_TIMEOUT_US)){
+		/* Wakes up when every pending echo could be complete (2 edges each) */
+		uint32_t remaining_ms = (ECHO_TIMEOUT_US - elapsed) / 1000 + portTICK_PERIOD_MS;
+		GPIOCaptureWait(2 * pending, remaining_ms);
+		uint16_t n = GPIOCaptureRead(events, EVENTS_BATCH);
+		for(uint16_t e = 0; e < n; e++){
+			for(uint8_t i = 0; i < sensors_qty; i++){
+				sensor_state_t *s = &sensors[i];
+				if((s->cfg.echo != events[e].pin) || (s->cfg.group != group) || s->done){
+					continue;
+				}
+				if(events[e].rising){
+					s->rise = events[e].timestamp;
+					s->started = true;
+				} else if(s->started){
+					HcSr04ArrayFinish(s, events[e].timestamp - s->rise, trigger_time);
+					pending--;
+				}
+			}
+		}
+		elapsed = esp_timer_get_time() - trigger_time;
+	}
+	for(uint8_t i = 0; i < sensors_qty; i++){
+		sensor_state_t *s = &sensors[i];
+		if((s->cfg.group == group) && !s->done){
+			HcSr04ArrayFinish(s, MAX_US + 1, trigger_time);
+		}
+	}
+	return true;
+}
+
+static void HcSr04ArrayScheduler(void *param){
+	while(running){
+		for(uint8_t g = 0; (g < groups_qty) && running; g++){
+			if(HcSr04ArrayFireGroup(g) && (guard_us > 0)){
+				DelayUs(guard_us);
+			}
+		}
+	}
+	scheduler_task = NULL;
+	vTaskDelete(NULL);
+}
+/*==================[external functions definition]==========================*/
+bool HcSr04ArrayInit(hc_sr04_array_config_t *config){
+	if((config->sensors_qty == 0) || (config->sensors_qty > HC_SR04_ARRAY_MAX) ||
+		(config->median_size > HC_SR04_ARRAY_MEDIAN_MAX) || running){
+		return false;
+	}
+	sensors_qty = config->sensors_qty;
+	guard_us = config->guard_us;
+	median_size = (config->median_size > 1) ? (config->median_size | 1) : 1;
+	if(median_size > HC_SR04_ARRAY_MEDIAN_MAX){
+		median_size = HC_SR04_ARRAY_MEDIAN_MAX;
+	}
+	groups_qty = 0;
+	for(uint8_t i = 0; i < sensors_qty; i++){
+		sensors[i] = (sensor_state_t){
+			.cfg = config->sensors[i],
+		};
+		if(config->sensors[i].group >= groups_qty){
+			groups_qty = config->sensors[i].group + 1;
+		}
+		GPIOInit(config->sensors[i].trigger, GPIO_OUTPUT);
+		GPIOInit(config->sensors[i].echo, GPIO_INPUT);
+		GPIOCaptureActiv(config->sensors[i].echo, GPIO_CAPTURE_BOTH);
+	}
+	return true;
+}
+
+bool HcSr04ArrayStart(void){
+	if(running || (scheduler_task != NULL) || (sensors_qty == 0)){
+		return false;
+	}
+	measure_count = 0;
+	start_time = esp_timer_get_time();
+	running = true;
+	if(xTaskCreate(&HcSr04ArrayScheduler, "hc_sr04_array", 2048, NULL, 5, &scheduler_task) != pdPASS){
+		scheduler_task = NULL;
+		running = false;
+		return false;
+	}
+	return true;
+}
+
+void HcSr04ArrayStop(void){
+	running = false;
+	if(xTaskGetCurrentTaskHandle() == scheduler_task){
+		return;
+	}
+	/* The task ends after the group being fired */
+	while(scheduler_task != NULL){
+		vTaskDelay(pdMS_TO_TICKS(10));
+	}
+}
+
+bool HcSr04ArrayRead(uint8_t sensor, hc_sr04_measure_t *measure){
+	bool valid;
+	if(sensor >= sensors_qty){
+		return false;
+	}
+	portENTER_CRITICAL(&results_lock);
+	valid = sensors[sensor].valid;
+	*measure = sensors[sensor].last;
+	portEXIT_CRITICAL(&results_lock);
+	return valid;
+}
+
+uint32_t HcSr04ArrayRate(void){
+	int64_t elapsed = esp_timer_get_time() - start_time;
+	if(elapsed <= 0){
+		return 0;
+	}
+	return (uint32_t)(((uint64_t)measure_count * US_PER_SEC) / (uint64_t)elapsed);
+}
+
+/*==================[end of file]============================================*/
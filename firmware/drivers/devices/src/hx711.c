@@ -12,8 +12,18 @@
 #include "hx711.h"
 
 #include <delay_mcu.h>
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
 
 /*==================[macros and definitions]=================================*/
+#define HX711_DATA_BITS		24		/*!< Bits of a conversion */
+#define HX711_SIGN_BIT		0x800000
+#define HX711_TASK_STACK	2048
+#define HX711_TASK_PRIORITY	10		/*!< High, the task only runs for ~60 usec per conversion */
 
 /*==================[internal data declaration]==============================*/
 uint8_t GAIN;		             /*!<  Amplification factor */
@@ -24,6 +34,15 @@ float SCALE;	                 /*!<  Used to return weight in grams, kg, ounces,
 gpio_t internal_pd_sck;
 gpio_t internal_dout;
 
+static TaskHandle_t reader_task = NULL;			/*!<  Asynchronous reader task */
+static QueueHandle_t sample_queue = NULL;		/*!<  Samples buffer */
+static volatile uint32_t ready_time;			/*!<  Time of the last data ready edge */
+static portMUX_TYPE clock_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile int32_t tare_offset = 0;		/*!<  Offset of the asynchronous samples */
+static volatile uint8_t tare_times = 0;			/*!<  Samples of the tare in progress */
+static int64_t tare_sum;
+static uint8_t tare_count;
+
 /*==================[internal functions declaration]=========================*/
 
 uint8_t shiftIn(void)
@@ -39,6 +58,96 @@ uint8_t shiftIn(void)
     return value;
 }
 
+/**
+ * @brief Data ready (DOUT falling edge) interruption: only wakes the reader task
+ */
+static void IRAM_ATTR HX711_dataReadyIsr(void *args)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	ready_time = (uint32_t)esp_timer_get_time();
+	vTaskNotifyGiveFromISR(reader_task, &xHigherPriorityTaskWoken);
+	if (xHigherPriorityTaskWoken == pdTRUE)
+	{
+		portYIELD_FROM_ISR();
+	}
+}
+
+/**
+ * @brief Clocks out one conversion. PD_SCK high must not last more than 60 usec
+ * (the chip would power down), so the whole frame is clocked with interrupts
+ * disabled (~25 pulses of 2 usec).
+ */
+static int32_t HX711_clockOut(void)
+{
+	uint32_t count = 0;
+
+	portENTER_CRITICAL(&clock_lock);
+	for (uint8_t i = 0; i < HX711_DATA_BITS; i++)
+	{
+		GPIOOn(internal_pd_sck);
+		esp_rom_delay_us(1);
+		count = count << 1;
+		GPIOOff(internal_pd_sck);
+		esp_rom_delay_us(1);
+		if (GPIORead(internal_dout))
+			count++;
+	}
+	/* Extra pulses select channel and gain for the next conversion */
+	for (uint8_t i = 0; i < GAIN; i++)
+	{
+		GPIOOn(internal_pd_sck);
+		esp_rom_delay_us(1);
+		GPIOOff(internal_pd_sck);
+		esp_rom_delay_us(1);
+	}
+	portEXIT_CRITICAL(&clock_lock);
+
+	/* Sign extension of the 24 bits two's complement result */
+	if (count & HX711_SIGN_BIT)
+		count |= 0xFF000000;
+	return (int32_t)count;
+}
+
+static void HX711_readerTask(void *param)
+{
+	hx711_sample_t sample, discarded;
+
+	while (true)
+	{
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		/* The edge could be a glitch or left from the previous frame */
+		if (!HX711_isReady())
+			continue;
+
+		gpio_intr_disable(internal_dout);
+		sample.timestamp = ready_time;
+		sample.raw = HX711_clockOut();
+		/* Discard the edges generated by DOUT while clocking */
+		ulTaskNotifyTake(pdTRUE, 0);
+		gpio_intr_enable(internal_dout);
+
+		if (tare_times > 0)
+		{
+			tare_sum += sample.raw;
+			if (++tare_count >= tare_times)
+			{
+				tare_offset = (int32_t)(tare_sum / tare_count);
+				tare_times = 0;
+			}
+		}
+		sample.value = sample.raw - tare_offset;
+		if (xQueueSend(sample_queue, &sample, 0) != pdTRUE)
+		{
+			/* Buffer full: drop the oldest sample */
+			xQueueReceive(sample_queue, &discarded, 0);
+			xQueueSend(sample_queue, &sample, 0);
+		}
+		/* DOUT could already be low if a conversion finished while clocking */
+		if (HX711_isReady())
+			xTaskNotifyGive(reader_task);
+	}
+}
+
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
@@ -86,10 +195,6 @@ uint32_t HX711_read(void)
     unsigned long count;
     unsigned char i;
 
-    GPIOOn(internal_dout);//DOUT_SET_HIGH;
-
-    DelayUs(1);
-
     GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
     DelayUs(1);
 
@@ -173,4 +278,74 @@ void HX711_powerUp(void)
 	GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
 }
 
+bool HX711_AsyncInit(uint8_t gain, gpio_t pd_sck, gpio_t dout)
+{
+	internal_pd_sck = pd_sck;
+	internal_dout = dout;
+	GPIOInit(pd_sck, GPIO_OUTPUT);
+	GPIOInit(dout, GPIO_INPUT);
+	GPIOOff(internal_pd_sck);
+
+	switch (gain)
+	{
+		case 128:		// channel A, gain factor 128
+			GAIN = 1;
+			break;
+		case 64:		// channel A, gain factor 64
+			GAIN = 3;
+			break;
+		case 32:		// channel B, gain factor 32
+			GAIN = 2;
+			break;
+	}
 
+	sample_queue = xQueueCreate(HX711_BUFFER_SIZE, sizeof(hx711_sample_t));
+	if (sample_queue == NULL)
+		return false;
+	if (xTaskCreate(&HX711_readerTask, "hx711", HX711_TASK_STACK, NULL, HX711_TASK_PRIORITY, &reader_task) != pdPASS)
+		return false;
+	GPIOActivInt(dout, HX711_dataReadyIsr, false, NULL);
+	/* A conversion could be already waiting (DOUT low, no edge will come) */
+	if (HX711_isReady())
+		xTaskNotifyGive(reader_task);
+	return true;
+}
+
+uint16_t HX711_available(void)
+{
+	if (sample_queue == NULL)
+		return 0;
+	return uxQueueMessagesWaiting(sample_queue);
+}
+
+uint16_t HX711_readSamples(hx711_sample_t *samples, uint16_t max_samples, uint32_t timeout_ms)
+{
+	uint16_t n = 0;
+	TickType_t ticks = portMAX_DELAY;
+
+	if ((sample_queue == NULL) || (max_samples == 0))
+		return 0;
+	if (timeout_ms != HX711_NO_TIMEOUT)
+		ticks = pdMS_TO_TICKS(timeout_ms);
+	if (xQueueReceive(sample_queue, &samples[n], ticks) != pdTRUE)
+		return 0;
+	n++;
+	while ((n < max_samples) && (xQueueReceive(sample_queue, &samples[n], 0) == pdTRUE))
+		n++;
+	return n;
+}
+
+void HX711_tareAsync(uint8_t times)
+{
+	if (times == 0)
+		return;
+	tare_times = 0;
+	tare_sum = 0;
+	tare_count = 0;
+	tare_times = times;
+}
+
+bool HX711_tareDone(void)
+{
+	return tare_times == 0;
+}
@@ -11,18 +11,29 @@
 
 /*==================[inclusions]=============================================*/
 #include "ili9341.h"
+#include <string.h>
+#include <stdlib.h>
 #include "fonts.h"
 #include "spi_mcu.h"
 #include "gpio_mcu.h"
 #include "delay_mcu.h"
+#include "driver/spi_master.h"
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
 /*==================[macros and definitions]=================================*/
-#define NULL 0
-
 #define SPI_BR 20000000				/*!< Frequency of sck for SPI communication */
 #define MAX_PIXEL 320*240*2			/*!< Maximum number of bytes to write on LCD */
 #define MSK_BIT16 0x8000			/*!< 16th bit mask */
 #define MSK_BIT8 0x80				/*!< 8th bit mask */
-#define MAX_VALUE_SIZE 256			/*!< Maximum length of a data array to prevent excessive use of memory */
+#define LCD_SPI_HOST SPI2_HOST		/*!< ESP-EDU SPI port */
+#define LCD_QUEUE_SIZE 16			/*!< SPI transactions queued at the same time */
+#define LCD_CHUNK 4092				/*!< Bytes of pixel data per transaction (SPI bus max_transfer_sz) */
+#define LCD_BUFFERS 2				/*!< Pixel buffers: one is filled while the other is sent */
+#define TEXT_SEGMENT_MAX	64		/*!< Characters drawn in a single window */
+#define LCD_TXDATA_SIZE 4			/*!< Bytes that fit inside a transaction (no buffer needed) */
+#define IMAGE_RUN			0x80	/*!< Image packet header: run of one color (else literal indexes) */
+#define IMAGE_LEN_MSK		0x7F	/*!< Image packet header: pixels - 1 */
 #define LEFT -1						/*!< Horizontal grow direction */
 #define RIGHT 1						/*!< Horizontal grow direction */
 #define DOWN 1						/*!< Vertical grow direction */
@@ -32,6 +43,7 @@
 #define RESET				0x01 	/*!< Resets the commands and parameters to their S/W Reset default values */
 #define SLEEP_IN			0x10 	/*!< Enter to the minimum power consumption mode */
 #define SLEEP_OUT			0x11 	/*!< Turns off sleep mode */
+#define NORMAL_MODE_ON		0x13 	/*!< Returns to normal display mode (ends vertical scrolling) */
 #define DISPLAY_INV_OFF		0x20 	/*!< Recover from display inversion mode */
 #define DISPLAY_INV_ON		0x21 	/*!< Invert every bit from the frame memory to the display */
 #define GAMMA_SET			0x26 	/*!< Select the desired Gamma curve for the current display */
@@ -40,7 +52,9 @@
 #define COLUMN_ADDR_SET		0x2A 	/*!< Define columns of frame memory where MCU can access */
 #define PAGE_ADDR_SET		0x2B 	/*!< Define rows of frame memory where MCU can access */
 #define MEM_WRITE			0x2C 	/*!< Transfer data from MCU to frame memory */
+#define VERT_SCROLL_DEF		0x33 	/*!< Defines the vertical scrolling area of the display */
 #define MEM_ACC_CTRL		0x36 	/*!< Defines read/write scanning direction of frame memory */
+#define VERT_SCROLL_ADDR	0x37 	/*!< Frame memory line shown at the top of the scrolling area */
 #define PIXEL_FORMAT_SET	0x3A 	/*!< Sets the pixel format for the RGB image data used by the interface */
 #define WRITE_DISP_BRIGHT	0x51 	/*!< Adjust the brightness value of the display */
 #define WRITE_CTRL_DISP		0x53 	/*!< Control display brightness */
@@ -84,6 +98,57 @@ typedef struct {
 } lcd_cmd_t;
 /*==================[internal data declaration]==============================*/
 
+/**
+ * @brief Area of the window being written (see WindowBegin())
+ */
+typedef struct {
+	uint16_t x0;		/*!< First column */
+	uint16_t x1;		/*!< Last column */
+	uint16_t y;			/*!< Row being written */
+	uint16_t y1;		/*!< Last row */
+	uint16_t row_bytes;	/*!< Bytes of a row */
+	bool fb_rows;		/*!< Current row is in the framebuffer */
+	bool fb_clip;		/*!< Window exceeds the framebuffer width */
+	struct lcd_buffer *buf;	/*!< DMA buffer for rows sent to the panel */
+	uint32_t pos;		/*!< Bytes used in buf */
+} window_t;
+
+/**
+ * @brief Character rendered with its colors (see GlyphGet())
+ */
+typedef struct {
+	const Font_t *font;		/*!< Font of the character (NULL: free entry) */
+	char c;					/*!< Character */
+	uint16_t foreground;	/*!< Character color */
+	uint16_t background;	/*!< Background color */
+	uint32_t last_used;		/*!< Value of glyph_clock when it was last used */
+	uint8_t *pixels;		/*!< Rows of RGB565 pixels, high byte first */
+} glyph_t;
+
+/**
+ * @brief State of the trace renderer (see ILI9341TraceInit())
+ */
+typedef struct {
+	ili9341_trace_config_t cfg;					/*!< Configuration */
+	bool active;								/*!< Renderer enabled */
+	uint16_t pos;								/*!< Column of the plot written next */
+	uint16_t count;								/*!< Samples in the current column */
+	uint32_t columns;							/*!< Columns drawn (phase of the vertical grid) */
+	uint64_t scale;								/*!< Rows per value unit (Q32, rounded up) */
+	uint16_t row_min[ILI9341_TRACES_MAX];		/*!< Highest row (lowest value) of the current column */
+	uint16_t row_max[ILI9341_TRACES_MAX];		/*!< Lowest row (highest value) of the current column */
+	uint16_t row_end[ILI9341_TRACES_MAX];		/*!< Row of the last sample of the current column */
+	uint16_t row_last[ILI9341_TRACES_MAX];		/*!< Row of the last sample of the previous column */
+	bool has_last;								/*!< row_last holds a sample */
+} trace_t;
+
+/**
+ * @brief Pixel buffer used for DMA transfers
+ */
+typedef struct lcd_buffer {
+	uint8_t data[LCD_CHUNK];	/*!< Pixel data (RGB565, high byte first) */
+	uint32_t seq;				/*!< Last transaction that used the buffer */
+} lcd_buffer_t;
 /*==================[internal functions declaration]=========================*/
 
 /**
@@ -167,23 +232,36 @@ lcd_cmd_t lcd_init[] = {
 	{NEG_GAMMA, 15, neg_gamma},
 };
 
-lcd_cmd_t lcd_reset = {RESET, NULL, NULL};			/*!< SW reset */
-lcd_cmd_t lcd_sleep_out = {SLEEP_OUT, NULL, NULL};	/*!< Exit sleep mode */
-lcd_cmd_t lcd_on = {DISPLAY_ON, NULL, NULL};		/*!< Exit sleep mode */
-
-/*
- * @brief: SPI port configuration compatible with LCD interface
- */
-spi_mcu_config_t spi_conf = {
-	.device = NULL, 
-	.clk_mode = MODE0, 
-	.bitrate = SPI_BR, 
-	.transfer_mode = SPI_POLLING, 
-	.func_p = NULL,
-	.param_p = NULL };
+lcd_cmd_t lcd_reset = {RESET, 0, NULL};			/*!< SW reset */
+lcd_cmd_t lcd_sleep_out = {SLEEP_OUT, 0, NULL};	/*!< Exit sleep mode */
+lcd_cmd_t lcd_on = {DISPLAY_ON, 0, NULL};		/*!< Exit sleep mode */
 
-static spi_dev_t ili9341_spi;				/*!< uC SPI port */
+static spi_device_handle_t lcd_spi = NULL;	/*!< LCD device on the SPI bus */
 static gpio_t ili9341_dc, ili9341_rst;		/*!< uC GPIO ports to use as CS, DC and RST */
+static spi_transaction_t lcd_trans[LCD_QUEUE_SIZE];	/*!< Transactions ring */
+static uint32_t lcd_queued = 0;				/*!< Transactions queued since init */
+static uint32_t lcd_done = 0;				/*!< Transactions finished since init */
+static DMA_ATTR lcd_buffer_t lcd_buffers[LCD_BUFFERS];	/*!< Pixel buffers */
+static uint8_t lcd_next_buffer = 0;			/*!< Next buffer to fill */
+static DMA_ATTR uint8_t fill_buffer[LCD_CHUNK];	/*!< Buffer of one color, sent repeatedly by Fill() */
+static uint16_t fill_color;					/*!< Color in fill_buffer */
+static uint32_t fill_seq = 0;				/*!< Last transaction that used fill_buffer */
+static uint8_t *fb = NULL;					/*!< Framebuffer stripe (RGB565, high byte first) */
+static uint16_t fb_width;					/*!< Framebuffer width (pixels) */
+static uint16_t fb_y0;						/*!< First LCD row in the framebuffer */
+static uint16_t fb_rows;					/*!< Rows in the framebuffer */
+static ili9341_rect_t fb_dirty[ILI9341_DIRTY_MAX];	/*!< Changed areas not sent yet */
+static uint8_t fb_dirty_qty = 0;			/*!< Number of dirty areas */
+static WORD_ALIGNED_ATTR uint8_t fb_scratch[LCD_CHUNK];	/*!< Rows that exceed the framebuffer width */
+static window_t win;						/*!< Window being written */
+static uint16_t lcd_columns[2];				/*!< Last column range sent to the LCD */
+static uint16_t lcd_rows[2];				/*!< Last row range sent to the LCD */
+static bool lcd_window_valid = false;		/*!< lcd_columns and lcd_rows match the LCD registers */
+static glyph_t glyph_cache[ILI9341_GLYPH_CACHE_SIZE];	/*!< Rendered characters */
+static uint32_t glyph_cache_bytes = 0;		/*!< Memory used by glyph_cache */
+static uint32_t glyph_clock = 0;			/*!< Incremented for each text drawn (LRU order) */
+static trace_t trace = {.active = false};	/*!< Trace renderer */
+static uint8_t trace_column[2][2 * ILI9341_WIDTH];	/*!< Empty column of the plot: without and with vertical grid */
 
 static orientation_properties_t lcd_orientation = {
 		ILI9341_WIDTH,
@@ -193,19 +271,424 @@ static orientation_properties_t lcd_orientation = {
 
 /*==================[internal functions definition]==========================*/
 
+/**
+ * @brief Sets D/C before each transaction (command: 0, data: 1, stored in t->user)
+ */
+static void IRAM_ATTR LCDPreTransfer(spi_transaction_t *t){
+	gpio_set_level((gpio_num_t)ili9341_dc, (uint32_t)(uintptr_t)t->user);
+}
+
+/**
+ * @brief Waits for the oldest transaction in the queue to finish
+ */
+static void LCDCollect(void){
+	spi_transaction_t *t;
+	spi_device_get_trans_result(lcd_spi, &t, portMAX_DELAY);
+	lcd_done++;
+}
+
+/**
+ * @brief Waits until a transaction (and every one queued before it) is finished
+ */
+static void LCDWait(uint32_t seq){
+	while((int32_t)(lcd_done - seq) < 0){
+		LCDCollect();
+	}
+}
+
+/**
+ * @brief Queues a transaction
+ *
+ * Up to 4 bytes are copied into the transaction, longer data must be kept
+ * unchanged until the transaction ends (see LCDWait()).
+ *
+ * @return uint32_t Sequence number of the transaction
+ */
+static uint32_t LCDQueue(bool dc, const uint8_t *data, uint32_t len){
+	if(lcd_queued - lcd_done >= LCD_QUEUE_SIZE){
+		/* Transactions are finished in order: the oldest one frees its slot */
+		LCDCollect();
+	}
+	spi_transaction_t *t = &lcd_trans[lcd_queued % LCD_QUEUE_SIZE];
+	memset(t, 0, sizeof(spi_transaction_t));
+	t->length = len * 8;
+	t->user = (void *)(uintptr_t)dc;
+	if(len <= LCD_TXDATA_SIZE){
+		t->flags = SPI_TRANS_USE_TXDATA;
+		memcpy(t->tx_data, data, len);
+	} else{
+		t->tx_buffer = data;
+	}
+	spi_device_queue_trans(lcd_spi, t, portMAX_DELAY);
+	return ++lcd_queued;
+}
+
+/**
+ * @brief Gets a free pixel buffer (waits for the DMA to finish with it)
+ */
+static lcd_buffer_t *LCDGetBuffer(void){
+	lcd_buffer_t *buf = &lcd_buffers[lcd_next_buffer];
+	lcd_next_buffer = (lcd_next_buffer + 1) % LCD_BUFFERS;
+	LCDWait(buf->seq);
+	return buf;
+}
+
+/**
+ * @brief Queues the first len bytes of a pixel buffer
+ */
+static void LCDSendBuffer(lcd_buffer_t *buf, uint32_t len){
+	if(len > 0){
+		buf->seq = LCDQueue(true, buf->data, len);
+	}
+}
+
+static bool FbRow(uint16_t y){
+	return (fb != NULL) && (y >= fb_y0) && (y < fb_y0 + fb_rows);
+}
+
+static uint32_t RectArea(const ili9341_rect_t *r){
+	return (uint32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static ili9341_rect_t RectUnion(const ili9341_rect_t *a, const ili9341_rect_t *b){
+	ili9341_rect_t u = {
+		.x0 = (a->x0 < b->x0) ? a->x0 : b->x0,
+		.y0 = (a->y0 < b->y0) ? a->y0 : b->y0,
+		.x1 = (a->x1 > b->x1) ? a->x1 : b->x1,
+		.y1 = (a->y1 > b->y1) ? a->y1 : b->y1,
+	};
+	return u;
+}
+
+/**
+ * @brief Adds an area (in LCD coordinates) to the dirty list of the framebuffer
+ *
+ * Areas that overlap or touch are merged. When the list is full the new area
+ * is merged with the one whose union grows the least.
+ */
+static void FbMarkDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1){
+	ili9341_rect_t r;
+	uint8_t best = 0;
+	uint32_t best_growth = UINT32_MAX;
+
+	/* Clip to the framebuffer */
+	if ((fb == NULL) || (y1 < fb_y0) || (y0 >= fb_y0 + fb_rows) || (x0 >= fb_width)){
+		return;
+	}
+	r.x0 = x0;
+	r.x1 = (x1 < fb_width) ? x1 : fb_width - 1;
+	r.y0 = (y0 > fb_y0) ? y0 : fb_y0;
+	r.y1 = (y1 < fb_y0 + fb_rows) ? y1 : fb_y0 + fb_rows - 1;
+
+	for (uint8_t i = 0; i < fb_dirty_qty; ){
+		ili9341_rect_t *d = &fb_dirty[i];
+		if ((r.x0 <= d->x1 + 1) && (d->x0 <= r.x1 + 1) && (r.y0 <= d->y1 + 1) && (d->y0 <= r.y1 + 1)){
+			/* Overlapping or adjacent: take it out of the list and retry with the union */
+			r = RectUnion(&r, d);
+			fb_dirty[i] = fb_dirty[--fb_dirty_qty];
+			i = 0;
+		} else{
+			i++;
+		}
+	}
+	if (fb_dirty_qty < ILI9341_DIRTY_MAX){
+		fb_dirty[fb_dirty_qty++] = r;
+		return;
+	}
+	for (uint8_t i = 0; i < fb_dirty_qty; i++){
+		ili9341_rect_t u = RectUnion(&r, &fb_dirty[i]);
+		uint32_t growth = RectArea(&u) - RectArea(&fb_dirty[i]);
+		if (growth < best_growth){
+			best_growth = growth;
+			best = i;
+		}
+	}
+	fb_dirty[best] = RectUnion(&r, &fb_dirty[best]);
+}
+
+/**
+ * @brief Starts a window on the panel for the rows from win.y that are not in the framebuffer
+ */
+static void WindowSegment(void){
+	win.fb_rows = FbRow(win.y);
+	if (!win.fb_rows){
+		uint16_t last = win.y1;
+		if ((fb != NULL) && (win.y < fb_y0) && (last >= fb_y0)){
+			last = fb_y0 - 1;
+		}
+		SetCursorPosition(win.x0, win.y, win.x1, last);
+		LCDQueue(false, (uint8_t[]){MEM_WRITE}, 1);
+	}
+}
+
+/**
+ * @brief Starts writing an area, row by row (see WindowRow() and WindowRowDone())
+ *
+ * Rows inside the framebuffer are written in memory, the rest are sent to the panel.
+ * Rows can't be longer than LCD_CHUNK bytes.
+ */
+static void WindowBegin(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1){
+	win.x0 = x0;
+	win.x1 = x1;
+	win.y = y0;
+	win.y1 = y1;
+	win.row_bytes = (x1 - x0 + 1) * 2;
+	win.fb_clip = (x1 >= fb_width);
+	win.buf = NULL;
+	win.pos = 0;
+	FbMarkDirty(x0, y0, x1, y1);
+	WindowSegment();
+}
+
+/**
+ * @brief Where the next row (x1 - x0 + 1 pixels, high byte first) must be written
+ */
+static uint8_t *WindowRow(void){
+	if (win.fb_rows){
+		if (win.fb_clip){
+			return fb_scratch;
+		}
+		return &fb[((win.y - fb_y0) * fb_width + win.x0) * 2];
+	}
+	if ((win.buf == NULL) || (win.pos + win.row_bytes > LCD_CHUNK)){
+		if (win.buf != NULL){
+			LCDSendBuffer(win.buf, win.pos);
+		}
+		win.buf = LCDGetBuffer();
+		win.pos = 0;
+	}
+	return &win.buf->data[win.pos];
+}
+
+static void WindowRowDone(void){
+	if (!win.fb_rows){
+		win.pos += win.row_bytes;
+	} else if (win.fb_clip && (win.x0 < fb_width)){
+		/* Only the visible part of the row goes to the framebuffer */
+		memcpy(&fb[((win.y - fb_y0) * fb_width + win.x0) * 2], fb_scratch, (fb_width - win.x0) * 2);
+	}
+	win.y++;
+	if ((win.y <= win.y1) && (FbRow(win.y) != win.fb_rows)){
+		if (win.buf != NULL){
+			LCDSendBuffer(win.buf, win.pos);
+			win.buf = NULL;
+			win.pos = 0;
+		}
+		WindowSegment();
+	}
+}
+
+static void WindowEnd(void){
+	if (win.buf != NULL){
+		LCDSendBuffer(win.buf, win.pos);
+		win.buf = NULL;
+	}
+}
+
+/**
+ * @brief Converts a row of a 1 bit per pixel bitmap (MSB first) to RGB565
+ *
+ * @return Position after the last pixel written
+ */
+static uint8_t *ExpandRow(uint8_t *dst, const uint8_t *row, uint16_t width, uint16_t foreground, uint16_t background){
+	uint8_t fg_hi = HighByte(foreground), fg_lo = LowByte(foreground);
+	uint8_t bg_hi = HighByte(background), bg_lo = LowByte(background);
+
+	for (uint16_t j = 0; j < width; j += 8){
+		uint8_t bits = *row++;
+		uint8_t n = (width - j < 8) ? width - j : 8;
+		for (uint8_t k = 0; k < n; k++){
+			if (bits & MSK_BIT8){
+				*dst++ = fg_hi;
+				*dst++ = fg_lo;
+			} else{
+				*dst++ = bg_hi;
+				*dst++ = bg_lo;
+			}
+			bits <<= 1;
+		}
+	}
+	return dst;
+}
+
+/**
+ * @brief Sends a 1 bit per pixel bitmap (rows aligned to bytes, MSB first)
+ */
+static void DrawBitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *bitmap, uint16_t foreground, uint16_t background){
+	uint16_t row_bytes = (width + 7) / 8;
+
+	WindowBegin(x, y, x + width - 1, y + height - 1);
+	for (uint16_t i = 0; i < height; i++){
+		ExpandRow(WindowRow(), &bitmap[i * row_bytes], width, foreground, background);
+		WindowRowDone();
+	}
+	WindowEnd();
+}
+
+/**
+ * @brief Characters out of the font range are drawn as spaces
+ */
+static char FontChar(char c){
+	return ((c < FONT_FIRST_CHAR) || (c > FONT_LAST_CHAR)) ? FONT_FIRST_CHAR : c;
+}
+
+static void GlyphFree(glyph_t *glyph){
+	glyph_cache_bytes -= glyph->font->info[glyph->c - FONT_FIRST_CHAR].width * glyph->font->font_height * 2;
+	free(glyph->pixels);
+	glyph->pixels = NULL;
+	glyph->font = NULL;
+}
+
+/**
+ * @brief Returns a character rendered in RGB565, from the cache or rendered now
+ *
+ * Least recently used characters are freed to keep the cache within
+ * ILI9341_GLYPH_CACHE_BYTES. Characters used by the current text (same
+ * glyph_clock) are never freed.
+ *
+ * @return Pixels of the character, or NULL if it doesn't fit in the cache
+ */
+static const uint8_t *GlyphGet(Font_t *font, char c, uint16_t foreground, uint16_t background){
+	char_info_t *info;
+	uint32_t bytes;
+	uint16_t row_bytes;
+	glyph_t *glyph = NULL;
+	uint8_t *dst;
+
+	if ((c < FONT_FIRST_CHAR) || (c > FONT_LAST_CHAR)){
+		return NULL;
+	}
+	info = &font->info[c - FONT_FIRST_CHAR];
+	bytes = info->width * font->font_height * 2;
+	row_bytes = (info->width + 7) / 8;
+
+	for (uint8_t i = 0; i < ILI9341_GLYPH_CACHE_SIZE; i++){
+		glyph_t *g = &glyph_cache[i];
+		if ((g->font == font) && (g->c == c) && (g->foreground == foreground) && (g->background == background)){
+			g->last_used = glyph_clock;
+			return g->pixels;
+		}
+	}
+	if (bytes > ILI9341_GLYPH_CACHE_BYTES){
+		return NULL;
+	}
+	/* Frees the least recently used characters until there is an entry and memory for this one */
+	while (1){
+		glyph_t *lru = NULL;
+		glyph = NULL;
+		for (uint8_t i = 0; i < ILI9341_GLYPH_CACHE_SIZE; i++){
+			glyph_t *g = &glyph_cache[i];
+			if (g->font == NULL){
+				glyph = g;
+			} else if ((g->last_used != glyph_clock) && ((lru == NULL) || ((int32_t)(g->last_used - lru->last_used) < 0))){
+				lru = g;
+			}
+		}
+		if ((glyph != NULL) && (glyph_cache_bytes + bytes <= ILI9341_GLYPH_CACHE_BYTES)){
+			break;
+		}
+		if (lru == NULL){
+			return NULL;
+		}
+		GlyphFree(lru);
+	}
+	glyph->pixels = malloc(bytes);
+	if (glyph->pixels == NULL){
+		return NULL;
+	}
+	glyph->font = font;
+	glyph->c = c;
+	glyph->foreground = foreground;
+	glyph->background = background;
+	glyph->last_used = glyph_clock;
+	glyph_cache_bytes += bytes;
+	dst = glyph->pixels;
+	for (uint8_t i = 0; i < font->font_height; i++){
+		dst = ExpandRow(dst, &font->data[info->offset + i * row_bytes], info->width, foreground, background);
+	}
+	return glyph->pixels;
+}
+
+/**
+ * @brief Fills pixels of a row with a color
+ *
+ * @return Position after the last pixel written
+ */
+static uint8_t *FillRow(uint8_t *dst, uint16_t pixels, uint16_t color){
+	for (uint16_t i = 0; i < pixels; i++){
+		*dst++ = HighByte(color);
+		*dst++ = LowByte(color);
+	}
+	return dst;
+}
+
+/**
+ * @brief Draws characters of a single line in one window
+ *
+ * @param gap: Background columns between characters
+ * @param cell: Width of every character (centered, 0: its own width)
+ */
+static void DrawText(uint16_t x, uint16_t y, const char *str, uint8_t len, Font_t *font, uint16_t foreground, uint16_t background, uint8_t gap, uint8_t cell){
+	const uint8_t *src[TEXT_SEGMENT_MAX];	/* Next row of each character */
+	bool cached[TEXT_SEGMENT_MAX];
+	uint8_t widths[TEXT_SEGMENT_MAX], pad_left[TEXT_SEGMENT_MAX], pad_right[TEXT_SEGMENT_MAX];
+	uint16_t width = 0;
+
+	if (len == 0){
+		return;
+	}
+	glyph_clock++;
+	for (uint8_t i = 0; i < len; i++){
+		char c = FontChar(str[i]);
+		char_info_t *info = &font->info[c - FONT_FIRST_CHAR];
+		uint8_t pad = cell ? cell - info->width : 0;
+		src[i] = GlyphGet(font, c, foreground, background);
+		cached[i] = (src[i] != NULL);
+		if (!cached[i]){
+			/* Rendered row by row from the font */
+			src[i] = &font->data[info->offset];
+		}
+		widths[i] = info->width;
+		pad_left[i] = pad / 2;
+		pad_right[i] = pad - pad / 2 + ((i < len - 1) ? gap : 0);
+		width += widths[i] + pad + gap;
+	}
+	width -= gap;
+
+	WindowBegin(x, y, x + width - 1, y + font->font_height - 1);
+	for (uint16_t row = 0; row < font->font_height; row++){
+		uint8_t *dst = WindowRow();
+		for (uint8_t i = 0; i < len; i++){
+			dst = FillRow(dst, pad_left[i], background);
+			if (cached[i]){
+				memcpy(dst, src[i], widths[i] * 2);
+				dst += widths[i] * 2;
+				src[i] += widths[i] * 2;
+			} else{
+				dst = ExpandRow(dst, src[i], widths[i], foreground, background);
+				src[i] += (widths[i] + 7) / 8;
+			}
+			dst = FillRow(dst, pad_right[i], background);
+		}
+		WindowRowDone();
+	}
+	WindowEnd();
+}
+
 void WriteLCD(lcd_cmd_t * data){
-	SpiInit(&spi_conf);
-	/* If command is NULL don't send command */
-	if (data->cmd != NULL){
+	/* If command is 0 don't send command */
+	if (data->cmd != 0){
 		/* Send command */
-		GPIOOff(ili9341_dc);
-		SpiWrite(ili9341_spi, &data->cmd, 1);
+		LCDQueue(false, &data->cmd, 1);
 	}
 	/* If there are parameters or data to send */
-	if (data->databytes != NULL){
+	if (data->databytes != 0){
 		/* Send parameters or data */
-		GPIOOn(ili9341_dc);
-		SpiWrite(ili9341_spi, data->data, data->databytes);
+		uint32_t seq = LCDQueue(true, data->data, data->databytes);
+		if (data->databytes > LCD_TXDATA_SIZE){
+			/* Caller's buffer could be modified after return */
+			LCDWait(seq);
+		}
 	}
 }
 
@@ -223,61 +706,230 @@ void SetCursorPosition(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1){
 		y0 = y1;
 		y1 = aux;
 	}
-	uint8_t columns[] = {HighByte(x0), LowByte(x0), HighByte(x1), LowByte(x1)};
-	lcd_cmd_t lcd_columns = {COLUMN_ADDR_SET, 4, columns};
-	uint8_t rows[] = {HighByte(y0), LowByte(y0), HighByte(y1), LowByte(y1)};
-	lcd_cmd_t lcd_rows = {PAGE_ADDR_SET, 4, rows};
-	WriteLCD(&lcd_columns);
-	WriteLCD(&lcd_rows);
+	/* Each range is sent only if it changed (MEM_WRITE restarts from the window origin) */
+	if (!lcd_window_valid || (x0 != lcd_columns[0]) || (x1 != lcd_columns[1])){
+		uint8_t columns[] = {HighByte(x0), LowByte(x0), HighByte(x1), LowByte(x1)};
+		lcd_cmd_t lcd_columns_cmd = {COLUMN_ADDR_SET, 4, columns};
+		WriteLCD(&lcd_columns_cmd);
+		lcd_columns[0] = x0;
+		lcd_columns[1] = x1;
+	}
+	if (!lcd_window_valid || (y0 != lcd_rows[0]) || (y1 != lcd_rows[1])){
+		uint8_t rows[] = {HighByte(y0), LowByte(y0), HighByte(y1), LowByte(y1)};
+		lcd_cmd_t lcd_rows_cmd = {PAGE_ADDR_SET, 4, rows};
+		WriteLCD(&lcd_rows_cmd);
+		lcd_rows[0] = y0;
+		lcd_rows[1] = y1;
+	}
+	lcd_window_valid = true;
+}
+
+/**
+ * @brief Fills an area of the panel (x0 <= x1, y0 <= y1), without the framebuffer
+ */
+static void PanelFill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
+	uint16_t i;
+	int32_t bytes_count;
+
+	/* Number of bytes to write. We have to write 2 bytes/pixel (16bits color) */
+	bytes_count = (x1 - x0 + 1) * (y1 - y0 + 1) * 2;
+	/* Define area to fill */
+	SetCursorPosition(x0, y0, x1, y1);
+
+	if ((color != fill_color) || (fill_seq == 0)){
+		/* The buffer could still be on the wire with the previous color */
+		LCDWait(fill_seq);
+		for (i = 0; i < LCD_CHUNK; i += 2){
+			fill_buffer[i] = HighByte(color);
+			fill_buffer[i + 1] = LowByte(color);
+		}
+		fill_color = color;
+	}
+	/* Start writing LCD memory */
+	LCDQueue(false, (uint8_t[]){MEM_WRITE}, 1);
+
+	/* The same buffer is queued as many times as needed */
+	while(bytes_count > 0){
+		uint32_t len = (bytes_count > LCD_CHUNK) ? LCD_CHUNK : bytes_count;
+		fill_seq = LCDQueue(true, fill_buffer, len);
+		bytes_count -= len;
+	}
 }
 
 void Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
-	static uint16_t i;
-	static int32_t bytes_count;
-	static int16_t x_dist, y_dist;
-	static uint8_t pixel[MAX_VALUE_SIZE];
+	uint16_t aux;
+	uint16_t fb_first, fb_last;
 
-	x_dist = x1 - x0;
-	y_dist = y1 - y0;
 	if (x0 > x1){
-		x_dist = - x_dist;
+		aux = x0;
+		x0 = x1;
+		x1 = aux;
 	}
 	if (y0 > y1){
-		y_dist = - y_dist;
+		aux = y0;
+		y0 = y1;
+		y1 = aux;
 	}
-	/* Number of bytes to write. We have to write 2 bytes/pixel (16bits color) */
-	bytes_count = (x_dist + 1) * (y_dist + 1) * 2;
-	/* Define area to fill */
-	SetCursorPosition(x0, y0, x1, y1);
+	if ((fb == NULL) || (y1 < fb_y0) || (y0 >= fb_y0 + fb_rows)){
+		PanelFill(x0, y0, x1, y1, color);
+		return;
+	}
+	/* Rows above and below the framebuffer go to the panel */
+	fb_first = (y0 > fb_y0) ? y0 : fb_y0;
+	fb_last = (y1 < fb_y0 + fb_rows) ? y1 : fb_y0 + fb_rows - 1;
+	if (y0 < fb_first){
+		PanelFill(x0, y0, x1, fb_first - 1, color);
+	}
+	if (y1 > fb_last){
+		PanelFill(x0, fb_last + 1, x1, y1, color);
+	}
+	if (x0 >= fb_width){
+		return;
+	}
+	if (x1 >= fb_width){
+		x1 = fb_width - 1;
+	}
+	/* First row is filled pixel by pixel, the rest are copies of it */
+	uint8_t *first = &fb[((fb_first - fb_y0) * fb_width + x0) * 2];
+	uint16_t row_bytes = (x1 - x0 + 1) * 2;
+	for (aux = 0; aux < row_bytes; aux += 2){
+		first[aux] = HighByte(color);
+		first[aux + 1] = LowByte(color);
+	}
+	for (aux = fb_first + 1; aux <= fb_last; aux++){
+		memcpy(&fb[((aux - fb_y0) * fb_width + x0) * 2], first, row_bytes);
+	}
+	FbMarkDirty(x0, fb_first, x1, fb_last);
+}
 
-	for (i = 0; i < MAX_VALUE_SIZE; i += 2){
-		pixel[i] = HighByte(color);
-		pixel[i + 1] = LowByte(color);
+/**
+ * @brief Draws a horizontal span (x0 and x1 in any order), clipped to the screen
+ */
+static void HSpan(int16_t x0, int16_t x1, int16_t y, uint16_t color){
+	int16_t aux;
+
+	if (x0 > x1){
+		aux = x0;
+		x0 = x1;
+		x1 = aux;
 	}
-	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
+	if ((y < 0) || (y >= lcd_orientation.height) || (x1 < 0) || (x0 >= lcd_orientation.width)){
+		return;
+	}
+	if (x0 < 0){
+		x0 = 0;
+	}
+	if (x1 >= lcd_orientation.width){
+		x1 = lcd_orientation.width - 1;
+	}
+	Fill(x0, y, x1, y, color);
+}
+
+/**
+ * @brief Draws a vertical span (y0 and y1 in any order), clipped to the screen
+ */
+static void VSpan(int16_t x, int16_t y0, int16_t y1, uint16_t color){
+	int16_t aux;
 
-	while(bytes_count - MAX_VALUE_SIZE > 0){
-		lcd_cmd_t lcd_pixel = {NULL, MAX_VALUE_SIZE, pixel};
-		WriteLCD(&lcd_pixel);
-		bytes_count -= MAX_VALUE_SIZE;
+	if (y0 > y1){
+		aux = y0;
+		y0 = y1;
+		y1 = aux;
+	}
+	if ((x < 0) || (x >= lcd_orientation.width) || (y1 < 0) || (y0 >= lcd_orientation.height)){
+		return;
+	}
+	if (y0 < 0){
+		y0 = 0;
+	}
+	if (y1 >= lcd_orientation.height){
+		y1 = lcd_orientation.height - 1;
+	}
+	Fill(x, y0, x, y1, color);
+}
+
+/**
+ * @brief Sets the frame memory line shown at the top of the scrolling area
+ */
+static void TraceScroll(uint16_t line){
+	uint8_t vsp[] = {HighByte(line), LowByte(line)};
+	lcd_cmd_t lcd_vsp = {VERT_SCROLL_ADDR, sizeof(vsp), vsp};
+	WriteLCD(&lcd_vsp);
+}
+
+/**
+ * @brief Draws the current column of the plot (grid and min/max of each trace)
+ *
+ * @param samples: false to draw only the grid
+ */
+static void TraceColumn(bool samples){
+	ili9341_trace_config_t *cfg = &trace.cfg;
+	bool grid = (cfg->grid_x != 0) && ((trace.columns % cfg->grid_x) == 0);
+	lcd_buffer_t *buf = LCDGetBuffer();
+	uint16_t x = cfg->x + trace.pos;
+
+	memcpy(buf->data, trace_column[grid], cfg->height * 2);
+	for (uint8_t t = 0; samples && (t < cfg->traces); t++){
+		uint16_t top = trace.row_min[t], bottom = trace.row_max[t];
+		/* Joined to the previous column, so fast edges have no gaps */
+		if (trace.has_last){
+			if (trace.row_last[t] < top){
+				top = trace.row_last[t];
+			}
+			if (trace.row_last[t] > bottom){
+				bottom = trace.row_last[t];
+			}
+		}
+		FillRow(&buf->data[top * 2], bottom - top + 1, cfg->colors[t]);
+	}
+	SetCursorPosition(x, cfg->y, x, cfg->y + cfg->height - 1);
+	LCDQueue(false, (uint8_t[]){MEM_WRITE}, 1);
+	LCDSendBuffer(buf, cfg->height * 2);
+	trace.columns++;
+	if (++trace.pos == cfg->width){
+		trace.pos = 0;
 	}
-	lcd_cmd_t lcd_pixel = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixel);
 }
 
+/**
+ * @brief Shows the last column written at the right of the plot
+ *
+ * Landscape_1 shows frame memory lines from left to right (line = x), and
+ * Landscape_2 from right to left (line = 319 - x).
+ */
+static void TraceShow(void){
+	ili9341_trace_config_t *cfg = &trace.cfg;
+	if (lcd_orientation.orientation == ILI9341_Landscape_1){
+		/* Oldest column (next to be written) at the left */
+		TraceScroll(cfg->x + trace.pos);
+	} else{
+		/* Newest column at the top of the scrolling area */
+		uint16_t last = (trace.pos == 0) ? cfg->width - 1 : trace.pos - 1;
+		TraceScroll(ILI9341_HEIGHT - cfg->x - cfg->width + (cfg->width - 1 - last));
+	}
+}
 /*==================[external functions definition]==========================*/
 
 uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
-	/* SPI configuration */
-	spi_conf.device = spi_dev;
-	ili9341_spi = spi_dev;
+	/* SPI configuration: the device is added once, D/C is set by LCDPreTransfer() */
+	spi_device_interface_config_t dev_cfg = {
+		.clock_speed_hz = SPI_BR,
+		.mode = MODE0,
+		.spics_io_num = SpiGetCsPin(spi_dev),
+		.queue_size = LCD_QUEUE_SIZE,
+		.pre_cb = LCDPreTransfer,
+	};
 	/* GPIOs configuration and initialization */
 	ili9341_dc = gpio_dc;
 	ili9341_rst = gpio_rst;
 	GPIOInit(ili9341_dc, GPIO_OUTPUT);
 	GPIOInit(ili9341_rst, GPIO_OUTPUT);
+	if (lcd_spi == NULL){
+		SpiBusInit();
+		if (spi_bus_add_device(LCD_SPI_HOST, &dev_cfg, &lcd_spi) != ESP_OK){
+			return false;
+		}
+	}
 
 	/* RST must be held low for minimum 10µsec after VCC have been applied */
 	DelayUs(10);
@@ -286,6 +938,8 @@ uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
 	DelayUs(10);
 	/* It will be necessary to wait 5msec before sending new command following software reset */
 	WriteLCD(&lcd_reset);
+	lcd_window_valid = false;
+	LCDWait(lcd_queued);
 	DelayMs(5);
 	/* Send initial configuration to LCD */
 	for (uint8_t i = 0; i < sizeof(lcd_init)/sizeof(lcd_cmd_t); i++){
@@ -293,8 +947,10 @@ uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
 	}
 	/* It will be necessary to wait 5msec before sending next command after sleep out */
 	WriteLCD(&lcd_sleep_out);
+	LCDWait(lcd_queued);
 	DelayMs(10);
 	WriteLCD(&lcd_on);
+	LCDWait(lcd_queued);
 	DelayMs(20);
 	/* Start screen on White */
 	ILI9341Fill(ILI9341_WHITE);
@@ -303,6 +959,14 @@ uint8_t ILI9341Init(spi_dev_t spi_dev, uint8_t gpio_dc, uint8_t gpio_rst){
 }
 
 void ILI9341DrawPixel(uint16_t x, uint16_t y, uint16_t color){
+	if (FbRow(y)){
+		if (x < fb_width){
+			fb[((y - fb_y0) * fb_width + x) * 2] = HighByte(color);
+			fb[((y - fb_y0) * fb_width + x) * 2 + 1] = LowByte(color);
+			FbMarkDirty(x, y, x, y);
+		}
+		return;
+	}
 	/* Define area (pixel) to fill */
 	SetCursorPosition(x, y, x, y);
 	uint8_t pixels[] = {HighByte(color), LowByte(color)};
@@ -347,149 +1011,65 @@ void ILI9341Rotate(ili9341_orientation_t orientation){
 	}
 	lcd_cmd_t lcd_mem_acc = {MEM_ACC_CTRL, 1, mem_acc};
 	WriteLCD(&lcd_mem_acc);
+	lcd_window_valid = false;
+	ILI9341TraceStop();
+	/* Framebuffer was sized for the previous orientation */
+	ILI9341FramebufferDeInit();
 }
 
 void ILI9341DrawChar(uint16_t x, uint16_t y, char data, Font_t* font, uint16_t foreground, uint16_t background){
-	static uint32_t i, j, k;
-	static uint32_t char_row;
-	static uint16_t lcd_x, lcd_y;
-	static int32_t bytes_count, bytes_row;
-	static uint8_t pixel[MAX_VALUE_SIZE];
-
-	/* Set coordinates */
-	lcd_x = x;
-	lcd_y = y;
+	char_info_t *info = &font->info[FontChar(data) - FONT_FIRST_CHAR];
 
 	/* If at the end of a line of display, go to new line and set x to 0 position */
-	if ((lcd_x + font->info[data - ' '].width) > lcd_orientation.width)	{
-		lcd_y += font->font_height;
-		lcd_x = 0;
-	}
-
-	SetCursorPosition(lcd_x, lcd_y, lcd_x + font->info[data - ' '].width - 1, lcd_y + font->font_height - 1);
-
-	/* Number of bytes to write. We have to write 2 bytes/pixel */
-	bytes_count = font->font_height * font->info[data - ' '].width * 2;
-
-	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
-
-	/* Draw font data */
-	/* go through character rows */
-	k = 0;
-	for (i = 0; i < font->font_height; i++)	{
-		/* */
-		char_row = font->info[data - ' '].offset + i * ((font->info[data - ' '].width + 7) / 8);
-		/* go through character columns */
-		bytes_row = -1;
-		for (j = 0; j < font->info[data - ' '].width; j++){
-			if(j % 8 == 0){
-				bytes_row++;
-			}
-			/* If exceed buffer size, send buffer */
-			if ((2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE + 1) > MAX_VALUE_SIZE){
-				lcd_cmd_t lcd_pixels = {NULL, MAX_VALUE_SIZE, pixel};
-				WriteLCD(&lcd_pixels);
-				bytes_count -= MAX_VALUE_SIZE;
-				k++;
-			}
-			/* The n=FontWidth first bits of the 16bits row data draws the corresponding part of a character */
-			if (font->data[char_row + bytes_row] & (MSK_BIT8 >> (j % 8))){
-				/* if bit = 1, draw put foreground color */
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE] = HighByte(foreground);
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(foreground);
-			}
-			else{
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE] = HighByte(background);
-				pixel[2 * j + i * font->info[data - ' '].width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(background);
-			}
-		}
+	if ((x + info->width) > lcd_orientation.width)	{
+		y += font->font_height;
+		x = 0;
 	}
-	/* Send the rest of the buffer */
-	lcd_cmd_t lcd_pixels = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixels);
+	DrawText(x, y, &data, 1, font, foreground, background, 0, 0);
 }
 
 void ILI9341DrawIcon(uint16_t x, uint16_t y, icon_t icon, icon_font_t* icon_font, uint16_t foreground, uint16_t background){
-	static uint32_t i, j, k;
-	static uint32_t char_row;
-	static uint16_t lcd_x, lcd_y;
-	static int32_t bytes_count, bytes_row;
-	static uint8_t pixel[MAX_VALUE_SIZE];
-
-	/* Set coordinates */
-	lcd_x = x;
-	lcd_y = y;
-
 	/* If at the end of a line of display, go to new line and set x to 0 position */
-	if ((lcd_x + icon_font->width) > lcd_orientation.width)	{
-		lcd_y += icon_font->height;
-		lcd_x = 0;
-	}
-
-	SetCursorPosition(lcd_x, lcd_y, lcd_x + icon_font->width - 1, lcd_y + icon_font->height - 1);
-
-	/* Number of bytes to write. We have to write 2 bytes/pixel */
-	bytes_count = icon_font->height * icon_font->width * 2;
-
-	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
-
-	/* Draw font data */
-	/* go through character rows */
-	k = 0;
-	for (i = 0; i < icon_font->height; i++)	{
-		/*  */
-		char_row = icon * icon_font->offset + i * ((icon_font->width + 7) / 8);
-		/* go through character columns */
-		bytes_row = -1;
-		for (j = 0; j < icon_font->width; j++){
-			if(j % 8 == 0){
-				bytes_row++;
-			}
-			/* If exceed buffer size, send buffer */
-			if ((2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE + 1) > MAX_VALUE_SIZE){
-				lcd_cmd_t lcd_pixels = {NULL, MAX_VALUE_SIZE, pixel};
-				WriteLCD(&lcd_pixels);
-				bytes_count -= MAX_VALUE_SIZE;
-				k++;
-			}
-			/* The n=FontWidth first bits of the 16bits row data draws the corresponding part of a character */
-			if (icon_font->data[char_row + bytes_row] & (MSK_BIT8 >> (j % 8))){
-				/* if bit = 1, draw put foreground color */
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE] = HighByte(foreground);
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(foreground);
-			}
-			else{
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE] = HighByte(background);
-				pixel[2 * j + i * icon_font->width * 2 - k * MAX_VALUE_SIZE + 1] = LowByte(background);
-			}
-		}
+	if ((x + icon_font->width) > lcd_orientation.width)	{
+		y += icon_font->height;
+		x = 0;
 	}
-	/* Send the rest of the buffer */
-	lcd_cmd_t lcd_pixels = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixels);
+	DrawBitmap(x, y, icon_font->width, icon_font->height, &icon_font->data[icon * icon_font->offset], foreground, background);
 }
 
 void ILI9341DrawInt(uint16_t x, uint16_t y, uint32_t num, uint8_t dig, Font_t* font, uint16_t foreground, uint16_t background){
-	static uint16_t i;
-	static uint16_t lcd_x, lcd_y;
-
-	/* Set coordinates */
-	lcd_x = x;
-	lcd_y = y;
+	char digits[TEXT_SEGMENT_MAX];
+	uint8_t cell = 0;
+	uint8_t len;
 
-	for (i=0; i<dig; i++){
-		lcd_x = x + font->info[num%10 + '0' - ' '].width * (dig-1-i) + 1;
-		ILI9341DrawChar(lcd_x, lcd_y, num%10 + '0', font, foreground, background);
+	if (dig > TEXT_SEGMENT_MAX){
+		dig = TEXT_SEGMENT_MAX;
+	}
+	/* Every digit takes the width of the widest one, so the number doesn't move when it changes */
+	for (char c = '0'; c <= '9'; c++){
+		if (font->info[c - FONT_FIRST_CHAR].width > cell){
+			cell = font->info[c - FONT_FIRST_CHAR].width;
+		}
+	}
+	for (uint8_t i = dig; i > 0; i--){
+		digits[i - 1] = num%10 + '0';
 		num = num/10;
 	}
+	/* Digits that don't fit in the display are not drawn (the window must be within the display width) */
+	if ((cell == 0) || ((x + 1) >= lcd_orientation.width)){
+		return;
+	}
+	len = (lcd_orientation.width - (x + 1)) / cell;
+	if (len > dig){
+		len = dig;
+	}
+	/* Digits are drawn side by side, in a single window */
+	DrawText(x + 1, y, digits, len, font, foreground, background, 0, cell);
 }
 
 void ILI9341DrawString(uint16_t x, uint16_t y, char* str, Font_t *font, uint16_t foreground, uint16_t background){
-	static uint16_t lcd_x, lcd_y;
+	uint16_t lcd_x, lcd_y, width;
+	uint8_t len;
 
 	/* Set coordinates */
 	lcd_x = x;
@@ -508,16 +1088,37 @@ void ILI9341DrawString(uint16_t x, uint16_t y, char* str, Font_t *font, uint16_t
 				lcd_x = x;
 			}
 			str++;
+			continue;
 		}
 		else if (*str == '\r'){
+			str++;
+			continue;
+		}
+
+		/* Characters that fit in the line are drawn in a single window (1 pixel apart) */
+		len = 0;
+		width = 0;
+		while ((str[len] != '\0') && (str[len] != '\n') && (str[len] != '\r') && (len < TEXT_SEGMENT_MAX)){
+			uint8_t char_width = font->info[FontChar(str[len]) - FONT_FIRST_CHAR].width;
+			if ((lcd_x + width + char_width) > lcd_orientation.width){
+				break;
+			}
+			width += char_width + 1;
+			len++;
+		}
+		if (len == 0){
+			/* If at the end of a line of display, go to new line and set x to 0 position */
+			if (lcd_x == 0){
+				/* Character wider than the display */
 				str++;
 			}
-
-		/* Put character to LCD */
-		ILI9341DrawChar(lcd_x, lcd_y, *str, font, foreground, background);
-		lcd_x += font->info[*str - ' '].width + 1;
-		/* Next character */
-		str++;
+			lcd_y += font->font_height;
+			lcd_x = 0;
+			continue;
+		}
+		DrawText(lcd_x, lcd_y, str, len, font, foreground, background, 1, 0);
+		lcd_x += width;
+		str += len;
 	}
 }
 
@@ -528,14 +1129,14 @@ void ILI9341GetStringSize(char* str, Font_t* font, uint16_t* width, uint16_t* he
 	w = 0;
 	while (*str != '\0'){	/* End of string */
 	
-		w += font->info[*str - ' '].width + 1;
+		w += font->info[FontChar(*str) - FONT_FIRST_CHAR].width + 1;
 		str++;
 	}
 	*width = w;
 }
 
 void ILI9341DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color){
-	static int16_t x_dist, y_dist, x_grow, y_grow, error, error_2;
+	int16_t x_dist, y_dist, x_grow, y_grow, error, run_start;
 
 	/* Check for overflow */
 	if (x0 >= lcd_orientation.width){
@@ -573,29 +1174,37 @@ void ILI9341DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_
 	if (x_dist == 0 || y_dist == 0){
 		Fill(x0, y0, x1, y1, color);
 	}
-	/* Diagonal line */
-	else{
-		error = x_dist - y_dist;
-
-		while (1){
-			/* Draw start point */
-			ILI9341DrawPixel(x0, y0, color);
-			/* Loop ends when start point reaches end point */
-			if (x0 == x1 && y0 == y1){
-				break;
-			}
-			error_2 = 2 * error;
-			/* Determine if line must grow in x direction */
-			if (error_2 > -y_dist){
-				error -= y_dist;
-				x0 += x_grow;	/* Move start point */
-			}
-			/* Determine if line must grow in y direction */
-			if (error_2 < x_dist){
+	/* Mostly horizontal line: one span for each row */
+	else if (x_dist >= y_dist){
+		error = x_dist / 2;
+		run_start = x0;
+		while (x0 != x1){
+			error -= y_dist;
+			if (error < 0){
+				HSpan(run_start, x0, y0, color);
 				error += x_dist;
-				y0 += y_grow;	/* Move start point */
+				y0 += y_grow;
+				run_start = x0 + x_grow;
 			}
+			x0 += x_grow;
 		}
+		HSpan(run_start, x1, y0, color);
+	}
+	/* Mostly vertical line: one span for each column */
+	else{
+		error = y_dist / 2;
+		run_start = y0;
+		while (y0 != y1){
+			error -= x_dist;
+			if (error < 0){
+				VSpan(x0, run_start, y0, color);
+				error += y_dist;
+				x0 += x_grow;
+				run_start = y0 + y_grow;
+			}
+			y0 += y_grow;
+		}
+		VSpan(x1, run_start, y1, color);
 	}
 }
 
@@ -611,72 +1220,67 @@ void ILI9341DrawFilledRectangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t
 }
 
 void ILI9341DrawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color){
-	static int16_t f, ddF_x, ddF_y, x, y;
-
-	f = 1 - r;
-	ddF_x = 1;
-	ddF_y = -2 * r;
-	x = 0;
-	y = r;
-
-	ILI9341DrawPixel(x0, y0 + r, color);
-	ILI9341DrawPixel(x0, y0 - r, color);
-	ILI9341DrawPixel(x0 + r, y0, color);
-	ILI9341DrawPixel(x0 - r, y0, color);
-
-    while (x < y){
-        if (f >= 0){
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        ILI9341DrawPixel(x0 + x, y0 + y, color);
-        ILI9341DrawPixel(x0 - x, y0 + y, color);
-        ILI9341DrawPixel(x0 + x, y0 - y, color);
-        ILI9341DrawPixel(x0 - x, y0 - y, color);
-
-        ILI9341DrawPixel(x0 + y, y0 + x, color);
-        ILI9341DrawPixel(x0 - y, y0 + x, color);
-        ILI9341DrawPixel(x0 + y, y0 - x, color);
-        ILI9341DrawPixel(x0 - y, y0 - x, color);
-    }
+	int16_t x = 0, y = r, f = 1 - r, run_start = 0;
+	bool step_y, last;
+
+	/* Points of an octant with the same y form a run: each run is drawn as
+	 * 4 horizontal and 4 vertical spans (its mirrors in the other octants) */
+	while (x <= y){
+		step_y = (f >= 0);
+		last = (x + 1 > (step_y ? y - 1 : y));
+		if (step_y || last){
+			/* Mirrored spans skip the axis, already drawn by the first run */
+			int16_t mirror_start = (run_start > 0) ? run_start : 1;
+			HSpan(x0 + run_start, x0 + x, y0 + y, color);
+			HSpan(x0 + run_start, x0 + x, y0 - y, color);
+			VSpan(x0 + y, y0 + run_start, y0 + x, color);
+			VSpan(x0 - y, y0 + run_start, y0 + x, color);
+			if (x >= mirror_start){
+				HSpan(x0 - mirror_start, x0 - x, y0 + y, color);
+				HSpan(x0 - mirror_start, x0 - x, y0 - y, color);
+				VSpan(x0 + y, y0 - mirror_start, y0 - x, color);
+				VSpan(x0 - y, y0 - mirror_start, y0 - x, color);
+			}
+			run_start = x + 1;
+		}
+		if (f < 0){
+			f += 2 * x + 3;
+		} else{
+			f += 2 * (x - y) + 5;
+			y--;
+		}
+		x++;
+	}
 }
 
 void ILI9341DrawFilledCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color){
-	static int16_t f, ddF_x, ddF_y, x, y;
-
-	f = 1 - r;
-	ddF_x = 1;
-	ddF_y = -2 * r;
-	x = 0;
-	y = r;
-
-    ILI9341DrawPixel(x0, y0 + r, color);
-    ILI9341DrawPixel(x0, y0 - r, color);
-    ILI9341DrawPixel(x0 + r, y0, color);
-    ILI9341DrawPixel(x0 - r, y0, color);
-    ILI9341DrawLine(x0 - r, y0, x0 + r, y0, color);
-
-    while (x < y){
-        if (f >= 0){
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        ILI9341DrawLine(x0 - x, y0 + y, x0 + x, y0 + y, color);
-        ILI9341DrawLine(x0 + x, y0 - y, x0 - x, y0 - y, color);
-
-        ILI9341DrawLine(x0 + y, y0 + x, x0 - y, y0 + x, color);
-        ILI9341DrawLine(x0 + y, y0 - x, x0 - y, y0 - x, color);
-    }
+	int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+	int16_t prev_x = 0, prev_y = r;
+
+	/* Each row is drawn once, with its full width */
+	HSpan(x0 - r, x0 + r, y0, color);
+	while (x < y){
+		if (f >= 0){
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+		/* Rows y0 +/- x are as wide as 2y */
+		if (x <= y){
+			HSpan(x0 - y, x0 + y, y0 + x, color);
+			HSpan(x0 - y, x0 + y, y0 - x, color);
+		}
+		/* Rows y0 +/- prev_y got their final width (2 prev_x) when y moved */
+		if ((y != prev_y) && (prev_x < prev_y)){
+			HSpan(x0 - prev_x, x0 + prev_x, y0 + prev_y, color);
+			HSpan(x0 - prev_x, x0 + prev_x, y0 - prev_y, color);
+			prev_y = y;
+		}
+		prev_x = x;
+	}
 }
 
 void ILI9341DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color){
@@ -800,37 +1404,250 @@ void ILI9341DrawFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, i
 }
 
 void ILI9341DrawPicture(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* pic){
-	static uint16_t i, j;
-	static int32_t bytes_count;
-	static uint8_t pixel[MAX_VALUE_SIZE];
+	uint16_t row_bytes = width * 2;
+
+	/* Picture is copied from flash row by row, to the framebuffer or to a DMA buffer */
+	WindowBegin(x, y, x + width - 1, y + height - 1);
+	for (uint16_t i = 0; i < height; i++){
+		memcpy(WindowRow(), pic, row_bytes);
+		pic += row_bytes;
+		WindowRowDone();
+	}
+	WindowEnd();
+}
 
-	SetCursorPosition(x, y, x + width - 1, y + height - 1);
+void ILI9341DrawImage(uint16_t x, uint16_t y, const ili9341_image_t *image){
+	const uint8_t *src = image->data;
+	const uint8_t *end = image->data + image->data_size;
+	uint16_t palette[ILI9341_PALETTE_MAX];
+	uint8_t run = 0, index = 0;
+	bool literal = false;
 
-	/* Number of bytes to write. We have to write 2 bytes/pixel */
-	bytes_count = width * height * 2;
+	if ((image->palette_size == 0) || (image->palette_size > ILI9341_PALETTE_MAX)){
+		return;
+	}
+	/* A row must fit in a transaction (see WindowBegin()) */
+	if ((image->width == 0) || (image->height == 0) || (image->width * 2 > LCD_CHUNK)){
+		return;
+	}
+	/* Palette in the byte order sent to the LCD (high byte first) */
+	for (uint16_t i = 0; i < image->palette_size; i++){
+		palette[i] = (image->palette[i] >> 8) | (image->palette[i] << 8);
+	}
+	/* Indexes past the palette are clamped to its last color (no check per pixel) */
+	for (uint16_t i = image->palette_size; i < ILI9341_PALETTE_MAX; i++){
+		palette[i] = palette[image->palette_size - 1];
+	}
+	/* Packets are decoded straight into the rows of the window (DMA buffers or framebuffer) */
+	WindowBegin(x, y, x + image->width - 1, y + image->height - 1);
+	for (uint16_t i = 0; i < image->height; i++){
+		uint16_t *dst = (uint16_t *)WindowRow();
+		uint16_t pixels = image->width;
+		while (pixels > 0){
+			if (run == 0){
+				if (src >= end){
+					/* Packets ended before the last pixel: the rest is drawn with the first color */
+					literal = false;
+					index = 0;
+					run = UINT8_MAX;
+				} else{
+					uint8_t header = *src++;
+					literal = !(header & IMAGE_RUN);
+					run = (header & IMAGE_LEN_MSK) + 1;
+					if (literal){
+						/* A literal packet can't read past the end of data */
+						if (run > end - src){
+							run = end - src;
+						}
+					} else{
+						index = (src < end) ? *src++ : 0;
+					}
+				}
+			}
+			uint8_t n = (run < pixels) ? run : pixels;
+			if (literal){
+				for (uint8_t j = 0; j < n; j++){
+					*dst++ = palette[*src++];
+				}
+			} else{
+				uint16_t color = palette[index];
+				for (uint8_t j = 0; j < n; j++){
+					*dst++ = color;
+				}
+			}
+			run -= n;
+			pixels -= n;
+		}
+		WindowRowDone();
+	}
+	WindowEnd();
+}
 
-	/* Start writing LCD memory */
-	lcd_cmd_t lcd_write = {MEM_WRITE, NULL, NULL};
-	WriteLCD(&lcd_write);
+bool ILI9341FramebufferInit(uint16_t y0, uint16_t rows){
+	ILI9341FramebufferDeInit();
+	if ((rows == 0) || (y0 + rows > lcd_orientation.height)){
+		return false;
+	}
+	fb = heap_caps_malloc(lcd_orientation.width * rows * 2, MALLOC_CAP_DMA);
+	if (fb == NULL){
+		return false;
+	}
+	fb_width = lcd_orientation.width;
+	fb_y0 = y0;
+	fb_rows = rows;
+	fb_dirty_qty = 0;
+	return true;
+}
 
-	j = 0;
-	while(bytes_count - MAX_VALUE_SIZE > 0){
-		for (i = 0; i < MAX_VALUE_SIZE; i++){
-			pixel[i] = pic[j * MAX_VALUE_SIZE + i];
+void ILI9341FramebufferDeInit(void){
+	if (fb != NULL){
+		/* Flush could be still reading it */
+		LCDWait(lcd_queued);
+		heap_caps_free(fb);
+		fb = NULL;
+	}
+	fb_dirty_qty = 0;
+}
+
+uint32_t ILI9341Flush(void){
+	uint32_t bytes = 0;
+	lcd_buffer_t *buf;
+
+	for (uint8_t i = 0; i < fb_dirty_qty; i++){
+		ili9341_rect_t *r = &fb_dirty[i];
+		uint16_t row_bytes = (r->x1 - r->x0 + 1) * 2;
+		uint32_t pos = 0;
+
+		SetCursorPosition(r->x0, r->y0, r->x1, r->y1);
+		LCDQueue(false, (uint8_t[]){MEM_WRITE}, 1);
+		if (row_bytes == fb_width * 2){
+			/* Full rows are contiguous in memory: DMA straight from the framebuffer */
+			uint8_t *src = &fb[(r->y0 - fb_y0) * row_bytes];
+			int32_t bytes_count = (r->y1 - r->y0 + 1) * row_bytes;
+			while (bytes_count > 0){
+				uint32_t len = (bytes_count > LCD_CHUNK) ? LCD_CHUNK : bytes_count;
+				LCDQueue(true, src, len);
+				src += len;
+				bytes_count -= len;
+			}
+		} else{
+			/* Rows are packed in DMA buffers */
+			buf = LCDGetBuffer();
+			for (uint16_t y = r->y0; y <= r->y1; y++){
+				if (pos + row_bytes > LCD_CHUNK){
+					LCDSendBuffer(buf, pos);
+					buf = LCDGetBuffer();
+					pos = 0;
+				}
+				memcpy(&buf->data[pos], &fb[((y - fb_y0) * fb_width + r->x0) * 2], row_bytes);
+				pos += row_bytes;
+			}
+			LCDSendBuffer(buf, pos);
 		}
-		lcd_cmd_t lcd_pixel = {NULL, MAX_VALUE_SIZE, pixel};
-		WriteLCD(&lcd_pixel);
-		bytes_count -= MAX_VALUE_SIZE;
-		j++;
+		bytes += (uint32_t)row_bytes * (r->y1 - r->y0 + 1);
+	}
+	fb_dirty_qty = 0;
+	return bytes;
+}
+
+bool ILI9341TraceInit(const ili9341_trace_config_t *config){
+	uint16_t tfa, bfa;
+	uint32_t range;
+
+	if (((lcd_orientation.orientation != ILI9341_Landscape_1) && (lcd_orientation.orientation != ILI9341_Landscape_2)) ||
+		(config->width == 0) || (config->x + config->width > ILI9341_HEIGHT) ||
+		(config->height < 2) || (config->y + config->height > ILI9341_WIDTH) ||
+		(config->traces == 0) || (config->traces > ILI9341_TRACES_MAX) ||
+		(config->max <= config->min) || (config->decimation == 0)){
+		return false;
 	}
-	for (i = 0; i < bytes_count; i++){
-		pixel[i] = pic[j * MAX_VALUE_SIZE + i];
+	trace.cfg = *config;
+	trace.pos = 0;
+	trace.count = 0;
+	trace.columns = 0;
+	trace.has_last = false;
+	/* Q32 and 64 bits: any int32_t range keeps a non-zero scale, and min lands on the last row */
+	range = (uint32_t)config->max - (uint32_t)config->min;
+	trace.scale = (((uint64_t)(config->height - 1) << 32) + range - 1) / range;
+	/* Empty columns: background, horizontal grid lines from the bottom, and vertical grid line */
+	for (uint16_t r = 0; r < config->height; r++){
+		bool grid = (config->grid_y != 0) && (((config->height - 1 - r) % config->grid_y) == 0);
+		FillRow(&trace_column[0][r * 2], 1, grid ? config->grid_color : config->background);
+		FillRow(&trace_column[1][r * 2], 1, config->grid_x ? config->grid_color : config->background);
+	}
+
+	/* Scrolling area: frame memory lines of the plot columns */
+	if (lcd_orientation.orientation == ILI9341_Landscape_1){
+		tfa = config->x;
+		bfa = ILI9341_HEIGHT - config->x - config->width;
+	} else{
+		tfa = ILI9341_HEIGHT - config->x - config->width;
+		bfa = config->x;
+	}
+	uint8_t scroll_def[] = {HighByte(tfa), LowByte(tfa), HighByte(config->width), LowByte(config->width), HighByte(bfa), LowByte(bfa)};
+	lcd_cmd_t lcd_scroll_def = {VERT_SCROLL_DEF, sizeof(scroll_def), scroll_def};
+	WriteLCD(&lcd_scroll_def);
+	for (uint16_t i = 0; i < config->width; i++){
+		TraceColumn(false);
+	}
+	TraceShow();
+	trace.active = true;
+	return true;
+}
+
+void ILI9341TraceAdd(const int32_t *values){
+	if (!trace.active){
+		return;
+	}
+	for (uint8_t t = 0; t < trace.cfg.traces; t++){
+		int32_t value = values[t];
+		uint16_t row;
+		if (value > trace.cfg.max){
+			value = trace.cfg.max;
+		} else if (value < trace.cfg.min){
+			value = trace.cfg.min;
+		}
+		row = ((uint64_t)((uint32_t)trace.cfg.max - (uint32_t)value) * trace.scale) >> 32;
+		if ((trace.count == 0) || (row < trace.row_min[t])){
+			trace.row_min[t] = row;
+		}
+		if ((trace.count == 0) || (row > trace.row_max[t])){
+			trace.row_max[t] = row;
+		}
+		trace.row_end[t] = row;
+	}
+	if (++trace.count == trace.cfg.decimation){
+		TraceColumn(true);
+		TraceShow();
+		memcpy(trace.row_last, trace.row_end, sizeof(trace.row_last));
+		trace.has_last = true;
+		trace.count = 0;
+	}
+}
+
+void ILI9341TraceStop(void){
+	if (trace.active){
+		trace.active = false;
+		lcd_cmd_t lcd_normal = {NORMAL_MODE_ON, 0, NULL};
+		WriteLCD(&lcd_normal);
+	}
+}
+
+void ILI9341GlyphCacheClear(void){
+	for (uint8_t i = 0; i < ILI9341_GLYPH_CACHE_SIZE; i++){
+		if (glyph_cache[i].font != NULL){
+			GlyphFree(&glyph_cache[i]);
+		}
 	}
-	lcd_cmd_t lcd_pixel = {NULL, bytes_count, pixel};
-	WriteLCD(&lcd_pixel);
 }
 
 uint8_t ILI9341DeInit(void){
+	ILI9341GlyphCacheClear();
+	if (lcd_spi != NULL){
+		LCDWait(lcd_queued);
+		spi_bus_remove_device(lcd_spi);
+		lcd_spi = NULL;
+	}
 	return 0;
 }
 
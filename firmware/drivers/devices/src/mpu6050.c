@@ -15,42 +15,214 @@
 #include <string.h>
 /*==================[macros and definitions]=================================*/
 #define I2C_NUM I2C_NUM_0
+#define SHADOW_SIZE			(MPU6050_RA_DMP_CFG_2 + 1)	/*!< Registers 0x00 to 0x71 */
+#define SHADOW_BIT(map, reg)	((map)[(reg) >> 3] & (1 << ((reg) & 7)))
+#define SHADOW_SET(map, reg)	((map)[(reg) >> 3] |= (1 << ((reg) & 7)))
+#define SHADOW_CLR(map, reg)	((map)[(reg) >> 3] &= ~(1 << ((reg) & 7)))
+#define USERCTRL_RESET_MSK	((1 << MPU6050_USERCTRL_DMP_RESET_BIT) | (1 << MPU6050_USERCTRL_FIFO_RESET_BIT) | \
+							 (1 << MPU6050_USERCTRL_I2C_MST_RESET_BIT) | (1 << MPU6050_USERCTRL_SIG_COND_RESET_BIT))
+#define PWR1_RESET_MSK		(1 << MPU6050_PWR1_DEVICE_RESET_BIT)
 
 /*==================[internal data definition]===============================*/
-uint8_t devAddr;
+uint8_t devAddr = MPU6050_DEFAULT_ADDRESS;
 uint8_t buffer[14];
-/*==================[internal functions declaration]=========================*/
 
-/*==================[external functions definition]==========================*/
-void MPU6050_ReadRegister(uint8_t reg, uint8_t *data, uint8_t len){
-	uint8_t dev = 0x68;
-	i2c_cmd_handle_t cmd;
-	I2C_SelectRegister(dev, reg);
-
-	cmd = i2c_cmd_link_create();
-	ESP_ERROR_CHECK(i2c_master_start(cmd));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (dev << 1) | I2C_MASTER_READ, 1));
+/**
+ * @brief Configuration registers kept in the shadow (status, data, FIFO and DMP 
+ * memory registers are always read from the device, and so are I2C_SLV4_CTRL 
+ * and SIGNAL_PATH_RESET, whose bits clear themselves)
+ */
+static const struct {
+	uint8_t first;
+	uint8_t count;
+} shadow_ranges[] = {
+	{MPU6050_RA_XG_OFFS_TC, MPU6050_RA_I2C_SLV4_CTRL - MPU6050_RA_XG_OFFS_TC},
+	{MPU6050_RA_INT_PIN_CFG, 2},
+	{MPU6050_RA_I2C_SLV0_DO, MPU6050_RA_SIGNAL_PATH_RESET - MPU6050_RA_I2C_SLV0_DO},
+	{MPU6050_RA_MOT_DETECT_CTRL, MPU6050_RA_BANK_SEL - MPU6050_RA_MOT_DETECT_CTRL},
+	{MPU6050_RA_DMP_CFG_1, 2},
+};
+static uint8_t shadow[SHADOW_SIZE];					/*!< Last value written to (or read from) each register */
+static uint8_t shadow_valid[(SHADOW_SIZE + 7) / 8];	/*!< Registers whose shadow holds the device value */
+static uint8_t shadow_dirty[(SHADOW_SIZE + 7) / 8];	/*!< Registers written to the shadow only */
+static bool shadow_defer = false;					/*!< Writes are kept until MPU6050_shadowFlush() */
+/*==================[internal functions declaration]=========================*/
 
-	if(len>1)
-		ESP_ERROR_CHECK(i2c_master_read(cmd, data, len, I2C_MASTER_ACK));
+/*==================[internal functions definition]==========================*/
+static bool MPU6050_ShadowCached(uint8_t reg){
+	for(uint8_t i = 0; i < sizeof(shadow_ranges) / sizeof(shadow_ranges[0]); i++){
+		if((reg >= shadow_ranges[i].first) && (reg < shadow_ranges[i].first + shadow_ranges[i].count)){
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Register read, served from the shadow for configuration registers.
+ * Same parameters and return as I2C_readByte().
+ */
+static int8_t MPU6050_ReadByte(uint8_t regAddr, uint8_t *data, uint16_t timeout){
+	if(!MPU6050_ShadowCached(regAddr)){
+		return I2C_readByte(devAddr, regAddr, data, timeout);
+	}
+	if(!SHADOW_BIT(shadow_valid, regAddr)){
+		if(I2C_readByte(devAddr, regAddr, &shadow[regAddr], timeout) == 0){
+			return 0;
+		}
+		SHADOW_SET(shadow_valid, regAddr);
+	}
+	*data = shadow[regAddr];
+	return 1;
+}
+
+/** Same as I2C_readBit(), through MPU6050_ReadByte().
+ */
+static int8_t MPU6050_ReadBit(uint8_t regAddr, uint8_t bitNum, uint8_t *data, uint16_t timeout){
+	uint8_t b;
+	int8_t count;
+	if((count = MPU6050_ReadByte(regAddr, &b, timeout)) != 0){
+		*data = b & (1 << bitNum);
+	}
+	return count;
+}
+
+/** Same as I2C_readBits(), through MPU6050_ReadByte().
+ */
+static int8_t MPU6050_ReadBits(uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data, uint16_t timeout){
+	uint8_t b;
+	int8_t count;
+	if((count = MPU6050_ReadByte(regAddr, &b, timeout)) != 0){
+		uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
+		*data = (b & mask) >> (bitStart - length + 1);
+	}
+	return count;
+}
+
+/** Register write. Configuration registers are stored in the shadow, and 
+ * kept there (until MPU6050_shadowFlush()) while writes are deferred.
+ */
+static bool MPU6050_WriteByte(uint8_t regAddr, uint8_t data){
+	bool ok;
+	bool reset = ((regAddr == MPU6050_RA_USER_CTRL) && (data & USERCTRL_RESET_MSK)) ||
+				 ((regAddr == MPU6050_RA_PWR_MGMT_1) && (data & PWR1_RESET_MSK));
+
+	if(!MPU6050_ShadowCached(regAddr)){
+		return I2C_writeByte(devAddr, regAddr, data);
+	}
+	shadow[regAddr] = data;
+	SHADOW_SET(shadow_valid, regAddr);
+	if(shadow_defer && !reset){
+		SHADOW_SET(shadow_dirty, regAddr);
+		return true;
+	}
+	/* Resets act at once: previous writes go first */
+	SHADOW_CLR(shadow_dirty, regAddr);
+	MPU6050_shadowFlush();
+	ok = I2C_writeByte(devAddr, regAddr, data);
+	if(!ok){
+		SHADOW_CLR(shadow_valid, regAddr);
+	} else if(regAddr == MPU6050_RA_USER_CTRL){
+		/* Reset bits clear themselves */
+		shadow[regAddr] &= ~USERCTRL_RESET_MSK;
+	} else if(reset){
+		/* Device reset: every register goes back to its default value */
+		MPU6050_shadowInvalidate();
+	}
+	return ok;
+}
+
+/** Same as I2C_writeBit(), through the shadow.
+ */
+static bool MPU6050_WriteBit(uint8_t regAddr, uint8_t bitNum, uint8_t data){
+	uint8_t b;
+	if(MPU6050_ReadByte(regAddr, &b, 0) == 0){
+		return false;
+	}
+	b = (data != 0) ? (b | (1 << bitNum)) : (b & ~(1 << bitNum));
+	return MPU6050_WriteByte(regAddr, b);
+}
+
+/** Same as I2C_writeBits(), through the shadow.
+ */
+static bool MPU6050_WriteBits(uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data){
+	uint8_t b = 0;
+	if(MPU6050_ReadByte(regAddr, &b, 0) != 0){
+		uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
+		data <<= (bitStart - length + 1);
+		data &= mask;
+		b &= ~(mask);
+		b |= data;
+		return MPU6050_WriteByte(regAddr, b);
+	} else {
+		return false;
+	}
+}
 
-	ESP_ERROR_CHECK(i2c_master_read_byte(cmd, data+len-1, I2C_MASTER_NACK));
+/*==================[external functions definition]==========================*/
+void MPU6050_shadowInvalidate(void){
+	memset(shadow_valid, 0, sizeof(shadow_valid));
+	memset(shadow_dirty, 0, sizeof(shadow_dirty));
+}
+
+void MPU6050_shadowSync(void){
+	MPU6050_shadowFlush();
+	for(uint8_t i = 0; i < sizeof(shadow_ranges) / sizeof(shadow_ranges[0]); i++){
+		uint8_t first = shadow_ranges[i].first;
+		if(I2C_readBytes(devAddr, first, shadow_ranges[i].count, &shadow[first], I2C_MASTER_TIMEOUT_MS) != 0){
+			for(uint8_t reg = first; reg < first + shadow_ranges[i].count; reg++){
+				SHADOW_SET(shadow_valid, reg);
+			}
+		}
+	}
+}
+
+void MPU6050_shadowDefer(bool defer){
+	shadow_defer = defer;
+	if(!defer){
+		MPU6050_shadowFlush();
+	}
+}
+
+void MPU6050_shadowFlush(void){
+	uint8_t reg = 0;
+	while(reg < SHADOW_SIZE){
+		if(!SHADOW_BIT(shadow_dirty, reg)){
+			reg++;
+			continue;
+		}
+		/* Adjacent dirty registers go in one burst (the register address auto increments) */
+		uint8_t first = reg;
+		while((reg < SHADOW_SIZE) && SHADOW_BIT(shadow_dirty, reg)){
+			SHADOW_CLR(shadow_dirty, reg);
+			reg++;
+		}
+		if(!I2C_writeBytes(devAddr, first, reg - first, &shadow[first])){
+			for(uint8_t r = first; r < reg; r++){
+				SHADOW_CLR(shadow_valid, r);
+			}
+		}
+	}
+}
 
-	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000));
-	i2c_cmd_link_delete(cmd);
+void MPU6050_ReadRegister(uint8_t reg, uint8_t *data, uint8_t len){
+	I2C_readBytes(devAddr, reg, len, data, I2C_MASTER_TIMEOUT_MS);
 }
 
 void MPU6050_Address(uint8_t address) {
     devAddr = address;
+    MPU6050_shadowInvalidate();
 }
 
 void MPU6050_initialize() {
 	devAddr = MPU6050_DEFAULT_ADDRESS;
+	MPU6050_shadowInvalidate();
+	/* GYRO_CONFIG and ACCEL_CONFIG are written in one burst, PWR_MGMT_1 once */
+	MPU6050_shadowDefer(true);
     MPU6050_setClockSource(MPU6050_CLOCK_PLL_XGYRO);
     MPU6050_setFullScaleGyroRange(MPU6050_GYRO_FS_250);
     MPU6050_setFullScaleAccelRange(MPU6050_ACCEL_FS_2);
     MPU6050_setSleepEnabled(false); // thanks to Jack Elston for pointing this one out!
+	MPU6050_shadowDefer(false);
 }
 
 /** Verify the I2C connection.
@@ -69,7 +241,7 @@ bool MPU6050_testConnection() {
  * @return I2C supply voltage level (0=VLOGIC, 1=VDD)
  */
 uint8_t MPU6050_getAuxVDDIOLevel() {
-    I2C_readBit(devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the auxiliary I2C supply voltage level.
@@ -79,7 +251,7 @@ uint8_t MPU6050_getAuxVDDIOLevel() {
  * @param level I2C supply voltage level (0=VLOGIC, 1=VDD)
  */
 void MPU6050_setAuxVDDIOLevel(uint8_t level) {
-    I2C_writeBit(devAddr, MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, level);
+    MPU6050_WriteBit(MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT, level);
 }
 
 // SMPLRT_DIV register
@@ -105,7 +277,7 @@ void MPU6050_setAuxVDDIOLevel(uint8_t level) {
  * @see MPU6050_RA_SMPLRT_DIV
  */
 uint8_t MPU6050_getRate() {
-    I2C_readByte(devAddr, MPU6050_RA_SMPLRT_DIV, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_SMPLRT_DIV, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 
@@ -115,7 +287,7 @@ uint8_t MPU6050_getRate() {
  * @see MPU6050_RA_SMPLRT_DIV
  */
 void MPU6050_setRate(uint8_t rate) {
-    I2C_writeByte(devAddr, MPU6050_RA_SMPLRT_DIV, rate);
+    MPU6050_WriteByte(MPU6050_RA_SMPLRT_DIV, rate);
 }
 
 // CONFIG register
@@ -147,7 +319,7 @@ void MPU6050_setRate(uint8_t rate) {
  * @return FSYNC configuration value
  */
 uint8_t MPU6050_getExternalFrameSync() {
-    I2C_readBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 
@@ -157,7 +329,7 @@ uint8_t MPU6050_getExternalFrameSync() {
  * @param sync New FSYNC configuration value
  */
 void MPU6050_setExternalFrameSync(uint8_t sync) {
-    I2C_writeBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, sync);
+    MPU6050_WriteBits(MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH, sync);
 }
 /** Get digital low-pass filter configuration.
  * The DLPF_CFG parameter sets the digital low pass filter configuration. It
@@ -188,7 +360,7 @@ void MPU6050_setExternalFrameSync(uint8_t sync) {
  * @see MPU6050_CFG_DLPF_CFG_LENGTH
  */
 uint8_t MPU6050_getDLPFMode() {
-    I2C_readBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set digital low-pass filter configuration.
@@ -200,7 +372,7 @@ uint8_t MPU6050_getDLPFMode() {
  * @see MPU6050_CFG_DLPF_CFG_LENGTH
  */
 void MPU6050_setDLPFMode(uint8_t mode) {
-    I2C_writeBits(devAddr, MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mode);
+    MPU6050_WriteBits(MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH, mode);
 }
 
 // GYRO_CONFIG register
@@ -223,7 +395,7 @@ void MPU6050_setDLPFMode(uint8_t mode) {
  * @see MPU6050_GCONFIG_FS_SEL_LENGTH
  */
 uint8_t MPU6050_getFullScaleGyroRange() {
-    I2C_readBits(devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set full-scale gyroscope range.
@@ -235,7 +407,7 @@ uint8_t MPU6050_getFullScaleGyroRange() {
  * @see MPU6050_GCONFIG_FS_SEL_LENGTH
  */
 void MPU6050_setFullScaleGyroRange(uint8_t range) {
-    I2C_writeBits(devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
+    MPU6050_WriteBits(MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
 }
 
 // SELF TEST FACTORY TRIM VALUES
@@ -245,8 +417,8 @@ void MPU6050_setFullScaleGyroRange(uint8_t range) {
  * @see MPU6050_RA_SELF_TEST_X
  */
 uint8_t MPU6050_getAccelXSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_X, &buffer[0], I2C_MASTER_TIMEOUT_MS);
-	I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_A, &buffer[1], I2C_MASTER_TIMEOUT_MS);	
+    MPU6050_ReadByte(MPU6050_RA_SELF_TEST_X, &buffer[0], I2C_MASTER_TIMEOUT_MS);
+	MPU6050_ReadByte(MPU6050_RA_SELF_TEST_A, &buffer[1], I2C_MASTER_TIMEOUT_MS);	
     return (buffer[0]>>3) | ((buffer[1]>>4) & 0x03);
 }
 
@@ -255,8 +427,8 @@ uint8_t MPU6050_getAccelXSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_Y
  */
 uint8_t MPU6050_getAccelYSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_Y, &buffer[0], I2C_MASTER_TIMEOUT_MS);
-	I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_A, &buffer[1], I2C_MASTER_TIMEOUT_MS);	
+    MPU6050_ReadByte(MPU6050_RA_SELF_TEST_Y, &buffer[0], I2C_MASTER_TIMEOUT_MS);
+	MPU6050_ReadByte(MPU6050_RA_SELF_TEST_A, &buffer[1], I2C_MASTER_TIMEOUT_MS);	
     return (buffer[0]>>3) | ((buffer[1]>>2) & 0x03);
 }
 
@@ -274,7 +446,7 @@ uint8_t MPU6050_getAccelZSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_X
  */
 uint8_t MPU6050_getGyroXSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_X, buffer, I2C_MASTER_TIMEOUT_MS);	
+    MPU6050_ReadByte(MPU6050_RA_SELF_TEST_X, buffer, I2C_MASTER_TIMEOUT_MS);	
     return (buffer[0] & 0x1F);
 }
 
@@ -283,7 +455,7 @@ uint8_t MPU6050_getGyroXSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_Y
  */
 uint8_t MPU6050_getGyroYSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_Y, buffer, I2C_MASTER_TIMEOUT_MS);	
+    MPU6050_ReadByte(MPU6050_RA_SELF_TEST_Y, buffer, I2C_MASTER_TIMEOUT_MS);	
     return (buffer[0] & 0x1F);
 }
 
@@ -292,7 +464,7 @@ uint8_t MPU6050_getGyroYSelfTestFactoryTrim() {
  * @see MPU6050_RA_SELF_TEST_Z
  */
 uint8_t MPU6050_getGyroZSelfTestFactoryTrim() {
-    I2C_readByte(devAddr, MPU6050_RA_SELF_TEST_Z, buffer, I2C_MASTER_TIMEOUT_MS);	
+    MPU6050_ReadByte(MPU6050_RA_SELF_TEST_Z, buffer, I2C_MASTER_TIMEOUT_MS);	
     return (buffer[0] & 0x1F);
 }
 
@@ -303,7 +475,7 @@ uint8_t MPU6050_getGyroZSelfTestFactoryTrim() {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 bool MPU6050_getAccelXSelfTest() {
-    I2C_readBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get self-test enabled setting for accelerometer X axis.
@@ -311,14 +483,14 @@ bool MPU6050_getAccelXSelfTest() {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setAccelXSelfTest(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT, enabled);
 }
 /** Get self-test enabled value for accelerometer Y axis.
  * @return Self-test enabled value
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 bool MPU6050_getAccelYSelfTest() {
-    I2C_readBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get self-test enabled value for accelerometer Y axis.
@@ -326,14 +498,14 @@ bool MPU6050_getAccelYSelfTest() {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setAccelYSelfTest(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT, enabled);
 }
 /** Get self-test enabled value for accelerometer Z axis.
  * @return Self-test enabled value
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 bool MPU6050_getAccelZSelfTest() {
-    I2C_readBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set self-test enabled value for accelerometer Z axis.
@@ -341,7 +513,7 @@ bool MPU6050_getAccelZSelfTest() {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setAccelZSelfTest(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT, enabled);
 }
 /** Get full-scale accelerometer range.
  * The FS_SEL parameter allows setting the full-scale range of the accelerometer
@@ -361,7 +533,7 @@ void MPU6050_setAccelZSelfTest(bool enabled) {
  * @see MPU6050_ACONFIG_AFS_SEL_LENGTH
  */
 uint8_t MPU6050_getFullScaleAccelRange() {
-    I2C_readBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set full-scale accelerometer range.
@@ -369,7 +541,7 @@ uint8_t MPU6050_getFullScaleAccelRange() {
  * @see getFullScaleAccelRange()
  */
 void MPU6050_setFullScaleAccelRange(uint8_t range) {
-    I2C_writeBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
+    MPU6050_WriteBits(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
 }
 /** Get the high-pass filter configuration.
  * The DHPF is a filter module in the path leading to motion detectors (Free
@@ -407,7 +579,7 @@ void MPU6050_setFullScaleAccelRange(uint8_t range) {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 uint8_t MPU6050_getDHPFMode() {
-    I2C_readBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the high-pass filter configuration.
@@ -417,7 +589,7 @@ uint8_t MPU6050_getDHPFMode() {
  * @see MPU6050_RA_ACCEL_CONFIG
  */
 void MPU6050_setDHPFMode(uint8_t bandwidth) {
-    I2C_writeBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, bandwidth);
+    MPU6050_WriteBits(MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH, bandwidth);
 }
 
 // FF_THR register
@@ -438,7 +610,7 @@ void MPU6050_setDHPFMode(uint8_t bandwidth) {
  * @see MPU6050_RA_FF_THR
  */
 uint8_t MPU6050_getFreefallDetectionThreshold() {
-    I2C_readByte(devAddr, MPU6050_RA_FF_THR, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_FF_THR, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get free-fall event acceleration threshold.
@@ -447,7 +619,7 @@ uint8_t MPU6050_getFreefallDetectionThreshold() {
  * @see MPU6050_RA_FF_THR
  */
 void MPU6050_setFreefallDetectionThreshold(uint8_t threshold) {
-    I2C_writeByte(devAddr, MPU6050_RA_FF_THR, threshold);
+    MPU6050_WriteByte(MPU6050_RA_FF_THR, threshold);
 }
 
 // FF_DUR register
@@ -470,7 +642,7 @@ void MPU6050_setFreefallDetectionThreshold(uint8_t threshold) {
  * @see MPU6050_RA_FF_DUR
  */
 uint8_t MPU6050_getFreefallDetectionDuration() {
-    I2C_readByte(devAddr, MPU6050_RA_FF_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_FF_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get free-fall event duration threshold.
@@ -479,7 +651,7 @@ uint8_t MPU6050_getFreefallDetectionDuration() {
  * @see MPU6050_RA_FF_DUR
  */
 void MPU6050_setFreefallDetectionDuration(uint8_t duration) {
-    I2C_writeByte(devAddr, MPU6050_RA_FF_DUR, duration);
+    MPU6050_WriteByte(MPU6050_RA_FF_DUR, duration);
 }
 
 // MOT_THR register
@@ -504,7 +676,7 @@ void MPU6050_setFreefallDetectionDuration(uint8_t duration) {
  * @see MPU6050_RA_MOT_THR
  */
 uint8_t MPU6050_getMotionDetectionThreshold() {
-    I2C_readByte(devAddr, MPU6050_RA_MOT_THR, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_MOT_THR, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set motion detection event acceleration threshold.
@@ -513,7 +685,7 @@ uint8_t MPU6050_getMotionDetectionThreshold() {
  * @see MPU6050_RA_MOT_THR
  */
 void MPU6050_setMotionDetectionThreshold(uint8_t threshold) {
-    I2C_writeByte(devAddr, MPU6050_RA_MOT_THR, threshold);
+    MPU6050_WriteByte(MPU6050_RA_MOT_THR, threshold);
 }
 
 // MOT_DUR register
@@ -534,7 +706,7 @@ void MPU6050_setMotionDetectionThreshold(uint8_t threshold) {
  * @see MPU6050_RA_MOT_DUR
  */
 uint8_t MPU6050_getMotionDetectionDuration() {
-    I2C_readByte(devAddr, MPU6050_RA_MOT_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_MOT_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set motion detection event duration threshold.
@@ -543,7 +715,7 @@ uint8_t MPU6050_getMotionDetectionDuration() {
  * @see MPU6050_RA_MOT_DUR
  */
 void MPU6050_setMotionDetectionDuration(uint8_t duration) {
-    I2C_writeByte(devAddr, MPU6050_RA_MOT_DUR, duration);
+    MPU6050_WriteByte(MPU6050_RA_MOT_DUR, duration);
 }
 
 // ZRMOT_THR register
@@ -574,7 +746,7 @@ void MPU6050_setMotionDetectionDuration(uint8_t duration) {
  * @see MPU6050_RA_ZRMOT_THR
  */
 uint8_t MPU6050_getZeroMotionDetectionThreshold() {
-    I2C_readByte(devAddr, MPU6050_RA_ZRMOT_THR, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_ZRMOT_THR, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set zero motion detection event acceleration threshold.
@@ -583,7 +755,7 @@ uint8_t MPU6050_getZeroMotionDetectionThreshold() {
  * @see MPU6050_RA_ZRMOT_THR
  */
 void MPU6050_setZeroMotionDetectionThreshold(uint8_t threshold) {
-    I2C_writeByte(devAddr, MPU6050_RA_ZRMOT_THR, threshold);
+    MPU6050_WriteByte(MPU6050_RA_ZRMOT_THR, threshold);
 }
 
 // ZRMOT_DUR register
@@ -605,7 +777,7 @@ void MPU6050_setZeroMotionDetectionThreshold(uint8_t threshold) {
  * @see MPU6050_RA_ZRMOT_DUR
  */
 uint8_t MPU6050_getZeroMotionDetectionDuration() {
-    I2C_readByte(devAddr, MPU6050_RA_ZRMOT_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_ZRMOT_DUR, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set zero motion detection event duration threshold.
@@ -614,7 +786,7 @@ uint8_t MPU6050_getZeroMotionDetectionDuration() {
  * @see MPU6050_RA_ZRMOT_DUR
  */
 void MPU6050_setZeroMotionDetectionDuration(uint8_t duration) {
-    I2C_writeByte(devAddr, MPU6050_RA_ZRMOT_DUR, duration);
+    MPU6050_WriteByte(MPU6050_RA_ZRMOT_DUR, duration);
 }
 
 // FIFO_EN register
@@ -626,7 +798,7 @@ void MPU6050_setZeroMotionDetectionDuration(uint8_t duration) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getTempFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set temperature FIFO enabled value.
@@ -635,7 +807,7 @@ bool MPU6050_getTempFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setTempFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope X-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_XOUT_H and GYRO_XOUT_L (Registers 67 and
@@ -644,7 +816,7 @@ void MPU6050_setTempFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getXGyroFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set gyroscope X-axis FIFO enabled value.
@@ -653,7 +825,7 @@ bool MPU6050_getXGyroFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setXGyroFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope Y-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_YOUT_H and GYRO_YOUT_L (Registers 69 and
@@ -662,7 +834,7 @@ void MPU6050_setXGyroFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getYGyroFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set gyroscope Y-axis FIFO enabled value.
@@ -671,7 +843,7 @@ bool MPU6050_getYGyroFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setYGyroFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT, enabled);
 }
 /** Get gyroscope Z-axis FIFO enabled value.
  * When set to 1, this bit enables GYRO_ZOUT_H and GYRO_ZOUT_L (Registers 71 and
@@ -680,7 +852,7 @@ void MPU6050_setYGyroFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getZGyroFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set gyroscope Z-axis FIFO enabled value.
@@ -689,7 +861,7 @@ bool MPU6050_getZGyroFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setZGyroFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT, enabled);
 }
 /** Get accelerometer FIFO enabled value.
  * When set to 1, this bit enables ACCEL_XOUT_H, ACCEL_XOUT_L, ACCEL_YOUT_H,
@@ -699,7 +871,7 @@ void MPU6050_setZGyroFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getAccelFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set accelerometer FIFO enabled value.
@@ -708,7 +880,7 @@ bool MPU6050_getAccelFIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setAccelFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 2 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -717,7 +889,7 @@ void MPU6050_setAccelFIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getSlave2FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Slave 2 FIFO enabled value.
@@ -726,7 +898,7 @@ bool MPU6050_getSlave2FIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setSlave2FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 1 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -735,7 +907,7 @@ void MPU6050_setSlave2FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getSlave1FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Slave 1 FIFO enabled value.
@@ -744,7 +916,7 @@ bool MPU6050_getSlave1FIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setSlave1FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT, enabled);
 }
 /** Get Slave 0 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -753,7 +925,7 @@ void MPU6050_setSlave1FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_FIFO_EN
  */
 bool MPU6050_getSlave0FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Slave 0 FIFO enabled value.
@@ -762,7 +934,7 @@ bool MPU6050_getSlave0FIFOEnabled() {
  * @see MPU6050_RA_FIFO_EN
  */
 void MPU6050_setSlave0FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT, enabled);
 }
 
 // I2C_MST_CTRL register
@@ -783,7 +955,7 @@ void MPU6050_setSlave0FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 bool MPU6050_getMultiMasterEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set multi-master enabled value.
@@ -792,7 +964,7 @@ bool MPU6050_getMultiMasterEnabled() {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setMultiMasterEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT, enabled);
 }
 /** Get wait-for-external-sensor-data enabled value.
  * When the WAIT_FOR_ES bit is set to 1, the Data Ready interrupt will be
@@ -806,7 +978,7 @@ void MPU6050_setMultiMasterEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 bool MPU6050_getWaitForExternalSensorEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set wait-for-external-sensor-data enabled value.
@@ -815,7 +987,7 @@ bool MPU6050_getWaitForExternalSensorEnabled() {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setWaitForExternalSensorEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT, enabled);
 }
 /** Get Slave 3 FIFO enabled value.
  * When set to 1, this bit enables EXT_SENS_DATA registers (Registers 73 to 96)
@@ -824,7 +996,7 @@ void MPU6050_setWaitForExternalSensorEnabled(bool enabled) {
  * @see MPU6050_RA_MST_CTRL
  */
 bool MPU6050_getSlave3FIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Slave 3 FIFO enabled value.
@@ -833,7 +1005,7 @@ bool MPU6050_getSlave3FIFOEnabled() {
  * @see MPU6050_RA_MST_CTRL
  */
 void MPU6050_setSlave3FIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT, enabled);
 }
 /** Get slave read/write transition enabled value.
  * The I2C_MST_P_NSR bit configures the I2C Master's transition from one slave
@@ -846,7 +1018,7 @@ void MPU6050_setSlave3FIFOEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 bool MPU6050_getSlaveReadWriteTransitionEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set slave read/write transition enabled value.
@@ -855,7 +1027,7 @@ bool MPU6050_getSlaveReadWriteTransitionEnabled() {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setSlaveReadWriteTransitionEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT, enabled);
 }
 /** Get I2C master clock speed.
  * I2C_MST_CLK is a 4 bit unsigned value which configures a divider on the
@@ -887,7 +1059,7 @@ void MPU6050_setSlaveReadWriteTransitionEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 uint8_t MPU6050_getMasterClockSpeed() {
-    I2C_readBits(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set I2C master clock speed.
@@ -895,7 +1067,7 @@ uint8_t MPU6050_getMasterClockSpeed() {
  * @see MPU6050_RA_I2C_MST_CTRL
  */
 void MPU6050_setMasterClockSpeed(uint8_t speed) {
-    I2C_writeBits(devAddr, MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, speed);
+    MPU6050_WriteBits(MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH, speed);
 }
 
 // I2C_SLV* registers (Slave 0-3)
@@ -943,7 +1115,7 @@ void MPU6050_setMasterClockSpeed(uint8_t speed) {
  */
 uint8_t MPU6050_getSlaveAddress(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV0_ADDR + num*3, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_I2C_SLV0_ADDR + num*3, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the I2C address of the specified slave (0-3).
@@ -954,7 +1126,7 @@ uint8_t MPU6050_getSlaveAddress(uint8_t num) {
  */
 void MPU6050_setSlaveAddress(uint8_t num, uint8_t address) {
     if (num > 3) return;
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV0_ADDR + num*3, address);
+    MPU6050_WriteByte(MPU6050_RA_I2C_SLV0_ADDR + num*3, address);
 }
 /** Get the active internal register for the specified slave (0-3).
  * Read/write operations for this slave will be done to whatever internal
@@ -969,7 +1141,7 @@ void MPU6050_setSlaveAddress(uint8_t num, uint8_t address) {
  */
 uint8_t MPU6050_getSlaveRegister(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV0_REG + num*3, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_I2C_SLV0_REG + num*3, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the active internal register for the specified slave (0-3).
@@ -980,7 +1152,7 @@ uint8_t MPU6050_getSlaveRegister(uint8_t num) {
  */
 void MPU6050_setSlaveRegister(uint8_t num, uint8_t reg) {
     if (num > 3) return;
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV0_REG + num*3, reg);
+    MPU6050_WriteByte(MPU6050_RA_I2C_SLV0_REG + num*3, reg);
 }
 /** Get the enabled value for the specified slave (0-3).
  * When set to 1, this bit enables Slave 0 for data transfer operations. When
@@ -991,7 +1163,7 @@ void MPU6050_setSlaveRegister(uint8_t num, uint8_t reg) {
  */
 bool MPU6050_getSlaveEnabled(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the enabled value for the specified slave (0-3).
@@ -1002,7 +1174,7 @@ bool MPU6050_getSlaveEnabled(uint8_t num) {
  */
 void MPU6050_setSlaveEnabled(uint8_t num, bool enabled) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_EN_BIT, enabled);
 }
 /** Get word pair byte-swapping enabled for the specified slave (0-3).
  * When set to 1, this bit enables byte swapping. When byte swapping is enabled,
@@ -1017,7 +1189,7 @@ void MPU6050_setSlaveEnabled(uint8_t num, bool enabled) {
  */
 bool MPU6050_getSlaveWordByteSwap(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set word pair byte-swapping enabled for the specified slave (0-3).
@@ -1028,7 +1200,7 @@ bool MPU6050_getSlaveWordByteSwap(uint8_t num) {
  */
 void MPU6050_setSlaveWordByteSwap(uint8_t num, bool enabled) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_BYTE_SW_BIT, enabled);
 }
 /** Get write mode for the specified slave (0-3).
  * When set to 1, the transaction will read or write data only. When cleared to
@@ -1042,7 +1214,7 @@ void MPU6050_setSlaveWordByteSwap(uint8_t num, bool enabled) {
  */
 bool MPU6050_getSlaveWriteMode(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set write mode for the specified slave (0-3).
@@ -1053,7 +1225,7 @@ bool MPU6050_getSlaveWriteMode(uint8_t num) {
  */
 void MPU6050_setSlaveWriteMode(uint8_t num, bool mode) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, mode);
+    MPU6050_WriteBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_REG_DIS_BIT, mode);
 }
 /** Get word pair grouping order offset for the specified slave (0-3).
  * This sets specifies the grouping order of word pairs received from registers.
@@ -1068,7 +1240,7 @@ void MPU6050_setSlaveWriteMode(uint8_t num, bool mode) {
  */
 bool MPU6050_getSlaveWordGroupOffset(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set word pair grouping order offset for the specified slave (0-3).
@@ -1079,7 +1251,7 @@ bool MPU6050_getSlaveWordGroupOffset(uint8_t num) {
  */
 void MPU6050_setSlaveWordGroupOffset(uint8_t num, bool enabled) {
     if (num > 3) return;
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_GRP_BIT, enabled);
 }
 /** Get number of bytes to read for the specified slave (0-3).
  * Specifies the number of bytes transferred to and from Slave 0. Clearing this
@@ -1090,7 +1262,7 @@ void MPU6050_setSlaveWordGroupOffset(uint8_t num, bool enabled) {
  */
 uint8_t MPU6050_getSlaveDataLength(uint8_t num) {
     if (num > 3) return 0;
-    I2C_readBits(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set number of bytes to read for the specified slave (0-3).
@@ -1101,7 +1273,7 @@ uint8_t MPU6050_getSlaveDataLength(uint8_t num) {
  */
 void MPU6050_setSlaveDataLength(uint8_t num, uint8_t length) {
     if (num > 3) return;
-    I2C_writeBits(devAddr, MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, length);
+    MPU6050_WriteBits(MPU6050_RA_I2C_SLV0_CTRL + num*3, MPU6050_I2C_SLV_LEN_BIT, MPU6050_I2C_SLV_LEN_LENGTH, length);
 }
 
 // I2C_SLV* registers (Slave 4)
@@ -1116,7 +1288,7 @@ void MPU6050_setSlaveDataLength(uint8_t num, uint8_t length) {
  * @see MPU6050_RA_I2C_SLV4_ADDR
  */
 uint8_t MPU6050_getSlave4Address() {
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV4_ADDR, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_I2C_SLV4_ADDR, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the I2C address of Slave 4.
@@ -1125,7 +1297,7 @@ uint8_t MPU6050_getSlave4Address() {
  * @see MPU6050_RA_I2C_SLV4_ADDR
  */
 void MPU6050_setSlave4Address(uint8_t address) {
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV4_ADDR, address);
+    MPU6050_WriteByte(MPU6050_RA_I2C_SLV4_ADDR, address);
 }
 /** Get the active internal register for the Slave 4.
  * Read/write operations for this slave will be done to whatever internal
@@ -1135,7 +1307,7 @@ void MPU6050_setSlave4Address(uint8_t address) {
  * @see MPU6050_RA_I2C_SLV4_REG
  */
 uint8_t MPU6050_getSlave4Register() {
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV4_REG, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_I2C_SLV4_REG, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the active internal register for Slave 4.
@@ -1144,7 +1316,7 @@ uint8_t MPU6050_getSlave4Register() {
  * @see MPU6050_RA_I2C_SLV4_REG
  */
 void MPU6050_setSlave4Register(uint8_t reg) {
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV4_REG, reg);
+    MPU6050_WriteByte(MPU6050_RA_I2C_SLV4_REG, reg);
 }
 /** Set new byte to write to Slave 4.
  * This register stores the data to be written into the Slave 4. If I2C_SLV4_RW
@@ -1153,7 +1325,7 @@ void MPU6050_setSlave4Register(uint8_t reg) {
  * @see MPU6050_RA_I2C_SLV4_DO
  */
 void MPU6050_setSlave4OutputByte(uint8_t data) {
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV4_DO, data);
+    MPU6050_WriteByte(MPU6050_RA_I2C_SLV4_DO, data);
 }
 /** Get the enabled value for the Slave 4.
  * When set to 1, this bit enables Slave 4 for data transfer operations. When
@@ -1162,7 +1334,7 @@ void MPU6050_setSlave4OutputByte(uint8_t data) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 bool MPU6050_getSlave4Enabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the enabled value for Slave 4.
@@ -1171,7 +1343,7 @@ bool MPU6050_getSlave4Enabled() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4Enabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT, enabled);
 }
 /** Get the enabled value for Slave 4 transaction interrupts.
  * When set to 1, this bit enables the generation of an interrupt signal upon
@@ -1183,7 +1355,7 @@ void MPU6050_setSlave4Enabled(bool enabled) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 bool MPU6050_getSlave4InterruptEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set the enabled value for Slave 4 transaction interrupts.
@@ -1192,7 +1364,7 @@ bool MPU6050_getSlave4InterruptEnabled() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4InterruptEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT, enabled);
 }
 /** Get write mode for Slave 4.
  * When set to 1, the transaction will read or write data only. When cleared to
@@ -1204,7 +1376,7 @@ void MPU6050_setSlave4InterruptEnabled(bool enabled) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 bool MPU6050_getSlave4WriteMode() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set write mode for the Slave 4.
@@ -1213,7 +1385,7 @@ bool MPU6050_getSlave4WriteMode() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4WriteMode(bool mode) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, mode);
+    MPU6050_WriteBit(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT, mode);
 }
 /** Get Slave 4 master delay value.
  * This configures the reduced access rate of I2C slaves relative to the Sample
@@ -1231,7 +1403,7 @@ void MPU6050_setSlave4WriteMode(bool mode) {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 uint8_t MPU6050_getSlave4MasterDelay() {
-    I2C_readBits(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Slave 4 master delay value.
@@ -1240,7 +1412,7 @@ uint8_t MPU6050_getSlave4MasterDelay() {
  * @see MPU6050_RA_I2C_SLV4_CTRL
  */
 void MPU6050_setSlave4MasterDelay(uint8_t delay) {
-    I2C_writeBits(devAddr, MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, delay);
+    MPU6050_WriteBits(MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH, delay);
 }
 /** Get last available byte read from Slave 4.
  * This register stores the data read from Slave 4. This field is populated
@@ -1249,7 +1421,7 @@ void MPU6050_setSlave4MasterDelay(uint8_t delay) {
  * @see MPU6050_RA_I2C_SLV4_DI
  */
 uint8_t MPU6050_getSlate4InputByte() {
-    I2C_readByte(devAddr, MPU6050_RA_I2C_SLV4_DI, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_I2C_SLV4_DI, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 
@@ -1265,7 +1437,7 @@ uint8_t MPU6050_getSlate4InputByte() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getPassthroughStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_PASS_THROUGH_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_PASS_THROUGH_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Slave 4 transaction done status.
@@ -1277,7 +1449,7 @@ bool MPU6050_getPassthroughStatus() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave4IsDone() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_DONE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_DONE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get master arbitration lost status.
@@ -1288,7 +1460,7 @@ bool MPU6050_getSlave4IsDone() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getLostArbitration() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_LOST_ARB_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_LOST_ARB_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Slave 4 NACK status.
@@ -1299,7 +1471,7 @@ bool MPU6050_getLostArbitration() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave4Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Slave 3 NACK status.
@@ -1310,7 +1482,7 @@ bool MPU6050_getSlave4Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave3Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV3_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV3_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Slave 2 NACK status.
@@ -1321,7 +1493,7 @@ bool MPU6050_getSlave3Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave2Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV2_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV2_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Slave 1 NACK status.
@@ -1332,7 +1504,7 @@ bool MPU6050_getSlave2Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave1Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV1_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV1_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Slave 0 NACK status.
@@ -1343,7 +1515,7 @@ bool MPU6050_getSlave1Nack() {
  * @see MPU6050_RA_I2C_MST_STATUS
  */
 bool MPU6050_getSlave0Nack() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV0_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV0_NACK_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 
@@ -1356,7 +1528,7 @@ bool MPU6050_getSlave0Nack() {
  * @see MPU6050_INTCFG_INT_LEVEL_BIT
  */
 bool MPU6050_getInterruptMode() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set interrupt logic level mode.
@@ -1366,7 +1538,7 @@ bool MPU6050_getInterruptMode() {
  * @see MPU6050_INTCFG_INT_LEVEL_BIT
  */
 void MPU6050_setInterruptMode(bool mode) {
-   I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, mode);
+   MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT, mode);
 }
 /** Get interrupt drive mode.
  * Will be set 0 for push-pull, 1 for open-drain.
@@ -1375,7 +1547,7 @@ void MPU6050_setInterruptMode(bool mode) {
  * @see MPU6050_INTCFG_INT_OPEN_BIT
  */
 bool MPU6050_getInterruptDrive() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set interrupt drive mode.
@@ -1385,7 +1557,7 @@ bool MPU6050_getInterruptDrive() {
  * @see MPU6050_INTCFG_INT_OPEN_BIT
  */
 void MPU6050_setInterruptDrive(bool drive) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, drive);
+    MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT, drive);
 }
 /** Get interrupt latch mode.
  * Will be set 0 for 50us-pulse, 1 for latch-until-int-cleared.
@@ -1394,7 +1566,7 @@ void MPU6050_setInterruptDrive(bool drive) {
  * @see MPU6050_INTCFG_LATCH_INT_EN_BIT
  */
 bool MPU6050_getInterruptLatch() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set interrupt latch mode.
@@ -1404,7 +1576,7 @@ bool MPU6050_getInterruptLatch() {
  * @see MPU6050_INTCFG_LATCH_INT_EN_BIT
  */
 void MPU6050_setInterruptLatch(bool latch) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, latch);
+    MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT, latch);
 }
 /** Get interrupt latch clear mode.
  * Will be set 0 for status-read-only, 1 for any-register-read.
@@ -1413,7 +1585,7 @@ void MPU6050_setInterruptLatch(bool latch) {
  * @see MPU6050_INTCFG_INT_RD_CLEAR_BIT
  */
 bool MPU6050_getInterruptLatchClear() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set interrupt latch clear mode.
@@ -1423,7 +1595,7 @@ bool MPU6050_getInterruptLatchClear() {
  * @see MPU6050_INTCFG_INT_RD_CLEAR_BIT
  */
 void MPU6050_setInterruptLatchClear(bool clear) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, clear);
+    MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT, clear);
 }
 /** Get FSYNC interrupt logic level mode.
  * @return Current FSYNC interrupt mode (0=active-high, 1=active-low)
@@ -1432,7 +1604,7 @@ void MPU6050_setInterruptLatchClear(bool clear) {
  * @see MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT
  */
 bool MPU6050_getFSyncInterruptLevel() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set FSYNC interrupt logic level mode.
@@ -1442,7 +1614,7 @@ bool MPU6050_getFSyncInterruptLevel() {
  * @see MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT
  */
 void MPU6050_setFSyncInterruptLevel(bool level) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, level);
+    MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT, level);
 }
 /** Get FSYNC pin interrupt enabled setting.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1451,7 +1623,7 @@ void MPU6050_setFSyncInterruptLevel(bool level) {
  * @see MPU6050_INTCFG_FSYNC_INT_EN_BIT
  */
 bool MPU6050_getFSyncInterruptEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set FSYNC pin interrupt enabled setting.
@@ -1461,7 +1633,7 @@ bool MPU6050_getFSyncInterruptEnabled() {
  * @see MPU6050_INTCFG_FSYNC_INT_EN_BIT
  */
 void MPU6050_setFSyncInterruptEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT, enabled);
 }
 /** Get I2C bypass enabled status.
  * When this bit is equal to 1 and I2C_MST_EN (Register 106 bit[5]) is equal to
@@ -1475,7 +1647,7 @@ void MPU6050_setFSyncInterruptEnabled(bool enabled) {
  * @see MPU6050_INTCFG_I2C_BYPASS_EN_BIT
  */
 bool MPU6050_getI2CBypassEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set I2C bypass enabled status.
@@ -1490,7 +1662,7 @@ bool MPU6050_getI2CBypassEnabled() {
  * @see MPU6050_INTCFG_I2C_BYPASS_EN_BIT
  */
 void MPU6050_setI2CBypassEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
 }
 /** Get reference clock output enabled status.
  * When this bit is equal to 1, a reference clock output is provided at the
@@ -1502,7 +1674,7 @@ void MPU6050_setI2CBypassEnabled(bool enabled) {
  * @see MPU6050_INTCFG_CLKOUT_EN_BIT
  */
 bool MPU6050_getClockOutputEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set reference clock output enabled status.
@@ -1515,7 +1687,7 @@ bool MPU6050_getClockOutputEnabled() {
  * @see MPU6050_INTCFG_CLKOUT_EN_BIT
  */
 void MPU6050_setClockOutputEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT, enabled);
 }
 
 // INT_ENABLE register
@@ -1528,7 +1700,7 @@ void MPU6050_setClockOutputEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 uint8_t MPU6050_getIntEnabled() {
-    I2C_readByte(devAddr, MPU6050_RA_INT_ENABLE, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_INT_ENABLE, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set full interrupt enabled status.
@@ -1540,7 +1712,7 @@ uint8_t MPU6050_getIntEnabled() {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 void MPU6050_setIntEnabled(uint8_t enabled) {
-    I2C_writeByte(devAddr, MPU6050_RA_INT_ENABLE, enabled);
+    MPU6050_WriteByte(MPU6050_RA_INT_ENABLE, enabled);
 }
 /** Get Free Fall interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1549,7 +1721,7 @@ void MPU6050_setIntEnabled(uint8_t enabled) {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 bool MPU6050_getIntFreefallEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Free Fall interrupt enabled status.
@@ -1559,7 +1731,7 @@ bool MPU6050_getIntFreefallEnabled() {
  * @see MPU6050_INTERRUPT_FF_BIT
  **/
 void MPU6050_setIntFreefallEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT, enabled);
 }
 /** Get Motion Detection interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1568,7 +1740,7 @@ void MPU6050_setIntFreefallEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_MOT_BIT
  **/
 bool MPU6050_getIntMotionEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Motion Detection interrupt enabled status.
@@ -1578,7 +1750,7 @@ bool MPU6050_getIntMotionEnabled() {
  * @see MPU6050_INTERRUPT_MOT_BIT
  **/
 void MPU6050_setIntMotionEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT, enabled);
 }
 /** Get Zero Motion Detection interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1587,7 +1759,7 @@ void MPU6050_setIntMotionEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_ZMOT_BIT
  **/
 bool MPU6050_getIntZeroMotionEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Zero Motion Detection interrupt enabled status.
@@ -1597,7 +1769,7 @@ bool MPU6050_getIntZeroMotionEnabled() {
  * @see MPU6050_INTERRUPT_ZMOT_BIT
  **/
 void MPU6050_setIntZeroMotionEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT, enabled);
 }
 /** Get FIFO Buffer Overflow interrupt enabled status.
  * Will be set 0 for disabled, 1 for enabled.
@@ -1606,7 +1778,7 @@ void MPU6050_setIntZeroMotionEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_FIFO_OFLOW_BIT
  **/
 bool MPU6050_getIntFIFOBufferOverflowEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set FIFO Buffer Overflow interrupt enabled status.
@@ -1616,7 +1788,7 @@ bool MPU6050_getIntFIFOBufferOverflowEnabled() {
  * @see MPU6050_INTERRUPT_FIFO_OFLOW_BIT
  **/
 void MPU6050_setIntFIFOBufferOverflowEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, enabled);
 }
 /** Get I2C Master interrupt enabled status.
  * This enables any of the I2C Master interrupt sources to generate an
@@ -1626,7 +1798,7 @@ void MPU6050_setIntFIFOBufferOverflowEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_I2C_MST_INT_BIT
  **/
 bool MPU6050_getIntI2CMasterEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set I2C Master interrupt enabled status.
@@ -1636,7 +1808,7 @@ bool MPU6050_getIntI2CMasterEnabled() {
  * @see MPU6050_INTERRUPT_I2C_MST_INT_BIT
  **/
 void MPU6050_setIntI2CMasterEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT, enabled);
 }
 /** Get Data Ready interrupt enabled setting.
  * This event occurs each time a write operation to all of the sensor registers
@@ -1646,7 +1818,7 @@ void MPU6050_setIntI2CMasterEnabled(bool enabled) {
  * @see MPU6050_INTERRUPT_DATA_RDY_BIT
  */
 bool MPU6050_getIntDataReadyEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Data Ready interrupt enabled status.
@@ -1656,7 +1828,7 @@ bool MPU6050_getIntDataReadyEnabled() {
  * @see MPU6050_INTERRUPT_DATA_RDY_BIT
  */
 void MPU6050_setIntDataReadyEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT, enabled);
 }
 
 // INT_STATUS register
@@ -1669,7 +1841,7 @@ void MPU6050_setIntDataReadyEnabled(bool enabled) {
  * @see MPU6050_RA_INT_STATUS
  */
 uint8_t MPU6050_getIntStatus() {
-    I2C_readByte(devAddr, MPU6050_RA_INT_STATUS, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_INT_STATUS, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Free Fall interrupt status.
@@ -1680,7 +1852,7 @@ uint8_t MPU6050_getIntStatus() {
  * @see MPU6050_INTERRUPT_FF_BIT
  */
 bool MPU6050_getIntFreefallStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FF_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FF_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Motion Detection interrupt status.
@@ -1691,7 +1863,7 @@ bool MPU6050_getIntFreefallStatus() {
  * @see MPU6050_INTERRUPT_MOT_BIT
  */
 bool MPU6050_getIntMotionStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_MOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_MOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Zero Motion Detection interrupt status.
@@ -1702,7 +1874,7 @@ bool MPU6050_getIntMotionStatus() {
  * @see MPU6050_INTERRUPT_ZMOT_BIT
  */
 bool MPU6050_getIntZeroMotionStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_ZMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_ZMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get FIFO Buffer Overflow interrupt status.
@@ -1713,7 +1885,7 @@ bool MPU6050_getIntZeroMotionStatus() {
  * @see MPU6050_INTERRUPT_FIFO_OFLOW_BIT
  */
 bool MPU6050_getIntFIFOBufferOverflowStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FIFO_OFLOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get I2C Master interrupt status.
@@ -1725,7 +1897,7 @@ bool MPU6050_getIntFIFOBufferOverflowStatus() {
  * @see MPU6050_INTERRUPT_I2C_MST_INT_BIT
  */
 bool MPU6050_getIntI2CMasterStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_I2C_MST_INT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_I2C_MST_INT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Data Ready interrupt status.
@@ -1736,7 +1908,7 @@ bool MPU6050_getIntI2CMasterStatus() {
  * @see MPU6050_INTERRUPT_DATA_RDY_BIT
  */
 bool MPU6050_getIntDataReadyStatus() {
-    I2C_readBit(devAddr, MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DATA_RDY_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DATA_RDY_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 
@@ -2009,7 +2181,7 @@ int16_t MPU6050_getRotationZ() {
  * @return Byte read from register
  */
 uint8_t MPU6050_getExternalSensorByte(int position) {
-    I2C_readByte(devAddr, MPU6050_RA_EXT_SENS_DATA_00 + position, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_EXT_SENS_DATA_00 + position, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Read word (2 bytes) from external sensor data registers.
@@ -2038,7 +2210,7 @@ uint32_t MPU6050_getExternalSensorDWord(int position) {
  * @see MPU6050_RA_MOT_DETECT_STATUS
  */
 uint8_t MPU6050_getMotionStatus() {
-    I2C_readByte(devAddr, MPU6050_RA_MOT_DETECT_STATUS, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_MOT_DETECT_STATUS, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get X-axis negative motion detection interrupt status.
@@ -2047,7 +2219,7 @@ uint8_t MPU6050_getMotionStatus() {
  * @see MPU6050_MOTION_MOT_XNEG_BIT
  */
 bool MPU6050_getXNegMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get X-axis positive motion detection interrupt status.
@@ -2056,7 +2228,7 @@ bool MPU6050_getXNegMotionDetected() {
  * @see MPU6050_MOTION_MOT_XPOS_BIT
  */
 bool MPU6050_getXPosMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Y-axis negative motion detection interrupt status.
@@ -2065,7 +2237,7 @@ bool MPU6050_getXPosMotionDetected() {
  * @see MPU6050_MOTION_MOT_YNEG_BIT
  */
 bool MPU6050_getYNegMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Y-axis positive motion detection interrupt status.
@@ -2074,7 +2246,7 @@ bool MPU6050_getYNegMotionDetected() {
  * @see MPU6050_MOTION_MOT_YPOS_BIT
  */
 bool MPU6050_getYPosMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Z-axis negative motion detection interrupt status.
@@ -2083,7 +2255,7 @@ bool MPU6050_getYPosMotionDetected() {
  * @see MPU6050_MOTION_MOT_ZNEG_BIT
  */
 bool MPU6050_getZNegMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZNEG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get Z-axis positive motion detection interrupt status.
@@ -2092,7 +2264,7 @@ bool MPU6050_getZNegMotionDetected() {
  * @see MPU6050_MOTION_MOT_ZPOS_BIT
  */
 bool MPU6050_getZPosMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZPOS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Get zero motion detection interrupt status.
@@ -2101,7 +2273,7 @@ bool MPU6050_getZPosMotionDetected() {
  * @see MPU6050_MOTION_MOT_ZRMOT_BIT
  */
 bool MPU6050_getZeroMotionDetected() {
-    I2C_readBit(devAddr, MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZRMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZRMOT_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 
@@ -2117,7 +2289,7 @@ bool MPU6050_getZeroMotionDetected() {
  */
 void MPU6050_setSlaveOutputByte(uint8_t num, uint8_t data) {
     if (num > 3) return;
-    I2C_writeByte(devAddr, MPU6050_RA_I2C_SLV0_DO + num, data);
+    MPU6050_WriteByte(MPU6050_RA_I2C_SLV0_DO + num, data);
 }
 
 // I2C_MST_DELAY_CTRL register
@@ -2131,7 +2303,7 @@ void MPU6050_setSlaveOutputByte(uint8_t num, uint8_t data) {
  * @see MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT
  */
 bool MPU6050_getExternalShadowDelayEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set external data shadow delay enabled status.
@@ -2141,7 +2313,7 @@ bool MPU6050_getExternalShadowDelayEnabled() {
  * @see MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT
  */
 void MPU6050_setExternalShadowDelayEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT, enabled);
 }
 /** Get slave delay enabled status.
  * When a particular slave delay is enabled, the rate of access for the that
@@ -2164,7 +2336,7 @@ void MPU6050_setExternalShadowDelayEnabled(bool enabled) {
 bool MPU6050_getSlaveDelayEnabled(uint8_t num) {
     // MPU6050_DELAYCTRL_I2C_SLV4_DLY_EN_BIT is 4, SLV3 is 3, etc.
     if (num > 4) return 0;
-    I2C_readBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_I2C_MST_DELAY_CTRL, num, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set slave delay enabled status.
@@ -2174,7 +2346,7 @@ bool MPU6050_getSlaveDelayEnabled(uint8_t num) {
  * @see MPU6050_DELAYCTRL_I2C_SLV0_DLY_EN_BIT
  */
 void MPU6050_setSlaveDelayEnabled(uint8_t num, bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_I2C_MST_DELAY_CTRL, num, enabled);
+    MPU6050_WriteBit(MPU6050_RA_I2C_MST_DELAY_CTRL, num, enabled);
 }
 
 // SIGNAL_PATH_RESET register
@@ -2186,7 +2358,7 @@ void MPU6050_setSlaveDelayEnabled(uint8_t num, bool enabled) {
  * @see MPU6050_PATHRESET_GYRO_RESET_BIT
  */
 void MPU6050_resetGyroscopePath() {
-    I2C_writeBit(devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_GYRO_RESET_BIT, true);
+    MPU6050_WriteBit(MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_GYRO_RESET_BIT, true);
 }
 /** Reset accelerometer signal path.
  * The reset will revert the signal path analog to digital converters and
@@ -2195,7 +2367,7 @@ void MPU6050_resetGyroscopePath() {
  * @see MPU6050_PATHRESET_ACCEL_RESET_BIT
  */
 void MPU6050_resetAccelerometerPath() {
-    I2C_writeBit(devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_ACCEL_RESET_BIT, true);
+    MPU6050_WriteBit(MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_ACCEL_RESET_BIT, true);
 }
 /** Reset temperature sensor signal path.
  * The reset will revert the signal path analog to digital converters and
@@ -2204,7 +2376,7 @@ void MPU6050_resetAccelerometerPath() {
  * @see MPU6050_PATHRESET_TEMP_RESET_BIT
  */
 void MPU6050_resetTemperaturePath() {
-    I2C_writeBit(devAddr, MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_TEMP_RESET_BIT, true);
+    MPU6050_WriteBit(MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_TEMP_RESET_BIT, true);
 }
 
 // MOT_DETECT_CTRL register
@@ -2224,7 +2396,7 @@ void MPU6050_resetTemperaturePath() {
  * @see MPU6050_DETECT_ACCEL_ON_DELAY_BIT
  */
 uint8_t MPU6050_getAccelerometerPowerOnDelay() {
-    I2C_readBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set accelerometer power-on delay.
@@ -2234,7 +2406,7 @@ uint8_t MPU6050_getAccelerometerPowerOnDelay() {
  * @see MPU6050_DETECT_ACCEL_ON_DELAY_BIT
  */
 void MPU6050_setAccelerometerPowerOnDelay(uint8_t delay) {
-    I2C_writeBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, delay);
+    MPU6050_WriteBits(MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH, delay);
 }
 /** Get Free Fall detection counter decrement configuration.
  * Detection is registered by the Free Fall detection module after accelerometer
@@ -2263,7 +2435,7 @@ void MPU6050_setAccelerometerPowerOnDelay(uint8_t delay) {
  * @see MPU6050_DETECT_FF_COUNT_BIT
  */
 uint8_t MPU6050_getFreefallDetectionCounterDecrement() {
-    I2C_readBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Free Fall detection counter decrement configuration.
@@ -2273,7 +2445,7 @@ uint8_t MPU6050_getFreefallDetectionCounterDecrement() {
  * @see MPU6050_DETECT_FF_COUNT_BIT
  */
 void MPU6050_setFreefallDetectionCounterDecrement(uint8_t decrement) {
-    I2C_writeBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, decrement);
+    MPU6050_WriteBits(MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH, decrement);
 }
 /** Get Motion detection counter decrement configuration.
  * Detection is registered by the Motion detection module after accelerometer
@@ -2299,7 +2471,7 @@ void MPU6050_setFreefallDetectionCounterDecrement(uint8_t decrement) {
  *
  */
 uint8_t MPU6050_getMotionDetectionCounterDecrement() {
-    I2C_readBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Motion detection counter decrement configuration.
@@ -2309,7 +2481,7 @@ uint8_t MPU6050_getMotionDetectionCounterDecrement() {
  * @see MPU6050_DETECT_MOT_COUNT_BIT
  */
 void MPU6050_setMotionDetectionCounterDecrement(uint8_t decrement) {
-    I2C_writeBits(devAddr, MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, decrement);
+    MPU6050_WriteBits(MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH, decrement);
 }
 
 // USER_CTRL register
@@ -2323,7 +2495,7 @@ void MPU6050_setMotionDetectionCounterDecrement(uint8_t decrement) {
  * @see MPU6050_USERCTRL_FIFO_EN_BIT
  */
 bool MPU6050_getFIFOEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set FIFO enabled status.
@@ -2333,7 +2505,7 @@ bool MPU6050_getFIFOEnabled() {
  * @see MPU6050_USERCTRL_FIFO_EN_BIT
  */
 void MPU6050_setFIFOEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT, enabled);
 }
 /** Get I2C Master Mode enabled status.
  * When this mode is enabled, the MPU-60X0 acts as the I2C Master to the
@@ -2347,7 +2519,7 @@ void MPU6050_setFIFOEnabled(bool enabled) {
  * @see MPU6050_USERCTRL_I2C_MST_EN_BIT
  */
 bool MPU6050_getI2CMasterModeEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set I2C Master Mode enabled status.
@@ -2357,14 +2529,14 @@ bool MPU6050_getI2CMasterModeEnabled() {
  * @see MPU6050_USERCTRL_I2C_MST_EN_BIT
  */
 void MPU6050_setI2CMasterModeEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
 }
 /** Switch from I2C to SPI mode (MPU-6000 only)
  * If this is set, the primary SPI interface will be enabled in place of the
  * disabled primary I2C interface.
  */
 void MPU6050_switchSPIEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_IF_DIS_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_IF_DIS_BIT, enabled);
 }
 /** Reset the FIFO.
  * This bit resets the FIFO buffer when set to 1 while FIFO_EN equals 0. This
@@ -2373,7 +2545,7 @@ void MPU6050_switchSPIEnabled(bool enabled) {
  * @see MPU6050_USERCTRL_FIFO_RESET_BIT
  */
 void MPU6050_resetFIFO() {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET_BIT, true);
+    MPU6050_WriteBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET_BIT, true);
 }
 /** Reset the I2C Master.
  * This bit resets the I2C Master when set to 1 while I2C_MST_EN equals 0.
@@ -2382,7 +2554,7 @@ void MPU6050_resetFIFO() {
  * @see MPU6050_USERCTRL_I2C_MST_RESET_BIT
  */
 void MPU6050_resetI2CMaster() {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_RESET_BIT, true);
+    MPU6050_WriteBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_RESET_BIT, true);
 }
 /** Reset all sensor registers and signal paths.
  * When set to 1, this bit resets the signal paths for all sensors (gyroscopes,
@@ -2397,7 +2569,7 @@ void MPU6050_resetI2CMaster() {
  * @see MPU6050_USERCTRL_SIG_COND_RESET_BIT
  */
 void MPU6050_resetSensors() {
-    I2C_writeBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_SIG_COND_RESET_BIT, true);
+    MPU6050_WriteBit(MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_SIG_COND_RESET_BIT, true);
 }
 
 // PWR_MGMT_1 register
@@ -2408,7 +2580,7 @@ void MPU6050_resetSensors() {
  * @see MPU6050_PWR1_DEVICE_RESET_BIT
  */
 void MPU6050_reset() {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, true);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT, true);
 }
 /** Get sleep mode status.
  * Setting the SLEEP bit in the register puts the device into very low power
@@ -2422,7 +2594,7 @@ void MPU6050_reset() {
  * @see MPU6050_PWR1_SLEEP_BIT
  */
 bool MPU6050_getSleepEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set sleep mode status.
@@ -2432,7 +2604,7 @@ bool MPU6050_getSleepEnabled() {
  * @see MPU6050_PWR1_SLEEP_BIT
  */
 void MPU6050_setSleepEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
 }
 /** Get wake cycle enabled status.
  * When this bit is set to 1 and SLEEP is disabled, the MPU-60X0 will cycle
@@ -2443,7 +2615,7 @@ void MPU6050_setSleepEnabled(bool enabled) {
  * @see MPU6050_PWR1_CYCLE_BIT
  */
 bool MPU6050_getWakeCycleEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set wake cycle enabled status.
@@ -2453,7 +2625,7 @@ bool MPU6050_getWakeCycleEnabled() {
  * @see MPU6050_PWR1_CYCLE_BIT
  */
 void MPU6050_setWakeCycleEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT, enabled);
 }
 /** Get temperature sensor enabled status.
  * Control the usage of the internal temperature sensor.
@@ -2467,7 +2639,7 @@ void MPU6050_setWakeCycleEnabled(bool enabled) {
  * @see MPU6050_PWR1_TEMP_DIS_BIT
  */
 bool MPU6050_getTempSensorEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0] == 0; // 1 is actually disabled here
 }
 /** Set temperature sensor enabled status.
@@ -2482,7 +2654,7 @@ bool MPU6050_getTempSensorEnabled() {
  */
 void MPU6050_setTempSensorEnabled(bool enabled) {
     // 1 is actually disabled here
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, !enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT, !enabled);
 }
 /** Get clock source setting.
  * @return Current clock source setting
@@ -2491,7 +2663,7 @@ void MPU6050_setTempSensorEnabled(bool enabled) {
  * @see MPU6050_PWR1_CLKSEL_LENGTH
  */
 uint8_t MPU6050_getClockSource() {
-    I2C_readBits(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set clock source setting.
@@ -2525,7 +2697,7 @@ uint8_t MPU6050_getClockSource() {
  * @see MPU6050_PWR1_CLKSEL_LENGTH
  */
 void MPU6050_setClockSource(uint8_t source) {
-    I2C_writeBits(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
+    MPU6050_WriteBits(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
 }
 
 // PWR_MGMT_2 register
@@ -2554,7 +2726,7 @@ void MPU6050_setClockSource(uint8_t source) {
  * @see MPU6050_RA_PWR_MGMT_2
  */
 uint8_t MPU6050_getWakeFrequency() {
-    I2C_readBits(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set wake frequency in Accel-Only Low Power Mode.
@@ -2562,7 +2734,7 @@ uint8_t MPU6050_getWakeFrequency() {
  * @see MPU6050_RA_PWR_MGMT_2
  */
 void MPU6050_setWakeFrequency(uint8_t frequency) {
-    I2C_writeBits(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, frequency);
+    MPU6050_WriteBits(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH, frequency);
 }
 
 /** Get X-axis accelerometer standby enabled status.
@@ -2572,7 +2744,7 @@ void MPU6050_setWakeFrequency(uint8_t frequency) {
  * @see MPU6050_PWR2_STBY_XA_BIT
  */
 bool MPU6050_getStandbyXAccelEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set X-axis accelerometer standby enabled status.
@@ -2582,7 +2754,7 @@ bool MPU6050_getStandbyXAccelEnabled() {
  * @see MPU6050_PWR2_STBY_XA_BIT
  */
 void MPU6050_setStandbyXAccelEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT, enabled);
 }
 /** Get Y-axis accelerometer standby enabled status.
  * If enabled, the Y-axis will not gather or report data (or use power).
@@ -2591,7 +2763,7 @@ void MPU6050_setStandbyXAccelEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_YA_BIT
  */
 bool MPU6050_getStandbyYAccelEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Y-axis accelerometer standby enabled status.
@@ -2601,7 +2773,7 @@ bool MPU6050_getStandbyYAccelEnabled() {
  * @see MPU6050_PWR2_STBY_YA_BIT
  */
 void MPU6050_setStandbyYAccelEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT, enabled);
 }
 /** Get Z-axis accelerometer standby enabled status.
  * If enabled, the Z-axis will not gather or report data (or use power).
@@ -2610,7 +2782,7 @@ void MPU6050_setStandbyYAccelEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_ZA_BIT
  */
 bool MPU6050_getStandbyZAccelEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Z-axis accelerometer standby enabled status.
@@ -2620,7 +2792,7 @@ bool MPU6050_getStandbyZAccelEnabled() {
  * @see MPU6050_PWR2_STBY_ZA_BIT
  */
 void MPU6050_setStandbyZAccelEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT, enabled);
 }
 /** Get X-axis gyroscope standby enabled status.
  * If enabled, the X-axis will not gather or report data (or use power).
@@ -2629,7 +2801,7 @@ void MPU6050_setStandbyZAccelEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_XG_BIT
  */
 bool MPU6050_getStandbyXGyroEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set X-axis gyroscope standby enabled status.
@@ -2639,7 +2811,7 @@ bool MPU6050_getStandbyXGyroEnabled() {
  * @see MPU6050_PWR2_STBY_XG_BIT
  */
 void MPU6050_setStandbyXGyroEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT, enabled);
 }
 /** Get Y-axis gyroscope standby enabled status.
  * If enabled, the Y-axis will not gather or report data (or use power).
@@ -2648,7 +2820,7 @@ void MPU6050_setStandbyXGyroEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_YG_BIT
  */
 bool MPU6050_getStandbyYGyroEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Y-axis gyroscope standby enabled status.
@@ -2658,7 +2830,7 @@ bool MPU6050_getStandbyYGyroEnabled() {
  * @see MPU6050_PWR2_STBY_YG_BIT
  */
 void MPU6050_setStandbyYGyroEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT, enabled);
 }
 /** Get Z-axis gyroscope standby enabled status.
  * If enabled, the Z-axis will not gather or report data (or use power).
@@ -2667,7 +2839,7 @@ void MPU6050_setStandbyYGyroEnabled(bool enabled) {
  * @see MPU6050_PWR2_STBY_ZG_BIT
  */
 bool MPU6050_getStandbyZGyroEnabled() {
-    I2C_readBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Z-axis gyroscope standby enabled status.
@@ -2677,7 +2849,7 @@ bool MPU6050_getStandbyZGyroEnabled() {
  * @see MPU6050_PWR2_STBY_ZG_BIT
  */
 void MPU6050_setStandbyZGyroEnabled(bool enabled) {
-    I2C_writeBit(devAddr, MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, enabled);
+    MPU6050_WriteBit(MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT, enabled);
 }
 
 // FIFO_COUNT* registers
@@ -2722,22 +2894,27 @@ uint16_t MPU6050_getFIFOCount() {
  * @return Byte from FIFO buffer
  */
 uint8_t MPU6050_getFIFOByte() {
-    I2C_readByte(devAddr, MPU6050_RA_FIFO_R_W, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadByte(MPU6050_RA_FIFO_R_W, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
-void MPU6050_getFIFOBytes(uint8_t *data, uint8_t length) {
-    if(length > 0){
-        I2C_readBytes(devAddr, MPU6050_RA_FIFO_R_W, length, data, I2C_MASTER_TIMEOUT_MS);
-    } else {
+bool MPU6050_getFIFOBytes(uint8_t *data, uint16_t length) {
+    static i2c_batch_t fifo_batch;
+    i2c_transfer_t read = {
+        .devAddr = devAddr, .regAddr = MPU6050_RA_FIFO_R_W, .read = true, .length = length, .data = data,
+    };
+    if(length == 0){
     	*data = 0;
+    	return true;
     }
+    /* One transaction for the whole length (I2C_readBytes() reads up to 255 bytes) */
+    return I2C_BatchPrepare(&fifo_batch, &read, 1) && I2C_BatchRun(&fifo_batch, I2C_MASTER_TIMEOUT_MS);
 }
 /** Write byte to FIFO buffer.
  * @see getFIFOByte()
  * @see MPU6050_RA_FIFO_R_W
  */
 void MPU6050_setFIFOByte(uint8_t data) {
-    I2C_writeByte(devAddr, MPU6050_RA_FIFO_R_W, data);
+    MPU6050_WriteByte(MPU6050_RA_FIFO_R_W, data);
 }
 
 // WHO_AM_I register
@@ -2750,7 +2927,7 @@ void MPU6050_setFIFOByte(uint8_t data) {
  * @see MPU6050_WHO_AM_I_LENGTH
  */
 uint8_t MPU6050_getDeviceID() {
-    I2C_readBits(devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
+    MPU6050_ReadBits(MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, buffer, I2C_MASTER_TIMEOUT_MS);
     return buffer[0];
 }
 /** Set Device ID.
@@ -2763,7 +2940,7 @@ uint8_t MPU6050_getDeviceID() {
  * @see MPU6050_WHO_AM_I_LENGTH
  */
 void MPU6050_setDeviceID(uint8_t id) {
-    I2C_writeBits(devAddr, MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, id);
+    MPU6050_WriteBits(MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, id);
 }
 
 /*==================[end of file]============================================*/
@@ -0,0 +1,231 @@
+/**
+ * @file mpu6050_fifo.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mpu6050_fifo.h"
+#include <stdint.h>
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define STAMPS_MASK			(MPU6050_FIFO_STAMPS - 1)
+#define GYRO_RATE_DLPF		1000		/*!< Gyroscope output rate with the DLPF enabled */
+#define GYRO_RATE_NO_DLPF	8000		/*!< Gyroscope output rate without DLPF */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static uint32_t stamps[MPU6050_FIFO_STAMPS];		/*!< Time of the data ready pulses */
+static volatile uint16_t stamps_head = 0;			/*!< Next position to write (only modified by the ISR) */
+static volatile uint16_t stamps_tail = 0;			/*!< Next position to read (only modified by the reader) */
+static volatile TaskHandle_t waiting_task = NULL;	/*!< Task blocked on MPU6050FifoRead() */
+static volatile uint16_t waiting_stamps = 0;		/*!< Number of samples the waiting task needs */
+static portMUX_TYPE waiting_lock = portMUX_INITIALIZER_UNLOCKED;
+static mpu6050_fifo_config_t fifo_cfg;				/*!< Configuration */
+static uint8_t frame_size = 0;						/*!< Bytes of a sample in the FIFO (0: stopped) */
+static uint32_t overflows = 0;						/*!< FIFO overflows */
+static uint8_t fifo_data[MPU6050_FIFO_BYTES];		/*!< FIFO data being parsed */
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Data ready ISR: stores the time of the sample
+ */
+static void IRAM_ATTR MPU6050FifoIsr(void *args){
+	uint32_t now = (uint32_t)esp_timer_get_time();
+	uint16_t head = stamps_head;
+
+	/* When full, the oldest stamp is overwritten: the reader detects it and resyncs */
+	stamps[head & STAMPS_MASK] = now;
+	head++;
+	__atomic_store_n(&stamps_head, head, __ATOMIC_RELEASE);
+
+	portENTER_CRITICAL_ISR(&waiting_lock);
+	if((waiting_task != NULL) && ((uint16_t)(head - stamps_tail) >= waiting_stamps)){
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		vTaskNotifyGiveFromISR(waiting_task, &xHigherPriorityTaskWoken);
+		waiting_task = NULL;
+		portEXIT_CRITICAL_ISR(&waiting_lock);
+		if(xHigherPriorityTaskWoken == pdTRUE){
+			portYIELD_FROM_ISR();
+		}
+		return;
+	}
+	portEXIT_CRITICAL_ISR(&waiting_lock);
+}
+
+static uint16_t MPU6050FifoPending(void){
+	return (uint16_t)(__atomic_load_n(&stamps_head, __ATOMIC_ACQUIRE) - stamps_tail);
+}
+
+/**
+ * @brief Empty the FIFO and drop pending stamps (frames are aligned again)
+ */
+static void MPU6050FifoResync(void){
+	MPU6050_setFIFOEnabled(false);
+	MPU6050_resetFIFO();
+	__atomic_store_n(&stamps_tail, __atomic_load_n(&stamps_head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+	MPU6050_setFIFOEnabled(true);
+}
+
+static void MPU6050FifoContents(uint8_t contents){
+	MPU6050_setAccelFIFOEnabled(contents & MPU6050_FIFO_ACCEL);
+	MPU6050_setTempFIFOEnabled(contents & MPU6050_FIFO_TEMP);
+	MPU6050_setXGyroFIFOEnabled(contents & MPU6050_FIFO_GYRO);
+	MPU6050_setYGyroFIFOEnabled(contents & MPU6050_FIFO_GYRO);
+	MPU6050_setZGyroFIFOEnabled(contents & MPU6050_FIFO_GYRO);
+}
+
+static inline int16_t MPU6050FifoWord(const uint8_t *data){
+	return (int16_t)((data[0] << 8) | data[1]);
+}
+
+static void MPU6050FifoParse(const uint8_t *frame, mpu6050_samples_t *samples, uint16_t n){
+	/* Data is written to the FIFO in register order: accelerometer, temperature, gyroscope */
+	if(fifo_cfg.contents & MPU6050_FIFO_ACCEL){
+		if(samples->ax != NULL) samples->ax[n] = MPU6050FifoWord(&frame[0]);
+		if(samples->ay != NULL) samples->ay[n] = MPU6050FifoWord(&frame[2]);
+		if(samples->az != NULL) samples->az[n] = MPU6050FifoWord(&frame[4]);
+		frame += 6;
+	}
+	if(fifo_cfg.contents & MPU6050_FIFO_TEMP){
+		if(samples->temp != NULL) samples->temp[n] = MPU6050FifoWord(&frame[0]);
+		frame += 2;
+	}
+	if(fifo_cfg.contents & MPU6050_FIFO_GYRO){
+		if(samples->gx != NULL) samples->gx[n] = MPU6050FifoWord(&frame[0]);
+		if(samples->gy != NULL) samples->gy[n] = MPU6050FifoWord(&frame[2]);
+		if(samples->gz != NULL) samples->gz[n] = MPU6050FifoWord(&frame[4]);
+	}
+}
+/*==================[external functions definition]==========================*/
+bool MPU6050FifoStart(const mpu6050_fifo_config_t *config){
+	uint16_t base_rate;
+	uint16_t div;
+
+	if((config->rate_hz == 0) || (config->burst == 0) || (config->burst > MPU6050_FIFO_STAMPS) ||
+	   ((config->contents & (MPU6050_FIFO_ACCEL | MPU6050_FIFO_TEMP | MPU6050_FIFO_GYRO)) == 0)){
+		return false;
+	}
+	fifo_cfg = *config;
+	fifo_cfg.contents &= MPU6050_FIFO_ACCEL | MPU6050_FIFO_TEMP | MPU6050_FIFO_GYRO;
+	frame_size = ((fifo_cfg.contents & MPU6050_FIFO_ACCEL) ? 6 : 0) +
+				 ((fifo_cfg.contents & MPU6050_FIFO_TEMP) ? 2 : 0) +
+				 ((fifo_cfg.contents & MPU6050_FIFO_GYRO) ? 6 : 0);
+
+	/* Sample rate = gyroscope output rate / (1 + SMPLRT_DIV) */
+	base_rate = ((fifo_cfg.dlpf_mode == MPU6050_DLPF_BW_256) || (fifo_cfg.dlpf_mode > MPU6050_DLPF_BW_5)) ?
+				GYRO_RATE_NO_DLPF : GYRO_RATE_DLPF;
+	div = base_rate / fifo_cfg.rate_hz;
+	div = (div == 0) ? 0 : ((div > 256) ? 255 : div - 1);
+	MPU6050_setDLPFMode(fifo_cfg.dlpf_mode);
+	MPU6050_setRate(div);
+
+	/* INT: active high, push-pull, 50 us pulse on each sample */
+	MPU6050_setInterruptMode(false);
+	MPU6050_setInterruptDrive(false);
+	MPU6050_setInterruptLatch(false);
+	MPU6050_setIntEnabled(1 << MPU6050_INTERRUPT_DATA_RDY_BIT);
+
+	MPU6050FifoContents(fifo_cfg.contents);
+	overflows = 0;
+	GPIOActivInt(fifo_cfg.int_pin, MPU6050FifoIsr, true, NULL);
+	MPU6050FifoResync();
+	return true;
+}
+
+uint16_t MPU6050FifoRead(mpu6050_samples_t *samples, uint32_t timeout_ms){
+	TickType_t ticks = portMAX_DELAY;
+	uint16_t pending, bytes, frames, n, tail;
+
+	if(frame_size == 0){
+		return 0;
+	}
+	if(timeout_ms != MPU6050_FIFO_NO_TIMEOUT){
+		ticks = pdMS_TO_TICKS(timeout_ms);
+	}
+	if(MPU6050FifoPending() < fifo_cfg.burst){
+		bool notified = false;
+		waiting_stamps = fifo_cfg.burst;
+		waiting_task = xTaskGetCurrentTaskHandle();
+		/* A pulse could have arrived before waiting_task was set */
+		if(MPU6050FifoPending() < fifo_cfg.burst){
+			notified = (ulTaskNotifyTake(pdTRUE, ticks) > 0);
+		}
+		portENTER_CRITICAL(&waiting_lock);
+		bool given = (waiting_task == NULL);
+		waiting_task = NULL;
+		portEXIT_CRITICAL(&waiting_lock);
+		if(given && !notified){
+			/* The ISR notified after the timeout: don't leave it pending for the task */
+			ulTaskNotifyTake(pdTRUE, 0);
+		}
+		if(MPU6050FifoPending() < fifo_cfg.burst){
+			return 0;
+		}
+	}
+
+	/* Stamps are taken before the FIFO count: the FIFO can only have more frames (newer ones stay for the next read) */
+	pending = MPU6050FifoPending();
+	bytes = MPU6050_getFIFOCount();
+	if((pending > MPU6050_FIFO_STAMPS) || (bytes > MPU6050_FIFO_BYTES - frame_size)){
+		/* Overflow: lost stamps, or the FIFO dropped its oldest bytes (frames misaligned) */
+		MPU6050FifoResync();
+		overflows++;
+		return 0;
+	}
+	frames = bytes / frame_size;
+	tail = stamps_tail;
+	if(frames < pending){
+		/* Pulses without frame (FIFO disabled or reset): the oldest ones */
+		tail += pending - frames;
+		pending = frames;
+	}
+	if(pending > samples->size){
+		pending = samples->size;
+	}
+
+	/* The whole backlog in one burst read (at most MPU6050_FIFO_BYTES) */
+	if(!MPU6050_getFIFOBytes(fifo_data, pending * frame_size)){
+		/* An unknown number of bytes left the FIFO: frames are not aligned anymore */
+		MPU6050FifoResync();
+		return 0;
+	}
+	for(n = 0; n < pending; n++){
+		MPU6050FifoParse(&fifo_data[n * frame_size], samples, n);
+		if(samples->timestamp != NULL){
+			samples->timestamp[n] = stamps[tail & STAMPS_MASK];
+		}
+		tail++;
+	}
+	__atomic_store_n(&stamps_tail, tail, __ATOMIC_RELEASE);
+	return pending;
+}
+
+void MPU6050FifoStop(void){
+	if(frame_size == 0){
+		return;
+	}
+	gpio_intr_disable((gpio_num_t)fifo_cfg.int_pin);
+	gpio_isr_handler_remove((gpio_num_t)fifo_cfg.int_pin);
+	MPU6050_setIntEnabled(0);
+	MPU6050_setFIFOEnabled(false);
+	MPU6050FifoContents(0);
+	frame_size = 0;
+}
+
+uint32_t MPU6050FifoOverflows(void){
+	return overflows;
+}
+
+/*==================[end of file]============================================*/
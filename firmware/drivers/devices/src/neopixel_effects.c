@@ -0,0 +1,109 @@
+/**
+ * @file neopixel_effects.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "neopixel_effects.h"
+#include "neopixel_fx_render.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static uint16_t fx_period_ms;					/*!< Frame period of the effects task */
+static volatile bool fx_running = false;		/*!< Effects task enabled */
+static TaskHandle_t fx_task = NULL;				/*!< Effects task */
+static SemaphoreHandle_t fx_mutex = NULL;		/*!< Protects layers while rendering */
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void NeoPixelFxTask(void *param){
+	TickType_t last_wake = xTaskGetTickCount();
+	while(fx_running){
+		/* The frame is sent before a layer change can render over it */
+		xSemaphoreTake(fx_mutex, portMAX_DELAY);
+		NeoPixelFxRenderFrame();
+		NeoPixelSetArray(NeoPixelFxRenderGetFrame());
+		xSemaphoreGive(fx_mutex);
+		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(fx_period_ms));
+	}
+	fx_task = NULL;
+	vTaskDelete(NULL);
+}
+/*==================[external functions definition]==========================*/
+void NeoPixelFxInit(neopixel_color_t *frame, uint16_t len){
+	if(fx_mutex == NULL){
+		fx_mutex = xSemaphoreCreateMutex();
+	}
+	xSemaphoreTake(fx_mutex, portMAX_DELAY);
+	NeoPixelFxRenderInit(frame, len);
+	xSemaphoreGive(fx_mutex);
+}
+
+bool NeoPixelFxSetLayer(uint8_t layer, const neopixel_fx_t *fx){
+	bool ok;
+	if(fx_mutex == NULL){
+		return false;
+	}
+	xSemaphoreTake(fx_mutex, portMAX_DELAY);
+	ok = NeoPixelFxRenderSetLayer(layer, fx);
+	xSemaphoreGive(fx_mutex);
+	return ok;
+}
+
+void NeoPixelFxClearLayer(uint8_t layer){
+	if(fx_mutex == NULL){
+		return;
+	}
+	xSemaphoreTake(fx_mutex, portMAX_DELAY);
+	NeoPixelFxRenderClearLayer(layer);
+	xSemaphoreGive(fx_mutex);
+}
+
+void NeoPixelFxRender(void){
+	if(fx_mutex == NULL){
+		return;
+	}
+	xSemaphoreTake(fx_mutex, portMAX_DELAY);
+	NeoPixelFxRenderFrame();
+	xSemaphoreGive(fx_mutex);
+}
+
+bool NeoPixelFxStart(uint16_t frame_period_ms){
+	if((fx_task != NULL) || (NeoPixelFxRenderGetFrame() == NULL) || (frame_period_ms == 0)){
+		return false;
+	}
+	fx_period_ms = frame_period_ms;
+	fx_running = true;
+	if(xTaskCreate(&NeoPixelFxTask, "neopixel_fx", 2048, NULL, 5, &fx_task) != pdPASS){
+		fx_task = NULL;
+		fx_running = false;
+		return false;
+	}
+	return true;
+}
+
+void NeoPixelFxStop(void){
+	if(fx_task == NULL){
+		return;
+	}
+	/* The task ends after its current frame period */
+	fx_running = false;
+	while(fx_task != NULL){
+		vTaskDelay(pdMS_TO_TICKS(10));
+	}
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,246 @@
+/**
+ * @file neopixel_fx_render.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stddef.h>
+#include "neopixel_fx_render.h"
+/*==================[macros and definitions]=================================*/
+#define RB_MSK          0x00FF00FF
+#define G_MSK           0x0000FF00
+#define RED_OFFSET      16
+#define GREEN_OFFSET    8
+#define HUE_LUT_SIZE    256
+#define PHASE_TURN      0x100000000ULL  /* full cycle of a 32 bits phase */
+/*==================[internal data declaration]==============================*/
+/**
+ * @brief State of a layer
+ */
+typedef struct {
+	neopixel_fx_t fx;			/*!< Effect configuration */
+	uint32_t phase;				/*!< Position in the current cycle (2^32: full cycle) */
+	uint32_t phase_step;		/*!< Phase increment per frame */
+	uint32_t hue_step;			/*!< Rainbow: hue increment per led (2^32: full turn) */
+	uint32_t cycles;			/*!< Completed cycles */
+	uint8_t sv_lut[256];		/*!< Rainbow: component with saturation and value applied */
+} fx_layer_t;
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static neopixel_color_t hue_lut[HUE_LUT_SIZE];	/*!< Colors of 256 hues at full saturation and value */
+static fx_layer_t layers[NEOPIXEL_FX_LAYERS];	/*!< Effect layers */
+static neopixel_color_t *fx_frame = NULL;		/*!< Frame where layers are rendered */
+static uint16_t fx_len = 0;						/*!< Number of leds */
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Color with each component multiplied by level / 256 (two components per multiply)
+ */
+static inline neopixel_color_t NeoPixelFxScale(neopixel_color_t color, uint16_t level){
+	return ((((color & RB_MSK) * level) >> 8) & RB_MSK) | ((((color & G_MSK) * level) >> 8) & G_MSK);
+}
+
+static inline neopixel_color_t NeoPixelFxMix(neopixel_color_t dst, neopixel_color_t src, uint16_t alpha){
+	uint16_t inv = 256 - alpha;
+	return ((((src & RB_MSK) * alpha + (dst & RB_MSK) * inv) >> 8) & RB_MSK) |
+	       ((((src & G_MSK) * alpha + (dst & G_MSK) * inv) >> 8) & G_MSK);
+}
+
+static inline neopixel_color_t NeoPixelFxAdd(neopixel_color_t dst, neopixel_color_t src){
+	uint32_t rb = (dst & RB_MSK) + (src & RB_MSK);		/* carries go to bits 8 and 24 */
+	uint32_t g = (dst & G_MSK) + (src & G_MSK);			/* carry goes to bit 16 */
+	uint32_t sat = (((rb & 0x01000100) >> 8) * 0xFF) | (((g & 0x00010000) >> 8) * 0xFF);
+	return ((rb & RB_MSK) | (g & G_MSK)) | sat;
+}
+
+static inline neopixel_color_t NeoPixelFxMax(neopixel_color_t dst, neopixel_color_t src){
+	neopixel_color_t out = 0;
+	for(uint8_t shift = 0; shift <= RED_OFFSET; shift += 8){
+		uint32_t d = (dst >> shift) & 0xFF;
+		uint32_t s = (src >> shift) & 0xFF;
+		out |= ((d > s) ? d : s) << shift;
+	}
+	return out;
+}
+
+static inline void NeoPixelFxBlend(neopixel_color_t *dst, neopixel_color_t src, const fx_layer_t *layer){
+	switch(layer->fx.blend){
+		case NEOPIXEL_BLEND_ADD:
+			*dst = NeoPixelFxAdd(*dst, src);
+		break;
+		case NEOPIXEL_BLEND_MAX:
+			*dst = NeoPixelFxMax(*dst, src);
+		break;
+		case NEOPIXEL_BLEND_ALPHA:
+			*dst = NeoPixelFxMix(*dst, src, layer->fx.alpha + 1);
+		break;
+		default:
+			*dst = src;
+		break;
+	}
+}
+
+/**
+ * @brief Triangle wave over a cycle: 0 -> 255 -> 0
+ */
+static inline uint16_t NeoPixelFxTriangle(uint32_t phase){
+	uint16_t p = phase >> 23;		/* 0 to 511 */
+	return (p < 256) ? p : (511 - p);
+}
+
+/**
+ * @brief 8 bits pseudo random number of a led in a cycle (same inputs, same number)
+ */
+static inline uint8_t NeoPixelFxHash(uint32_t led, uint32_t cycle){
+	uint32_t h = (led * 2654435761U) ^ (cycle * 0x9E3779B9U);
+	h ^= h >> 15;
+	h *= 0x2C1B3C6DU;
+	return h >> 24;
+}
+
+static void NeoPixelFxRainbow(fx_layer_t *layer){
+	uint32_t hue = layer->phase;
+	bool plain = (layer->fx.sat == 255) && (layer->fx.val == 255);
+	for(uint16_t i = 0; i < fx_len; i++){
+		neopixel_color_t c = hue_lut[hue >> 24];
+		if(!plain){
+			c = ((neopixel_color_t)layer->sv_lut[c >> RED_OFFSET] << RED_OFFSET) |
+				((neopixel_color_t)layer->sv_lut[(c >> GREEN_OFFSET) & 0xFF] << GREEN_OFFSET) |
+				layer->sv_lut[c & 0xFF];
+		}
+		NeoPixelFxBlend(&fx_frame[i], c, layer);
+		hue += layer->hue_step;
+	}
+}
+
+static void NeoPixelFxChase(fx_layer_t *layer){
+	uint16_t group = layer->fx.size + layer->fx.spacing;
+	uint16_t pos = group - (layer->cycles % group);		/* position of led 0 in its group */
+	bool skip_dark = (layer->fx.blend == NEOPIXEL_BLEND_ADD) || (layer->fx.blend == NEOPIXEL_BLEND_MAX);
+	if(pos == group){
+		pos = 0;
+	}
+	for(uint16_t i = 0; i < fx_len; i++){
+		if(pos < layer->fx.size){
+			NeoPixelFxBlend(&fx_frame[i], layer->fx.color, layer);
+		} else if(!skip_dark){
+			NeoPixelFxBlend(&fx_frame[i], 0, layer);
+		}
+		if(++pos == group){
+			pos = 0;
+		}
+	}
+}
+
+static void NeoPixelFxFill(fx_layer_t *layer, neopixel_color_t color){
+	for(uint16_t i = 0; i < fx_len; i++){
+		NeoPixelFxBlend(&fx_frame[i], color, layer);
+	}
+}
+
+static void NeoPixelFxSparkle(fx_layer_t *layer){
+	neopixel_color_t color = NeoPixelFxScale(layer->fx.color, NeoPixelFxTriangle(layer->phase) + 1);
+	bool skip_dark = (layer->fx.blend == NEOPIXEL_BLEND_ADD) || (layer->fx.blend == NEOPIXEL_BLEND_MAX);
+	for(uint16_t i = 0; i < fx_len; i++){
+		if(NeoPixelFxHash(i, layer->cycles) < layer->fx.density){
+			NeoPixelFxBlend(&fx_frame[i], color, layer);
+		} else if(!skip_dark){
+			NeoPixelFxBlend(&fx_frame[i], 0, layer);
+		}
+	}
+}
+
+static void NeoPixelFxAdvance(fx_layer_t *layer){
+	uint32_t prev = layer->phase;
+	layer->phase += layer->phase_step;
+	if(layer->phase <= prev){
+		/* Wrapped (or 1 frame cycles, with phase_step = 0) */
+		layer->cycles++;
+	}
+}
+/*==================[external functions definition]==========================*/
+void NeoPixelFxRenderInit(neopixel_color_t *frame, uint16_t len){
+	fx_frame = frame;
+	fx_len = len;
+	for(uint16_t h = 0; h < HUE_LUT_SIZE; h++){
+		hue_lut[h] = NeoPixelHSV2Color(h << 8, 255, 255);
+	}
+	for(uint8_t l = 0; l < NEOPIXEL_FX_LAYERS; l++){
+		layers[l].fx.type = NEOPIXEL_FX_NONE;
+	}
+}
+
+bool NeoPixelFxRenderSetLayer(uint8_t layer, const neopixel_fx_t *fx){
+	fx_layer_t state = {
+		.fx = *fx,
+	};
+	if((layer >= NEOPIXEL_FX_LAYERS) || (fx_len == 0)){
+		return false;
+	}
+	if((fx->type == NEOPIXEL_FX_CHASE) && (fx->size == 0)){
+		return false;
+	}
+	/* A cycle of 0 frames is taken as 1 frame */
+	state.phase_step = (fx->period > 1) ? (uint32_t)((PHASE_TURN + fx->period - 1) / fx->period) : 0;
+	if(fx->type == NEOPIXEL_FX_RAINBOW){
+		state.hue_step = (uint32_t)((PHASE_TURN * fx->reps) / fx_len);
+		uint16_t s1 = 1 + fx->sat;
+		uint8_t s2 = 255 - fx->sat;
+		uint16_t v1 = 1 + fx->val;
+		for(uint16_t c = 0; c < 256; c++){
+			state.sv_lut[c] = ((((c * s1) >> 8) + s2) * v1) >> 8;
+		}
+	}
+	layers[layer] = state;
+	return true;
+}
+
+void NeoPixelFxRenderClearLayer(uint8_t layer){
+	if(layer < NEOPIXEL_FX_LAYERS){
+		layers[layer].fx.type = NEOPIXEL_FX_NONE;
+	}
+}
+
+void NeoPixelFxRenderFrame(void){
+	for(uint8_t l = 0; l < NEOPIXEL_FX_LAYERS; l++){
+		fx_layer_t *layer = &layers[l];
+		switch(layer->fx.type){
+			case NEOPIXEL_FX_RAINBOW:
+				NeoPixelFxRainbow(layer);
+			break;
+			case NEOPIXEL_FX_CHASE:
+				NeoPixelFxChase(layer);
+			break;
+			case NEOPIXEL_FX_FADE:
+				if(layer->cycles > 0){
+					NeoPixelFxFill(layer, layer->fx.color_end);
+				} else{
+					NeoPixelFxFill(layer, NeoPixelFxMix(layer->fx.color, layer->fx.color_end, (layer->phase >> 24) + 1));
+				}
+			break;
+			case NEOPIXEL_FX_BREATHE:
+				NeoPixelFxFill(layer, NeoPixelFxScale(layer->fx.color, NeoPixelFxTriangle(layer->phase) + 1));
+			break;
+			case NEOPIXEL_FX_SPARKLE:
+				NeoPixelFxSparkle(layer);
+			break;
+			default:
+				continue;
+		}
+		NeoPixelFxAdvance(layer);
+	}
+}
+
+neopixel_color_t *NeoPixelFxRenderGetFrame(void){
+	return fx_frame;
+}
+
+/*==================[end of file]============================================*/
@@ -11,7 +11,11 @@
 
 /*==================[inclusions]=============================================*/
 #include "neopixel_stripe.h"
+#include <stdlib.h>
+#include <string.h>
 #include "ws2812b.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 /*==================[macros and definitions]=================================*/
 #define RED_MSK         0x00FF0000
 #define GREEN_MSK       0x0000FF00
@@ -21,38 +25,119 @@
 #define BLUE_OFFSET     0
 #define MAX_BRIGHT  	255
 #define BRIGHT_OFFSET   8
+#define LED_BYTES       3
+#define FRAMES_QTY      (WS2812B_QUEUE_DEPTH + 1)   /* one more than queued frames, so the one being filled is never on the wire */
 /*==================[internal data declaration]==============================*/
 uint16_t stripe_length;
 uint8_t stripe_bright = MAX_BRIGHT;
 neopixel_color_t *stripe_colors; 
+uint8_t *stripe_frames[FRAMES_QTY];
+uint8_t stripe_next_frame = 0;
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
-
+static uint8_t *stripe_encoded = NULL;		/*!< Colors with brightness and gamma applied, in wire order (G, R, B) */
+static uint8_t stripe_lut[256];				/*!< Component -> wire byte, for the current brightness */
+static uint16_t dirty_len = 0;				/*!< Leds (from the first one) that must be sent */
+static uint16_t refresh_period = 0;			/*!< Minimum time between frames (ms), 0: send on each change */
+static TaskHandle_t refresh_task = NULL;	/*!< Refresh task */
+static portMUX_TYPE stripe_lock = portMUX_INITIALIZER_UNLOCKED;
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static uint8_t *NeoPixelNextFrame(void){
+	uint8_t *frame = stripe_frames[stripe_next_frame];
+	stripe_next_frame = (stripe_next_frame + 1) % FRAMES_QTY;
+	return frame;
+}
+
+static void NeoPixelUpdateLut(void){
+	for (uint16_t c = 0; c < 256; c++){
+		stripe_lut[c] = ws2812bGammaCorrection((c * stripe_bright) >> BRIGHT_OFFSET);
+	}
+}
+
+static void NeoPixelEncode(uint16_t pixel, neopixel_color_t color){
+	uint8_t *led = &stripe_encoded[pixel * LED_BYTES];
+	led[0] = stripe_lut[(color & GREEN_MSK) >> GREEN_OFFSET];
+	led[1] = stripe_lut[(color & RED_MSK) >> RED_OFFSET];
+	led[2] = stripe_lut[(color & BLUE_MSK) >> BLUE_OFFSET];
+}
+
+/**
+ * @brief Sends the dirty part of the stripe.
+ *
+ * Leds are chained, so data always starts at the first led: the dirty range
+ * is [0, dirty_len) and leds after it keep their previous color.
+ */
+static void NeoPixelFlush(void){
+	uint8_t *frame;
+	uint16_t len;
+
+	portENTER_CRITICAL(&stripe_lock);
+	len = dirty_len;
+	if(len > 0){
+		frame = NeoPixelNextFrame();
+		memcpy(frame, stripe_encoded, len * LED_BYTES);
+		dirty_len = 0;
+	}
+	portEXIT_CRITICAL(&stripe_lock);
+	if(len > 0){
+		ws2812bSendFrame(frame, len);
+	}
+}
+
+/**
+ * @brief Marks leds [0, last] to be sent, and sends them (or wakes up the refresh task).
+ */
+static void NeoPixelMarkDirty(uint16_t last){
+	portENTER_CRITICAL(&stripe_lock);
+	if(last + 1 > dirty_len){
+		dirty_len = last + 1;
+	}
+	portEXIT_CRITICAL(&stripe_lock);
+	if(refresh_task != NULL){
+		xTaskNotifyGive(refresh_task);
+	} else{
+		NeoPixelFlush();
+	}
+}
+
+static void NeoPixelRefreshTask(void *param){
+	TickType_t last_frame = xTaskGetTickCount() - pdMS_TO_TICKS(refresh_period);
+	while(true){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		TickType_t elapsed = xTaskGetTickCount() - last_frame;
+		if(elapsed < pdMS_TO_TICKS(refresh_period)){
+			/* Changes made while waiting go out in the same frame */
+			vTaskDelay(pdMS_TO_TICKS(refresh_period) - elapsed);
+		}
+		last_frame = xTaskGetTickCount();
+		NeoPixelFlush();
+	}
+}
 
 /*==================[external functions definition]==========================*/
 
 void NeoPixelInit(gpio_t pin, uint16_t len, neopixel_color_t *color_array){
     stripe_length = len;
 	stripe_colors = color_array;
+	for (uint8_t i = 0; i < FRAMES_QTY; i++){
+		free(stripe_frames[i]);
+		stripe_frames[i] = malloc(len * LED_BYTES);
+	}
+	free(stripe_encoded);
+	stripe_encoded = calloc(len, LED_BYTES);
+	dirty_len = 0;
+	NeoPixelUpdateLut();
     ws2812bInit(pin);
 }
 
 void NeoPixelAllOff(void){
-    rgb_led_t led;
-	ws2812bSendRet();
-	ws2812bSendRet();
-	ws2812bSendRet();
-	for (uint16_t i = 0; i < stripe_length; i++){
-		led.red = 0;
-		led.green = 0;
-		led.blue = 0;
-		ws2812bSend(led);
-	}
-	ws2812bSendRet();
+	portENTER_CRITICAL(&stripe_lock);
+	memset(stripe_encoded, 0, stripe_length * LED_BYTES);
+	portEXIT_CRITICAL(&stripe_lock);
+	NeoPixelMarkDirty(stripe_length - 1);
 }
 
 void NeoPixelAllColor(neopixel_color_t color){
@@ -64,109 +149,85 @@ void NeoPixelAllColor(neopixel_color_t color){
 
 void NeoPixelSetPixel(uint16_t pixel, neopixel_color_t color){
 	stripe_colors[pixel] = color;
-	NeoPixelSetArray(stripe_colors);
+	NeoPixelEncode(pixel, color);
+	NeoPixelMarkDirty(pixel);
 }
 
 void NeoPixelSetArray(neopixel_color_t *color_array){
-    rgb_led_t led;
-	uint16_t red, green, blue;
-	ws2812bSendRet();
-	ws2812bSendRet();
-	ws2812bSendRet();
 	for (uint16_t i = 0; i < stripe_length; i++){
-		red = ((color_array[i] & RED_MSK) >> RED_OFFSET) * stripe_bright;
-		green = ((color_array[i] & GREEN_MSK) >> GREEN_OFFSET) * stripe_bright;
-		blue = ((color_array[i] & BLUE_MSK) >> BLUE_OFFSET) * stripe_bright;
-		led.red = red >> BRIGHT_OFFSET;
-		led.green = green >> BRIGHT_OFFSET;
-		led.blue = blue >> BRIGHT_OFFSET;
-		ws2812bSend(led);
+		NeoPixelEncode(i, color_array[i]);
+	}
+	NeoPixelMarkDirty(stripe_length - 1);
+}
+
+void NeoPixelSetDoneCallback(void *ptr_done_func, void *args){
+	ws2812bSetDoneCallback(ptr_done_func, args);
+}
+
+bool NeoPixelWaitDone(uint32_t timeout_ms){
+	return ws2812bWaitDone(timeout_ms);
+}
+
+bool NeoPixelSetRefreshPeriod(uint16_t period_ms){
+	refresh_period = period_ms;
+	if((period_ms > 0) && (refresh_task == NULL)){
+		if(xTaskCreate(&NeoPixelRefreshTask, "neopixel", 2048, NULL, 5, &refresh_task) != pdPASS){
+			refresh_task = NULL;
+			return false;
+		}
+	}
+	if((period_ms == 0) && (refresh_task != NULL)){
+		vTaskDelete(refresh_task);
+		refresh_task = NULL;
+		NeoPixelFlush();
 	}
-	ws2812bSendRet();
+	return true;
 }
 
 void NeoPixelShift(bool upwards){
 	neopixel_color_t carry;
+	uint8_t carry_led[LED_BYTES];
+	uint16_t last = stripe_length - 1;
 
 	if(upwards){
-		carry = stripe_colors[stripe_length-1];
-		for (uint16_t i = 0; i < stripe_length-1; i++){
-			stripe_colors[stripe_length-1-i] = stripe_colors[stripe_length-2-i]; 
-		}
+		carry = stripe_colors[last];
+		memmove(&stripe_colors[1], &stripe_colors[0], last * sizeof(neopixel_color_t));
 		stripe_colors[0] = carry;
 	}else{
 		carry = stripe_colors[0];
-		for (uint16_t i = 0; i < stripe_length-1; i++){
-			stripe_colors[i] = stripe_colors[i+1]; 
-		}
-		stripe_colors[stripe_length-1] = carry;
+		memmove(&stripe_colors[0], &stripe_colors[1], last * sizeof(neopixel_color_t));
+		stripe_colors[last] = carry;
 	}
-	NeoPixelSetArray(stripe_colors);
+	/* The encoded frame is rotated too, no need to encode it again */
+	portENTER_CRITICAL(&stripe_lock);
+	if(upwards){
+		memcpy(carry_led, &stripe_encoded[last * LED_BYTES], LED_BYTES);
+		memmove(&stripe_encoded[LED_BYTES], &stripe_encoded[0], last * LED_BYTES);
+		memcpy(&stripe_encoded[0], carry_led, LED_BYTES);
+	}else{
+		memcpy(carry_led, &stripe_encoded[0], LED_BYTES);
+		memmove(&stripe_encoded[0], &stripe_encoded[LED_BYTES], last * LED_BYTES);
+		memcpy(&stripe_encoded[last * LED_BYTES], carry_led, LED_BYTES);
+	}
+	portEXIT_CRITICAL(&stripe_lock);
+	NeoPixelMarkDirty(last);
 }
 
 void NeoPixelBrightness(uint8_t bright){
 	stripe_bright = bright;
+	NeoPixelUpdateLut();
 	NeoPixelSetArray(stripe_colors);
 }
 
 void NeoPixelRainbow(uint16_t first_hue, uint8_t sat, uint8_t val, uint8_t reps){
+	/* Hue in the upper 16 bits, incremented by a fixed step on each led */
+	uint32_t hue = (uint32_t)first_hue << 16;
+	uint32_t step = (uint32_t)(((uint64_t)reps << 32) / stripe_length);
 	for (uint16_t i=0; i<stripe_length; i++) {
-		uint16_t hue = first_hue + (i * reps * 65536) / stripe_length;
-		neopixel_color_t color = NeoPixelHSV2Color(hue, sat, val);
-		stripe_colors[i] = color;
+		stripe_colors[i] = NeoPixelHSV2Color(hue >> 16, sat, val);
+		hue += step;
   	}
 	NeoPixelSetArray(stripe_colors);
 }
 
-neopixel_color_t NeoPixelRgb2Color(uint8_t red, uint8_t green, uint8_t blue){
-	return (red << RED_OFFSET) | (green << GREEN_OFFSET) | (blue << BLUE_OFFSET);
-}
-
-neopixel_color_t NeoPixelHSV2Color(uint16_t hue, uint8_t sat, uint8_t val){
-
-  uint8_t r, g, b;
-
-  hue = (hue * 1530L + 32768) / 65536;
-  // Convert hue to R,G,B (nested ifs faster than divide+mod+switch):
-  if (hue < 510) { // Red to Green-1
-    b = 0;
-    if (hue < 255) { //   Red to Yellow-1
-      r = 255;
-      g = hue;       //     g = 0 to 254
-    } else {         //   Yellow to Green-1
-      r = 510 - hue; //     r = 255 to 1
-      g = 255;
-    }
-  } else if (hue < 1020) { // Green to Blue-1
-    r = 0;
-    if (hue < 765) { //   Green to Cyan-1
-      g = 255;
-      b = hue - 510;  //     b = 0 to 254
-    } else {          //   Cyan to Blue-1
-      g = 1020 - hue; //     g = 255 to 1
-      b = 255;
-    }
-  } else if (hue < 1530) { // Blue to Red-1
-    g = 0;
-    if (hue < 1275) { //   Blue to Magenta-1
-      r = hue - 1020; //     r = 0 to 254
-      b = 255;
-    } else { //   Magenta to Red-1
-      r = 255;
-      b = 1530 - hue; //     b = 255 to 1
-    }
-  } else { // Last 0.5 Red (quicker than % operator)
-    r = 255;
-    g = b = 0;
-  }
-
-  // Apply saturation and value to R,G,B, pack into 32-bit result:
-  uint32_t v1 = 1 + val;  // 1 to 256; allows >>8 instead of /255
-  uint16_t s1 = 1 + sat;  // 1 to 256; same reason
-  uint8_t s2 = 255 - sat; // 255 to 0
-  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
-         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
-         (((((b * s1) >> 8) + s2) * v1) >> 8);
-}
-
 /*==================[end of file]============================================*/
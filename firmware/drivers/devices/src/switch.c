@@ -12,18 +12,89 @@
 /*==================[inclusions]=============================================*/
 #include "switch.h"
 #include "gpio_mcu.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 /*==================[macros and definitions]=================================*/
 #define GPIO_SWITCH1 GPIO_4
 #define GPIO_SWITCH2 GPIO_15
+#define MSEC		1000	/*!< 1msec = 1000usec */
 /*==================[internal data declaration]==============================*/
-
+/**
+ * @brief State of each key handled by the event service
+ */
+typedef struct {
+	gpio_t pin;				/*!< GPIO where the key is connected */
+	uint8_t key;			/*!< Key id reported in the events */
+	uint16_t integrator;	/*!< Debounce integrator (0: released, debounce_samples: pressed) */
+	bool pressed;			/*!< Debounced state */
+	bool long_sent;			/*!< Long-press already reported for this press */
+	uint32_t held;			/*!< Samples since the key was pressed */
+	uint32_t next_repeat;	/*!< Held count for the next repeat event */
+} switch_key_t;
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
+static switch_key_t keys[SWITCH_EVENTS_MAX_KEYS];	/*!< Keys handled by the event service */
+static uint8_t keys_qty = 0;						/*!< Number of keys in use */
+static uint16_t debounce_samples;					/*!< Samples needed to change a key state */
+static uint32_t long_press_samples;					/*!< Samples to report a long-press (0: disabled) */
+static uint32_t repeat_samples;						/*!< Samples between repeats (0: disabled) */
+static uint16_t sample_period;						/*!< Sample period (in ms) */
+static QueueHandle_t event_queue = NULL;			/*!< Events queue */
+static esp_timer_handle_t sample_timer = NULL;		/*!< Timer used to sample every key */
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void SwitchEventsPost(switch_key_t *k, switch_event_type_t type){
+	switch_event_t event = {
+		.key = k->key,
+		.type = type,
+		.timestamp = (uint32_t)(esp_timer_get_time() / MSEC),
+	};
+	/* If the queue is full the event is lost, the sampling must not block */
+	xQueueSend(event_queue, &event, 0);
+}
+
+/**
+ * @brief Samples and debounces every key. Runs in the esp_timer task, not in
+ * an ISR, so it can use the queue API freely.
+ */
+static void SwitchEventsSample(void *param){
+	for(uint8_t i = 0; i < keys_qty; i++){
+		switch_key_t *k = &keys[i];
+		bool active = !GPIORead(k->pin);
+		/* Integrating debounce: the state only changes when the integrator saturates */
+		if(active){
+			if(k->integrator < debounce_samples){
+				k->integrator++;
+			}
+		} else if(k->integrator > 0){
+			k->integrator--;
+		}
+		if(!k->pressed && (k->integrator == debounce_samples)){
+			k->pressed = true;
+			k->long_sent = false;
+			k->held = 0;
+			k->next_repeat = long_press_samples ? long_press_samples + repeat_samples : repeat_samples;
+			SwitchEventsPost(k, SWITCH_EV_PRESS);
+		} else if(k->pressed && (k->integrator == 0)){
+			k->pressed = false;
+			SwitchEventsPost(k, SWITCH_EV_RELEASE);
+		} else if(k->pressed){
+			k->held++;
+			if(long_press_samples && !k->long_sent && (k->held >= long_press_samples)){
+				k->long_sent = true;
+				SwitchEventsPost(k, SWITCH_EV_LONG_PRESS);
+			}
+			if(repeat_samples && (k->held >= k->next_repeat)){
+				k->next_repeat += repeat_samples;
+				SwitchEventsPost(k, SWITCH_EV_REPEAT);
+			}
+		}
+	}
+}
 
 /*==================[external functions definition]==========================*/
 int8_t SwitchesInit(void){
@@ -54,4 +125,63 @@ void SwitchActivInt(switch_t sw, void *ptr_int_func, void *args){
 		break;
 	}
 }
+
+int8_t SwitchEventsInit(switch_events_config_t *config){
+	if((config->sample_period_ms == 0) || (sample_timer != NULL)){
+		return false;
+	}
+	sample_period = config->sample_period_ms;
+	debounce_samples = (config->debounce_ms + sample_period - 1) / sample_period;
+	if(debounce_samples == 0){
+		debounce_samples = 1;
+	}
+	long_press_samples = config->long_press_ms / sample_period;
+	repeat_samples = config->repeat_ms / sample_period;
+
+	event_queue = xQueueCreate(SWITCH_EVENTS_QUEUE_SIZE, sizeof(switch_event_t));
+	if(event_queue == NULL){
+		return false;
+	}
+	SwitchEventsAddKey(GPIO_SWITCH1, SWITCH_1);
+	SwitchEventsAddKey(GPIO_SWITCH2, SWITCH_2);
+
+	const esp_timer_create_args_t timer_args = {
+		.callback = SwitchEventsSample,
+		.arg = NULL,
+		.dispatch_method = ESP_TIMER_TASK,
+		.name = "switch_events",
+	};
+	if(esp_timer_create(&timer_args, &sample_timer) != ESP_OK){
+		return false;
+	}
+	esp_timer_start_periodic(sample_timer, (uint64_t)sample_period * MSEC);
+	return true;
+}
+
+int8_t SwitchEventsAddKey(gpio_t pin, uint8_t key){
+	if(keys_qty >= SWITCH_EVENTS_MAX_KEYS){
+		return false;
+	}
+	GPIOInit(pin, GPIO_INPUT);
+	/* Hardware glitch filter in front of the debounce (only the first FILTER_QTY pins get one) */
+	GPIOInputFilter(pin);
+	/* The key is fully set up before it becomes visible to the sampling callback */
+	keys[keys_qty] = (switch_key_t){
+		.pin = pin,
+		.key = key,
+	};
+	keys_qty++;
+	return true;
+}
+
+bool SwitchEventsGet(switch_event_t *event, uint32_t timeout_ms){
+	TickType_t ticks = portMAX_DELAY;
+	if(event_queue == NULL){
+		return false;
+	}
+	if(timeout_ms != SWITCH_EVENTS_NO_TIMEOUT){
+		ticks = pdMS_TO_TICKS(timeout_ms);
+	}
+	return (xQueueReceive(event_queue, event, ticks) == pdTRUE);
+}
 /*==================[end of file]============================================*/
@@ -11,20 +11,46 @@
 
 /*==================[inclusions]=============================================*/
 #include "ws2812b.h"
+#include <stdlib.h>
 #include "gpio_mcu.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "gpio_fast_out_mcu.h"
-#include "delay_mcu.h"
+#include "driver/rmt_tx.h"
+#include "soc/soc_caps.h"
 /*==================[macros and definitions]=================================*/
-#define RET_CMD (50)    // ret command 50us low
-#define BIT_0   (1)     // bit 0
-#define BIT_7   (1<<7)  // bit 0
+#define RET_CMD         (50)        // ret command 50us low
+#define RMT_RES_HZ      10000000    // RMT tick: 0.1us
+#define T0H_TICKS       4           // bit 0: 0.4us high
+#define T0L_TICKS       9           //        0.85us low
+#define T1H_TICKS       8           // bit 1: 0.8us high
+#define T1L_TICKS       5           //        0.45us low
+#define RET_TICKS       (RET_CMD * (RMT_RES_HZ / 1000000) / 2)  // each half of the reset symbol
+#define LED_BYTES       3           // G, R, B
+#define PENDING_GROW    16          // leds added to the ws2812bSend() buffer when it's full
+#if SOC_RMT_SUPPORT_DMA
+#define RMT_MEM_SYMBOLS 1024        // DMA buffer
+#else
+#define RMT_MEM_SYMBOLS (2 * SOC_RMT_MEM_WORDS_PER_CHANNEL) // ping-pong refilled from the RMT ISR
+#endif
 /*==================[internal data declaration]==============================*/
-gpio_t pin_number;
+/**
+ * @brief Encoder for a frame: bytes of the leds followed by the reset code
+ */
+typedef struct {
+    rmt_encoder_t base;
+    rmt_encoder_t *bytes_encoder;
+    rmt_encoder_t *copy_encoder;
+    uint8_t state;
+    rmt_symbol_word_t reset_code;
+} ws2812b_encoder_t;
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
+static rmt_channel_handle_t channel = NULL;     /*!< RMT TX channel */
+static ws2812b_encoder_t encoder;               /*!< Frame encoder */
+static void (*volatile done_func)(void *) = NULL; /*!< Called when a frame was sent */
+static void *done_args = NULL;                  /*!< Arguments of done_func */
+static uint8_t *pending = NULL;                 /*!< Colors accumulated by ws2812bSend() */
+static uint16_t pending_len = 0;                /*!< Leds in pending */
+static uint16_t pending_size = 0;               /*!< Capacity of pending (in leds) */
 static const uint8_t gamma_table[256] = {
     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
     0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,
@@ -47,330 +73,165 @@ static const uint8_t gamma_table[256] = {
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
-void IRAM_ATTR ws2812bSendHigh(gpio_t pin){
-    GPIOFastWrite(1);
-    //delay 0.8us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
-    __asm__ __volatile__ ("nop");   // 28
-    __asm__ __volatile__ ("nop");   // 29
-    __asm__ __volatile__ ("nop");   // 30
-    __asm__ __volatile__ ("nop");   // 31
-    __asm__ __volatile__ ("nop");   // 32
-    __asm__ __volatile__ ("nop");   // 33
-    __asm__ __volatile__ ("nop");   // 34
-    __asm__ __volatile__ ("nop");   // 35
-    __asm__ __volatile__ ("nop");   // 36
-    __asm__ __volatile__ ("nop");   // 37
-    __asm__ __volatile__ ("nop");   // 38
-    __asm__ __volatile__ ("nop");   // 39
-    __asm__ __volatile__ ("nop");   // 40
-    __asm__ __volatile__ ("nop");   // 41
-    __asm__ __volatile__ ("nop");   // 42
-    __asm__ __volatile__ ("nop");   // 43
-    __asm__ __volatile__ ("nop");   // 44
-    __asm__ __volatile__ ("nop");   // 45
-    __asm__ __volatile__ ("nop");   // 46
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 48
-    __asm__ __volatile__ ("nop");   // 49
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 60
-    __asm__ __volatile__ ("nop");   // 61
-    __asm__ __volatile__ ("nop");   // 62
-    __asm__ __volatile__ ("nop");   // 63
-    __asm__ __volatile__ ("nop");   // 64
-    __asm__ __volatile__ ("nop");   // 65
-    __asm__ __volatile__ ("nop");   // 66
-    __asm__ __volatile__ ("nop");   // 67
-    __asm__ __volatile__ ("nop");   // 68
-    __asm__ __volatile__ ("nop");   // 69
-    __asm__ __volatile__ ("nop");   // 70
-    __asm__ __volatile__ ("nop");   // 71
-    __asm__ __volatile__ ("nop");   // 72
-    __asm__ __volatile__ ("nop");   // 73
-    __asm__ __volatile__ ("nop");   // 74
-    __asm__ __volatile__ ("nop");   // 75
-    __asm__ __volatile__ ("nop");   // 76
-    __asm__ __volatile__ ("nop");   // 77
-    __asm__ __volatile__ ("nop");   // 78
-    __asm__ __volatile__ ("nop");   // 79
-    __asm__ __volatile__ ("nop");   // 80
-    __asm__ __volatile__ ("nop");   // 81
-    __asm__ __volatile__ ("nop");   // 82
-    __asm__ __volatile__ ("nop");   // 83
-    __asm__ __volatile__ ("nop");   // 84
-    __asm__ __volatile__ ("nop");   // 85
-    __asm__ __volatile__ ("nop");   // 86
-    __asm__ __volatile__ ("nop");   // 87
-    __asm__ __volatile__ ("nop");   // 88
-    __asm__ __volatile__ ("nop");   // 89
-    __asm__ __volatile__ ("nop");   // 90
-    __asm__ __volatile__ ("nop");   // 91
-    
-    GPIOFastWrite(0);
-	//delay 0.45us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
-    __asm__ __volatile__ ("nop");   // 28
-    __asm__ __volatile__ ("nop");   // 29
+static size_t ws2812bEncode(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                            const void *data, size_t data_size, rmt_encode_state_t *ret_state){
+    ws2812b_encoder_t *enc = __containerof(encoder, ws2812b_encoder_t, base);
+    rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+    rmt_encode_state_t state = RMT_ENCODING_RESET;
+    size_t encoded_symbols = 0;
+
+    switch(enc->state){
+        case 0:
+            // Leds data
+            encoded_symbols += enc->bytes_encoder->encode(enc->bytes_encoder, channel, data, data_size, &session_state);
+            if(session_state & RMT_ENCODING_COMPLETE){
+                enc->state = 1;
+            }
+            if(session_state & RMT_ENCODING_MEM_FULL){
+                state |= RMT_ENCODING_MEM_FULL;
+                break;
+            }
+        // fall-through
+        case 1:
+            // Ret command
+            encoded_symbols += enc->copy_encoder->encode(enc->copy_encoder, channel, &enc->reset_code,
+                                                         sizeof(enc->reset_code), &session_state);
+            if(session_state & RMT_ENCODING_COMPLETE){
+                enc->state = 0;
+                state |= RMT_ENCODING_COMPLETE;
+            }
+            if(session_state & RMT_ENCODING_MEM_FULL){
+                state |= RMT_ENCODING_MEM_FULL;
+            }
+        break;
+    }
+    *ret_state = state;
+    return encoded_symbols;
 }
 
-void IRAM_ATTR ws2812bSendLow(gpio_t pin){
-    GPIOFastWrite(1);
-    //delay 0.4us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
+static esp_err_t ws2812bEncoderReset(rmt_encoder_t *encoder){
+    ws2812b_encoder_t *enc = __containerof(encoder, ws2812b_encoder_t, base);
+    rmt_encoder_reset(enc->bytes_encoder);
+    rmt_encoder_reset(enc->copy_encoder);
+    enc->state = 0;
+    return ESP_OK;
+}
 
-    GPIOFastWrite(0);
-	//delay 0.85us
-    __asm__ __volatile__ ("nop");   // 1
-    __asm__ __volatile__ ("nop");   // 2
-    __asm__ __volatile__ ("nop");   // 3
-    __asm__ __volatile__ ("nop");   // 4
-    __asm__ __volatile__ ("nop");   // 5
-    __asm__ __volatile__ ("nop");   // 6
-    __asm__ __volatile__ ("nop");   // 7
-    __asm__ __volatile__ ("nop");   // 8
-    __asm__ __volatile__ ("nop");   // 9
-    __asm__ __volatile__ ("nop");   // 10
-    __asm__ __volatile__ ("nop");   // 11
-    __asm__ __volatile__ ("nop");   // 12
-    __asm__ __volatile__ ("nop");   // 13
-    __asm__ __volatile__ ("nop");   // 14
-    __asm__ __volatile__ ("nop");   // 15
-    __asm__ __volatile__ ("nop");   // 16
-    __asm__ __volatile__ ("nop");   // 17
-    __asm__ __volatile__ ("nop");   // 18
-    __asm__ __volatile__ ("nop");   // 19
-    __asm__ __volatile__ ("nop");   // 20
-    __asm__ __volatile__ ("nop");   // 21
-    __asm__ __volatile__ ("nop");   // 22
-    __asm__ __volatile__ ("nop");   // 23
-    __asm__ __volatile__ ("nop");   // 24  
-    __asm__ __volatile__ ("nop");   // 25
-    __asm__ __volatile__ ("nop");   // 26
-    __asm__ __volatile__ ("nop");   // 27
-    __asm__ __volatile__ ("nop");   // 28
-    __asm__ __volatile__ ("nop");   // 29
-    __asm__ __volatile__ ("nop");   // 30
-    __asm__ __volatile__ ("nop");   // 31
-    __asm__ __volatile__ ("nop");   // 32
-    __asm__ __volatile__ ("nop");   // 33
-    __asm__ __volatile__ ("nop");   // 34
-    __asm__ __volatile__ ("nop");   // 35
-    __asm__ __volatile__ ("nop");   // 36
-    __asm__ __volatile__ ("nop");   // 37
-    __asm__ __volatile__ ("nop");   // 38
-    __asm__ __volatile__ ("nop");   // 39
-    __asm__ __volatile__ ("nop");   // 40
-    __asm__ __volatile__ ("nop");   // 41
-    __asm__ __volatile__ ("nop");   // 42
-    __asm__ __volatile__ ("nop");   // 43
-    __asm__ __volatile__ ("nop");   // 44
-    __asm__ __volatile__ ("nop");   // 45
-    __asm__ __volatile__ ("nop");   // 46
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 48
-    __asm__ __volatile__ ("nop");   // 49
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 47
-    __asm__ __volatile__ ("nop");   // 50
-    __asm__ __volatile__ ("nop");   // 51
-    __asm__ __volatile__ ("nop");   // 52
-    __asm__ __volatile__ ("nop");   // 53
-    __asm__ __volatile__ ("nop");   // 54
-    __asm__ __volatile__ ("nop");   // 55
-    __asm__ __volatile__ ("nop");   // 56
-    __asm__ __volatile__ ("nop");   // 57
-    __asm__ __volatile__ ("nop");   // 58
-    __asm__ __volatile__ ("nop");   // 59
-    __asm__ __volatile__ ("nop");   // 60
-    __asm__ __volatile__ ("nop");   // 61
-    __asm__ __volatile__ ("nop");   // 62
-    __asm__ __volatile__ ("nop");   // 63
-    __asm__ __volatile__ ("nop");   // 64
-    __asm__ __volatile__ ("nop");   // 65
-    __asm__ __volatile__ ("nop");   // 66
-    __asm__ __volatile__ ("nop");   // 67
-    __asm__ __volatile__ ("nop");   // 68
-    __asm__ __volatile__ ("nop");   // 69
-    __asm__ __volatile__ ("nop");   // 70
-    __asm__ __volatile__ ("nop");   // 71
-    __asm__ __volatile__ ("nop");   // 72
-    __asm__ __volatile__ ("nop");   // 73
-    __asm__ __volatile__ ("nop");   // 74
-    __asm__ __volatile__ ("nop");   // 75
-    __asm__ __volatile__ ("nop");   // 76
-    __asm__ __volatile__ ("nop");   // 77
-    __asm__ __volatile__ ("nop");   // 78
-    __asm__ __volatile__ ("nop");   // 79
-    __asm__ __volatile__ ("nop");   // 80
-    __asm__ __volatile__ ("nop");   // 81
-    __asm__ __volatile__ ("nop");   // 82
-    __asm__ __volatile__ ("nop");   // 83
-    __asm__ __volatile__ ("nop");   // 84
-    __asm__ __volatile__ ("nop");   // 85
-    __asm__ __volatile__ ("nop");   // 86
-    __asm__ __volatile__ ("nop");   // 87
-    __asm__ __volatile__ ("nop");   // 88
-    __asm__ __volatile__ ("nop");   // 89
-    __asm__ __volatile__ ("nop");   // 90
-    __asm__ __volatile__ ("nop");   // 91
-    __asm__ __volatile__ ("nop");   // 92
-    __asm__ __volatile__ ("nop");   // 93
-    __asm__ __volatile__ ("nop");   // 94
+static esp_err_t ws2812bEncoderDel(rmt_encoder_t *encoder){
+    ws2812b_encoder_t *enc = __containerof(encoder, ws2812b_encoder_t, base);
+    rmt_del_encoder(enc->bytes_encoder);
+    rmt_del_encoder(enc->copy_encoder);
+    return ESP_OK;
 }
 
-uint8_t ws2812bGammaCorrection(uint8_t component){
-    return gamma_table[component];
+static bool IRAM_ATTR ws2812bTransDone(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *edata, void *user_ctx){
+    if(done_func != NULL){
+        done_func(done_args);
+    }
+    return false;
 }
 
 /*==================[external functions definition]==========================*/
 
 void ws2812bInit(gpio_t pin){
-    pin_number = pin;
-    GPIOFastInit(&pin, 1);
+    rmt_tx_channel_config_t channel_config = {
+        .gpio_num = pin,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = RMT_RES_HZ,
+        .mem_block_symbols = RMT_MEM_SYMBOLS,
+        .trans_queue_depth = WS2812B_QUEUE_DEPTH,
+#if SOC_RMT_SUPPORT_DMA
+        .flags.with_dma = true,
+#endif
+    };
+    rmt_bytes_encoder_config_t bytes_config = {
+        .bit0 = {
+            .level0 = 1,
+            .duration0 = T0H_TICKS,
+            .level1 = 0,
+            .duration1 = T0L_TICKS,
+        },
+        .bit1 = {
+            .level0 = 1,
+            .duration0 = T1H_TICKS,
+            .level1 = 0,
+            .duration1 = T1L_TICKS,
+        },
+        .flags.msb_first = 1,
+    };
+    rmt_copy_encoder_config_t copy_config = {};
+    rmt_tx_event_callbacks_t callbacks = {
+        .on_trans_done = ws2812bTransDone,
+    };
+
+    if(channel != NULL){
+        return;
+    }
+    ESP_ERROR_CHECK(rmt_new_tx_channel(&channel_config, &channel));
+    encoder.base.encode = ws2812bEncode;
+    encoder.base.reset = ws2812bEncoderReset;
+    encoder.base.del = ws2812bEncoderDel;
+    encoder.state = 0;
+    encoder.reset_code = (rmt_symbol_word_t){
+        .level0 = 0,
+        .duration0 = RET_TICKS,
+        .level1 = 0,
+        .duration1 = RET_TICKS,
+    };
+    ESP_ERROR_CHECK(rmt_new_bytes_encoder(&bytes_config, &encoder.bytes_encoder));
+    ESP_ERROR_CHECK(rmt_new_copy_encoder(&copy_config, &encoder.copy_encoder));
+    ESP_ERROR_CHECK(rmt_tx_register_event_callbacks(channel, &callbacks, NULL));
+    ESP_ERROR_CHECK(rmt_enable(channel));
 }
 
 void ws2812bSend(rgb_led_t led_color){
-    uint8_t i;
-	// Blue
-	for(i=0; i<=7; i++){
-        if(ws2812bGammaCorrection(led_color.green) & (BIT_7>>i)){
-            ws2812bSendHigh(pin_number);
-        }
-        else{
-            ws2812bSendLow(pin_number);
+    if(pending_len == pending_size){
+        uint8_t *buf = realloc(pending, (pending_size + PENDING_GROW) * LED_BYTES);
+        if(buf == NULL){
+            return;
         }
+        pending = buf;
+        pending_size += PENDING_GROW;
     }
-	// Red
-    for(i=0; i<=7; i++){
-        if(ws2812bGammaCorrection(led_color.red) & (BIT_7>>i)){
-            ws2812bSendHigh(pin_number);
-        }
-        else{
-            ws2812bSendLow(pin_number);
-        }
+    pending[pending_len * LED_BYTES] = ws2812bGammaCorrection(led_color.green);
+    pending[pending_len * LED_BYTES + 1] = ws2812bGammaCorrection(led_color.red);
+    pending[pending_len * LED_BYTES + 2] = ws2812bGammaCorrection(led_color.blue);
+    pending_len++;
+}
+
+void ws2812bSendRet(void){
+    if(pending_len > 0){
+        ws2812bSendFrame(pending, pending_len);
+        pending_len = 0;
     }
-	// Green
-    for(i=0; i<=7; i++){
-        if(ws2812bGammaCorrection(led_color.blue) & (BIT_7>>i)){
-            ws2812bSendHigh(pin_number);
-        }
-        else{
-            ws2812bSendLow(pin_number);
-        }
+    ws2812bWaitDone(WS2812B_NO_TIMEOUT);
+}
+
+bool ws2812bSendFrame(const uint8_t *data, uint16_t len){
+    rmt_transmit_config_t tx_config = {
+        .loop_count = 0,
+    };
+    if((channel == NULL) || (len == 0)){
+        return false;
     }
+    return (rmt_transmit(channel, &encoder.base, data, len * LED_BYTES, &tx_config) == ESP_OK);
 }
 
-void ws2812bSendRet(void){
-    GPIOFastWrite(0);
-    DelayUs(RET_CMD);
+void ws2812bSetDoneCallback(void *ptr_done_func, void *args){
+    done_func = NULL;
+    done_args = args;
+    done_func = ptr_done_func;
+}
+
+bool ws2812bWaitDone(uint32_t timeout_ms){
+    if(channel == NULL){
+        return true;
+    }
+    return (rmt_tx_wait_all_done(channel, (timeout_ms == WS2812B_NO_TIMEOUT) ? -1 : (int)timeout_ms) == ESP_OK);
+}
+
+uint8_t ws2812bGammaCorrection(uint8_t component){
+    return gamma_table[component];
 }
 
 /*==================[end of file]============================================*/
@@ -0,0 +1,139 @@
+#ifndef GPIO_CAPTURE_MCU_H
+#define GPIO_CAPTURE_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup GPIO_CAPTURE GPIO Capture
+ ** @{ */
+
+/** \brief GPIO edge capture driver for the ESP-EDU Board.
+ *
+ * Every edge on an enabled pin is recorded by a single shared ISR as an event
+ * (pin, edge, timestamp in usec) into a lock-free queue. Events are read in
+ * batches from task context, so no user code runs inside the interruption.
+ *
+ * @note Timestamps are software timestamps: esp_timer is read when the ISR
+ * starts, so they lag the edge by the interrupt latency (a few usec, more
+ * while other interruptions run). For hardware captured edges use the MCPWM
+ * capture (see hc_sr04).
+ *
+ * @note With GPIO_CAPTURE_BOTH the interruption is armed for one direction
+ * at a time (the one after the last edge), so the edge direction doesn't
+ * depend on the pin level when the ISR runs. When a pulse ends before the
+ * ISR, its second edge is recorded with the ISR time.
+ *
+ * @note The queue has one producer (the GPIO ISR) and one consumer: only one
+ * task should call GPIOCaptureRead(), GPIOCaptureDiscard() or GPIOCaptureWait().
+ *
+ * @note A pin used with this driver can't be used with GPIOActivInt() at the
+ * same time (the last one configured owns the pin interruption).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "gpio_mcu.h"
+/*==================[macros]=================================================*/
+#define GPIO_CAPTURE_QUEUE_SIZE	256		/*!< Number of events stored in the queue (must be a power of 2) */
+#define GPIO_CAPTURE_NO_TIMEOUT	0xFFFFFFFF	/*!< Wait forever on GPIOCaptureWait() */
+#define GPIO_CAPTURE_NOTIFY_INDEX	1		/*!< Task notification index of GPIOCaptureWait() (0 is used by DelayUs() and the application) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Edges to be captured on a pin
+ */
+typedef enum {
+	GPIO_CAPTURE_FALLING = 0,	/*!< Negative edges only */
+	GPIO_CAPTURE_RISING,		/*!< Positive edges only */
+	GPIO_CAPTURE_BOTH			/*!< Both edges */
+} gpio_capture_edge_t;
+
+/**
+ * @brief Captured edge event
+ */
+typedef struct {
+	uint32_t timestamp;		/*!< Time of the edge (in usec, wraps around every ~71 minutes) */
+	gpio_t pin;				/*!< GPIO where the edge happened */
+	bool rising;			/*!< true: positive edge - false: negative edge */
+} gpio_capture_event_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Enables edge capture on a GPIO
+ *
+ * @note The pin must be previously configured as input with GPIOInit().
+ *
+ * @param pin GPIO number
+ * @param edge Edges to be captured
+ */
+void GPIOCaptureActiv(gpio_t pin, gpio_capture_edge_t edge);
+
+/**
+ * @brief Disables edge capture on a GPIO
+ *
+ * @param pin GPIO number
+ */
+void GPIOCaptureDeactiv(gpio_t pin);
+
+/**
+ * @brief Number of events waiting in the queue
+ *
+ * @return uint16_t
+ */
+uint16_t GPIOCaptureAvailable(void);
+
+/**
+ * @brief Read a batch of events from the queue (non blocking)
+ *
+ * @param events Pointer to array where events will be stored
+ * @param max_events Size of the array
+ * @return uint16_t Number of events read
+ */
+uint16_t GPIOCaptureRead(gpio_capture_event_t *events, uint16_t max_events);
+
+/**
+ * @brief Discard the events of some pins waiting in the queue (non blocking)
+ *
+ * @note Events of the other pins are kept in the queue, in the same order.
+ *
+ * @param pin_mask Pins whose events are discarded (bit n for GPIO_n)
+ * @return uint16_t Number of events discarded
+ */
+uint16_t GPIOCaptureDiscard(uint32_t pin_mask);
+
+/**
+ * @brief Block the calling task until a batch of events is available
+ *
+ * @note The task is woken up only once, when the queue reaches min_events
+ * (not once per edge). It waits on task notification GPIO_CAPTURE_NOTIFY_INDEX:
+ * the project needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES > GPIO_CAPTURE_NOTIFY_INDEX.
+ *
+ * @param min_events Number of events to wait for
+ * @param timeout_ms Maximum time to wait (GPIO_CAPTURE_NO_TIMEOUT to wait forever)
+ * @return uint16_t Number of events available
+ */
+uint16_t GPIOCaptureWait(uint16_t min_events, uint32_t timeout_ms);
+
+/**
+ * @brief Number of events lost because the queue was full
+ *
+ * @return uint32_t
+ */
+uint32_t GPIOCaptureOverflows(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif
+
+/*==================[end of file]============================================*/
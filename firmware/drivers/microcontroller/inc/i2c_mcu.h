@@ -13,6 +13,11 @@
  * @note SDA: GPIO_6, SCL: GPIO_7.
  * 
  * @note ESP-EDU have 4 I2C connector in the board (J4, J5, J6 and J8), but all of them are routed to the same I2C port.
+ * 
+ * @note Register reads are a single transaction (START, address + W, register, repeated START, 
+ * address + R, data, STOP). Command links are built on the stack, without heap allocations. 
+ * Reads and writes that are repeated (e.g. polling a sensor) can be built once with 
+ * I2C_BatchPrepare() and executed with I2C_BatchRun(): the whole list in one driver call.
  *
  * @author Juan Ignacio Cerrudo
  * 
@@ -21,6 +26,9 @@
  * |   Date	    | Description                                    |
  * |:----------:|:-----------------------------------------------|
  * | 30/01/2024 | Document creation		                         |
+ * | 19/10/2026 | Repeated start register reads, batches         |
+ * | 19/10/2026 | I2C_BusRecover()                               |
+ * | 19/10/2026 | I2C_BatchRunStatus()                           |
  *
  */
 
@@ -39,16 +47,45 @@
 #define I2C_MASTER_FREQ_HZ          400000      /*!< I2C master clock frequency */
 #define I2C_MASTER_TX_BUF_DISABLE   0           /*!< I2C master doesn't need buffer */
 #define I2C_MASTER_RX_BUF_DISABLE   0           /*!< I2C master doesn't need buffer */
-#define I2C_MASTER_TIMEOUT_MS       1000
+#define I2C_MASTER_TIMEOUT_MS       1000        /*!< Default timeout */
+#define I2C_BATCH_MAX               8           /*!< Maximum transfers of a batch */
+
+/**
+ * @brief Register read or write of a batch
+ */
+typedef struct {
+	uint8_t devAddr;		/*!< I2C slave device address */
+	uint8_t regAddr;		/*!< First register */
+	bool read;				/*!< true: read, false: write */
+	uint16_t length;		/*!< Number of bytes (reads: at least 1) */
+	uint8_t *data;			/*!< Data to write or buffer for read data (must be valid while the batch is used) */
+} i2c_transfer_t;
+
+/**
+ * @brief Batch of transfers, ready to be executed
+ */
+typedef struct {
+	i2c_cmd_handle_t cmd;	/*!< Command link */
+	uint8_t link[I2C_LINK_RECOMMENDED_SIZE(2 * I2C_BATCH_MAX)];	/*!< Command link storage */
+} i2c_batch_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
 
 /** @fn I2C_initialize( uint32_t clockRateHz )
  * @brief Initialize I2C0
+ * @return true if the driver was installed
  */
 bool I2C_initialize( uint32_t clockRateHz );
 
+/** @fn I2C_BusRecover(void)
+ * @brief Bus clear: up to 9 SCL pulses until a slave releases SDA, a STOP, and the 
+ * driver is installed again (with the clock rate given to I2C_initialize()).
+ * @note Use it after a timeout (e.g. a slave holding SDA low after a reset in the middle of a read).
+ * @return true if the bus is free
+ */
+bool I2C_BusRecover(void);
+
 /** @fn I2C_enable(bool isEnabled)
  * @brief Enable or disable I2C
  * @param isEnabled true = enable, false = disable
@@ -60,8 +97,8 @@ void I2C_enable(bool isEnabled);
  * @param devAddr I2C slave device address
  * @param regAddr Register regAddr to read from
  * @param bitNum Bit position to read (0-7)
- * @param data Container for single bit value
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
+ * @param data Container for single bit value (not modified if the read fails)
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
  * @return Status of read operation (true = success)
  */
 int8_t I2C_readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data, uint16_t timeout);
@@ -73,7 +110,7 @@ int8_t I2C_readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *da
  * @param bitStart First bit position to read (0-7)
  * @param length Number of bits to read (not more than 8)
  * @param data Container for right-aligned value (i.e. '101' read from any bitStart position will equal 0x05)
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
  * @return Status of read operation (true = success)
  */
 int8_t I2C_readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data, uint16_t timeout);
@@ -83,7 +120,7 @@ int8_t I2C_readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t
  * @param devAddr I2C slave device address
  * @param regAddr Register regAddr to read from
  * @param data Container for byte value read from device
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
  * @return Status of read operation (true = success)
  */
 int8_t I2C_readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t timeout);
@@ -104,8 +141,8 @@ int8_t I2C_readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16_t t
  * @param regAddr First register regAddr to read from
  * @param length Number of bytes to read
  * @param data Buffer to store read data in
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
- * @return I2C_TransferReturn_TypeDef
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
+ * @return Number of bytes read (0 = error)
  */
 int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout);
 
@@ -115,7 +152,7 @@ int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *
  * @param regAddr Register regAddr to write to
  * @param bitNum Bit position to write (0-7)
  * @param value New bit value to write
- * @return Status of operation (true = success)
+ * @return Status of operation (true = success, false = the register couldn't be read, nothing is written)
  */
 bool I2C_writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data);
 
@@ -158,6 +195,35 @@ bool I2C_writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data);
  */
 bool I2C_writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
 
+/** @fn I2C_BatchPrepare(i2c_batch_t *batch, const i2c_transfer_t *transfers, uint8_t count)
+ * @brief Build a batch of register reads and writes (executed in order, with repeated 
+ * starts between them and a single STOP at the end).
+ * @param batch Batch (keeps the command link)
+ * @param transfers Reads and writes (copied, but their data buffers must remain valid)
+ * @param count Number of transfers (up to I2C_BATCH_MAX)
+ * @return Status of operation (true = success)
+ */
+bool I2C_BatchPrepare(i2c_batch_t *batch, const i2c_transfer_t *transfers, uint8_t count);
+
+/** @fn I2C_BatchRun(i2c_batch_t *batch, uint16_t timeout)
+ * @brief Execute a batch built with I2C_BatchPrepare(), in one driver call. 
+ * It can be executed again as many times as needed.
+ * @param batch Batch
+ * @param timeout Timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
+ * @return Status of operation (true = success)
+ */
+bool I2C_BatchRun(i2c_batch_t *batch, uint16_t timeout);
+
+/** @fn I2C_BatchRunStatus(i2c_batch_t *batch, uint16_t timeout)
+ * @brief Same as I2C_BatchRun(), but returns the driver result, so a NACK can be
+ * told apart from a timeout or a busy bus.
+ * @param batch Batch
+ * @param timeout Timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
+ * @return ESP_OK, ESP_FAIL (NACK), ESP_ERR_TIMEOUT (timeout or bus busy), 
+ * ESP_ERR_INVALID_STATE (driver not installed) or ESP_ERR_INVALID_ARG (batch not prepared)
+ */
+esp_err_t I2C_BatchRunStatus(i2c_batch_t *batch, uint16_t timeout);
+
 /** @fn I2C_SelectRegister(uint8_t dev, uint8_t reg)
  * @brief Select a register
  * @param devAddr I2C slave device address
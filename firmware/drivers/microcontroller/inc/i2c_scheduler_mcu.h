@@ -0,0 +1,148 @@
+#ifndef I2C_SCHEDULER_MCU_H
+#define I2C_SCHEDULER_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup I2C_SCHEDULER I2C Scheduler
+ ** @{ */
+
+/** \brief I2C bus scheduler for the ESP-EDU Board.
+ *
+ * A single task owns the I2C port: other tasks submit requests (lists of
+ * register reads and writes, see i2c_transfer_t) and go on. Requests are
+ * executed back to back, the highest priority first (FIFO order within a
+ * priority), each one as a single command link. When a request ends, its
+ * callback is called from the scheduler task, or the task that used
+ * I2CSchedulerTransfer() is woken up.
+ *
+ * When a request fails it is retried. After a timeout (including a slave
+ * stretching the clock beyond the hardware timeout, or a bus held busy) the
+ * bus is cleared with I2C_BusRecover() first; after a NACK it is not (the
+ * driver already sent the STOP).
+ *
+ * @note Once the scheduler is started, every I2C access should go through
+ * it: a bus clear reinstalls the driver under a direct I2C_xxx() call.
+ *
+ * @note Callbacks run in the scheduler task (I2C_SCHEDULER_STACK bytes of
+ * stack, partly used by the driver error logs): they must be short, must not
+ * block and shouldn't use big local buffers (they can submit new requests).
+ *
+ * @note The scheduler uses task notification I2C_SCHEDULER_NOTIFY_INDEX: the
+ * project needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES > I2C_SCHEDULER_NOTIFY_INDEX.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "i2c_mcu.h"
+/*==================[macros]=================================================*/
+#define I2C_SCHEDULER_QUEUE_SIZE	8		/*!< Pending requests of each priority */
+#define I2C_SCHEDULER_STACK			4096	/*!< Stack of the scheduler task (bytes), callbacks run on it */
+#define I2C_SCHEDULER_NOTIFY_INDEX	2		/*!< Task notification index of the scheduler and I2CSchedulerTransfer() (0: application, 1: GPIO capture) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Request priorities
+ */
+typedef enum {
+	I2C_PRIORITY_HIGH,		/*!< e.g. IMU sampling */
+	I2C_PRIORITY_NORMAL,	/*!< e.g. environmental sensors */
+	I2C_PRIORITY_LOW,		/*!< e.g. configuration, displays */
+	I2C_PRIORITIES			/*!< Number of priorities */
+} i2c_priority_t;
+
+/**
+ * @brief Request states
+ */
+typedef enum {
+	I2C_REQUEST_IDLE,		/*!< Not submitted yet */
+	I2C_REQUEST_PENDING,	/*!< Queued or in execution */
+	I2C_REQUEST_DONE,		/*!< Executed */
+	I2C_REQUEST_ERROR,		/*!< Failed after all the retries */
+} i2c_request_state_t;
+
+/**
+ * @brief Request: a list of transfers executed as one transaction
+ *
+ * The request (and its transfers and buffers) must remain valid until it ends.
+ */
+typedef struct {
+	const i2c_transfer_t *transfers;	/*!< Reads and writes (up to I2C_BATCH_MAX) */
+	uint8_t count;						/*!< Number of transfers */
+	i2c_priority_t priority;			/*!< Priority */
+	uint8_t retries;					/*!< Retries after a failure (with a bus clear before each one) */
+	void *func_p;						/*!< Called when the request ends: void func(void *param_p) (can be NULL) */
+	void *param_p;						/*!< Callback parameter */
+	volatile i2c_request_state_t state;	/*!< State (written by the scheduler) */
+	void *task;							/*!< Internal: task to wake up (set on submission, NULL for I2CSchedulerSubmit()) */
+} i2c_request_t;
+
+/**
+ * @brief Scheduler configuration
+ */
+typedef struct {
+	uint32_t clock_rate;		/*!< Bus clock (Hz) */
+	uint8_t task_priority;		/*!< Priority of the scheduler task */
+	uint16_t timeout_ms;		/*!< Timeout of each request (0: I2C_MASTER_TIMEOUT_MS) */
+	int stretch_timeout;		/*!< Hardware SCL timeout, in i2c_set_timeout() units (0: driver default) */
+} i2c_scheduler_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Install the I2C driver and start the scheduler task
+ *
+ * @param config Scheduler configuration
+ * @return true
+ * @return false if the driver or the task could not be created
+ */
+bool I2CSchedulerInit(const i2c_scheduler_config_t *config);
+
+/**
+ * @brief Queue a request (doesn't block)
+ *
+ * The state changes after the callback returns: once it is not
+ * I2C_REQUEST_PENDING, the scheduler doesn't use the request anymore.
+ *
+ * @param request Request (its state is set to I2C_REQUEST_PENDING)
+ * @return true
+ * @return false if the request is not valid, still pending, or its priority queue is full
+ */
+bool I2CSchedulerSubmit(i2c_request_t *request);
+
+/**
+ * @brief Queue a request and wait until it ends
+ *
+ * @note The calling task waits on its task notification I2C_SCHEDULER_NOTIFY_INDEX,
+ * so notifications of the application (index 0) are not consumed.
+ *
+ * @param transfers Reads and writes (up to I2C_BATCH_MAX)
+ * @param count Number of transfers
+ * @param priority Priority
+ * @return true
+ * @return false if the request could not be queued or failed
+ */
+bool I2CSchedulerTransfer(const i2c_transfer_t *transfers, uint8_t count, i2c_priority_t priority);
+
+/**
+ * @brief Number of bus clears done since the scheduler was started
+ *
+ * @return uint32_t Bus clears
+ */
+uint32_t I2CSchedulerRecoveries(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* I2C_SCHEDULER_MCU_H */
+
+/*==================[end of file]============================================*/
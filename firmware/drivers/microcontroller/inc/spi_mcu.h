@@ -14,6 +14,12 @@
  * 
  * @note MISO: GPIO_22, MOSI: GPIO_21, SCLK: GPIO_20, CS1: GPIO_19, CS2: GPIO_18, CS3: GPIO_9
  * 
+ * @note Each device keeps its own clock mode, bitrate, transfer mode and callback. 
+ * Transactions of several devices can be queued together with SpiBatchStart(), and 
+ * collected with SpiBatchWait(): the CPU is free while the bus works through them. 
+ * SpiBusLock() keeps the bus for one device along several transfers (e.g. a 
+ * command followed by a read that must not be interleaved with other devices).
+ * 
  * @author Albano Peñalva
  *
  * @section changelog
@@ -21,12 +27,17 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 09/02/2024 | Document creation		                         						|
+ * | 19/10/2026 | SpiBusInit() and SpiGetCsPin() for drivers that own their device		|
+ * | 19/10/2026 | Per device settings, transaction batches and bus lock					|
  * 
  **/
 /*==================[inclusions]=============================================*/
 #include <stdbool.h>
 #include <stdint.h>
+#include "gpio_mcu.h"
 /*==================[macros]=================================================*/
+#define SPI_BATCH_MAX	16				/*!< Maximum transactions of a batch */
+#define SPI_NO_TIMEOUT	0xFFFFFFFF		/*!< Wait forever */
 
 /*==================[typedef]================================================*/
 
@@ -68,15 +79,45 @@ typedef struct{
 	transfer_mode_t transfer_mode;	/*!< Transfer mode */
 	void *func_p;					/*!< Pointer to callback function for transaction end */
 	void *param_p;					/*!< Pointer to callback parameter */
+	uint8_t command_bits;			/*!< Command phase length (0 to 16 bits, 0: no command phase) */
 } spi_mcu_config_t;
+
+/**
+ * @brief Transaction of a batch
+ */
+typedef struct{
+	spi_dev_t device;				/*!< SPI device */
+	uint16_t command;				/*!< Command (sent first, if the device has command_bits) */
+	const uint8_t *tx_buffer;		/*!< Data to write (NULL: only read) */
+	uint8_t *rx_buffer;				/*!< Where read data is stored (NULL: only write) */
+	uint32_t size;					/*!< Bytes to write and/or read */
+} spi_transfer_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize the SPI bus (only the first call has effect)
+ * 
+ * @note SpiInit() calls it. Drivers that add their own device to the bus
+ * (using ESP-IDF spi_master functions on SPI2_HOST) must call it first.
+ */
+void SpiBusInit(void);
+
+/**
+ * @brief Chip select pin of a SPI device
+ * 
+ * @param device SPI device
+ * @return gpio_t GPIO used as chip select
+ */
+gpio_t SpiGetCsPin(spi_dev_t device);
+
 /**
  * @brief Initialize SPI module with the corresponding configuration
  * 
+ * @note Calling it again for the same device changes its configuration.
+ * 
  * @param spi Structure with the module configuration
- * @return uint8_t 
+ * @return uint8_t 0: OK, 1: error
  */
 uint8_t SpiInit(spi_mcu_config_t* spi);
 
@@ -108,11 +149,55 @@ void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size);
  */
 void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size);
 
+/**
+ * @brief Queue a batch of transactions (of one or several devices)
+ * 
+ * @note Buffers must be valid until SpiBatchWait() returns, and devices of the 
+ * batch shouldn't be used with SpiRead()/SpiWrite() meanwhile. Only one batch 
+ * can be in flight: it must be collected with SpiBatchWait() before the next one.
+ * Each device queues up to SPI_BATCH_MAX transactions, so all of them can go to
+ * a single device.
+ * 
+ * @param transfers Transactions (copied, the array can be reused)
+ * @param count Number of transactions (up to SPI_BATCH_MAX)
+ * @param ptr_done_func Function called (from ISR) when the whole batch ended (can be NULL)
+ * @param args Parameter of ptr_done_func
+ * @return true 
+ * @return false if the batch is not valid or the previous one was not collected
+ */
+bool SpiBatchStart(const spi_transfer_t *transfers, uint8_t count, void *ptr_done_func, void *args);
+
+/**
+ * @brief Wait for the batch in flight to end
+ * 
+ * @param timeout_ms Maximum time to wait for each transaction (in ms, SPI_NO_TIMEOUT: forever)
+ * @return true the batch ended (read data is in the rx buffers)
+ * @return false timeout (can be called again to keep waiting)
+ */
+bool SpiBatchWait(uint32_t timeout_ms);
+
+/**
+ * @brief Take the bus for a device: transactions of other devices wait until SpiBusUnlock()
+ * 
+ * @param device SPI device
+ * @param timeout_ms Maximum time to wait for the bus (in ms, SPI_NO_TIMEOUT: forever)
+ * @return true the bus was taken
+ * @return false timeout or device not initialized
+ */
+bool SpiBusLock(spi_dev_t device, uint32_t timeout_ms);
+
+/**
+ * @brief Release the bus taken with SpiBusLock()
+ * 
+ * @param device SPI device
+ */
+void SpiBusUnlock(spi_dev_t device);
+
 /**
  * @brief De-Initialize SPI module with the corresponding configuration
  * 
  * @param device SPI device 
- * @return uint8_t 
+ * @return uint8_t 0: OK, 1: device not initialized
  */
 uint8_t SpiDeInit(spi_dev_t device);
 
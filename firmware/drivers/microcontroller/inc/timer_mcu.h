@@ -17,6 +17,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | TimerUpdatePeriod()		                         						|
  * 
  **/
 
@@ -68,6 +69,17 @@ void TimerStart(timer_mcu_t timer);
  */
 void TimerStop(timer_mcu_t timer);
 
+/**
+ * @brief Change the period of an initialized timer (it keeps running if it was started)
+ * 
+ * @note Use it instead of calling TimerInit() again: each TimerInit() allocates a new 
+ * hardware timer.
+ * 
+ * @param timer Timer number
+ * @param period New period (in us, at least 1)
+ */
+void TimerUpdatePeriod(timer_mcu_t timer, uint32_t period);
+
 /**
  * @brief Reset timer count to 0
  * 
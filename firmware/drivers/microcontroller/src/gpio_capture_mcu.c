@@ -0,0 +1,227 @@
+/**
+ * @file gpio_capture_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "gpio_capture_mcu.h"
+#include <stdint.h>
+#include "driver/gpio.h"
+#include "hal/gpio_ll.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define GPIO_QTY 			24
+#define QUEUE_MASK			(GPIO_CAPTURE_QUEUE_SIZE - 1)
+#define GPIO_HW				GPIO_LL_GET_HW(GPIO_PORT_0)
+
+#if GPIO_CAPTURE_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES
+#error "GPIOCaptureWait() needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES > GPIO_CAPTURE_NOTIFY_INDEX"
+#endif
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static gpio_capture_event_t event_queue[GPIO_CAPTURE_QUEUE_SIZE];	/*!< Events ring buffer */
+static volatile uint16_t queue_head = 0;			/*!< Next position to write (only modified by the ISR) */
+static volatile uint16_t queue_tail = 0;			/*!< Next position to read (only modified by the consumer) */
+static volatile uint32_t overflow_count = 0;		/*!< Events lost because the queue was full */
+static gpio_capture_edge_t pin_edge[GPIO_QTY];		/*!< Captured edges on each pin */
+static volatile bool pin_next_rising[GPIO_QTY];	/*!< Both edges: direction the pin interruption is armed for */
+static volatile TaskHandle_t waiting_task = NULL;	/*!< Task blocked on GPIOCaptureWait() */
+static volatile uint16_t waiting_events = 0;		/*!< Number of events the waiting task needs */
+static portMUX_TYPE waiting_lock = portMUX_INITIALIZER_UNLOCKED;
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Both edges mode: arm the pin interruption for one direction only
+ */
+static inline void IRAM_ATTR GPIOCaptureArm(gpio_t pin, bool rising){
+	pin_next_rising[pin] = rising;
+	gpio_ll_set_intr_type(GPIO_HW, pin, rising ? GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE);
+}
+
+/**
+ * @brief Store an event (from the ISR)
+ *
+ * @return uint16_t Events in the queue
+ */
+static uint16_t IRAM_ATTR GPIOCapturePush(gpio_t pin, bool rising, uint32_t timestamp){
+	uint16_t head = queue_head;
+	uint16_t tail = __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE);
+
+	if((uint16_t)(head - tail) >= GPIO_CAPTURE_QUEUE_SIZE){
+		overflow_count++;
+		return head - tail;
+	}
+	gpio_capture_event_t *event = &event_queue[head & QUEUE_MASK];
+	event->timestamp = timestamp;
+	event->pin = pin;
+	event->rising = rising;
+	head++;
+	__atomic_store_n(&queue_head, head, __ATOMIC_RELEASE);
+	return head - tail;
+}
+
+/**
+ * @brief Shared ISR for every captured pin
+ *
+ * @param args GPIO number (passed as pointer)
+ */
+static void IRAM_ATTR GPIOCaptureIsr(void *args){
+	uint32_t now = (uint32_t)esp_timer_get_time();
+	gpio_t pin = (gpio_t)(uintptr_t)args;
+	uint16_t count;
+	bool rising;
+
+	switch(pin_edge[pin]){
+		case GPIO_CAPTURE_FALLING:
+			rising = false;
+		break;
+		case GPIO_CAPTURE_RISING:
+			rising = true;
+		break;
+		default:
+			/* The direction is the one the interruption was armed for: the pin 
+			 * level, read after the interrupt latency, can be past a short pulse */
+			rising = pin_next_rising[pin];
+			GPIOCaptureArm(pin, !rising);
+		break;
+	}
+	count = GPIOCapturePush(pin, rising, now);
+	if((pin_edge[pin] == GPIO_CAPTURE_BOTH) && (gpio_ll_get_level(GPIO_HW, pin) != rising)){
+		/* The pulse ended before the interruption was armed again: its second 
+		 * edge is recorded now (timestamp of this ISR), and the first one is next */
+		count = GPIOCapturePush(pin, !rising, (uint32_t)esp_timer_get_time());
+		GPIOCaptureArm(pin, rising);
+		gpio_ll_clear_intr_status_bit(GPIO_HW, pin);
+	}
+
+	portENTER_CRITICAL_ISR(&waiting_lock);
+	if((waiting_task != NULL) && (count >= waiting_events)){
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		vTaskNotifyGiveIndexedFromISR(waiting_task, GPIO_CAPTURE_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+		waiting_task = NULL;
+		portEXIT_CRITICAL_ISR(&waiting_lock);
+		if(xHigherPriorityTaskWoken == pdTRUE){
+			portYIELD_FROM_ISR();
+		}
+		return;
+	}
+	portEXIT_CRITICAL_ISR(&waiting_lock);
+}
+/*==================[external functions definition]==========================*/
+void GPIOCaptureActiv(gpio_t pin, gpio_capture_edge_t edge){
+	if((pin == GPIO_14) || (pin > GPIO_23)){
+		return;
+	}
+	pin_edge[pin] = edge;
+	switch(edge){
+		case GPIO_CAPTURE_FALLING:
+			gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_NEGEDGE);
+		break;
+		case GPIO_CAPTURE_RISING:
+			gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_POSEDGE);
+		break;
+		default:
+			/* One direction at a time: the next edge is the opposite of the level */
+			pin_next_rising[pin] = !gpio_get_level((gpio_num_t)pin);
+			gpio_set_intr_type((gpio_num_t)pin, pin_next_rising[pin] ? GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE);
+		break;
+	}
+	/* The ISR service could be already installed by GPIOActivInt() */
+	gpio_install_isr_service(0);
+	gpio_isr_handler_add((gpio_num_t)pin, GPIOCaptureIsr, (void *)(uintptr_t)pin);
+	gpio_intr_enable((gpio_num_t)pin);
+}
+
+void GPIOCaptureDeactiv(gpio_t pin){
+	if((pin == GPIO_14) || (pin > GPIO_23)){
+		return;
+	}
+	gpio_intr_disable((gpio_num_t)pin);
+	gpio_isr_handler_remove((gpio_num_t)pin);
+}
+
+uint16_t GPIOCaptureAvailable(void){
+	return (uint16_t)(__atomic_load_n(&queue_head, __ATOMIC_ACQUIRE) - queue_tail);
+}
+
+uint16_t GPIOCaptureRead(gpio_capture_event_t *events, uint16_t max_events){
+	uint16_t head = __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+	uint16_t tail = queue_tail;
+	uint16_t n = 0;
+
+	while((tail != head) && (n < max_events)){
+		events[n++] = event_queue[tail & QUEUE_MASK];
+		tail++;
+	}
+	__atomic_store_n(&queue_tail, tail, __ATOMIC_RELEASE);
+	return n;
+}
+
+uint16_t GPIOCaptureDiscard(uint32_t pin_mask){
+	uint16_t head = __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+	uint16_t tail = queue_tail;
+	uint16_t keep = head;
+	uint16_t n = 0;
+
+	/* Events between tail and head belong to the consumer: the ones kept are 
+	 * moved towards head (same order) and tail is moved past the freed slots */
+	while(head != tail){
+		head--;
+		gpio_capture_event_t *event = &event_queue[head & QUEUE_MASK];
+		if(pin_mask & (1UL << event->pin)){
+			n++;
+		} else{
+			keep--;
+			event_queue[keep & QUEUE_MASK] = *event;
+		}
+	}
+	__atomic_store_n(&queue_tail, keep, __ATOMIC_RELEASE);
+	return n;
+}
+
+uint16_t GPIOCaptureWait(uint16_t min_events, uint32_t timeout_ms){
+	TickType_t ticks = portMAX_DELAY;
+
+	if(min_events > GPIO_CAPTURE_QUEUE_SIZE){
+		min_events = GPIO_CAPTURE_QUEUE_SIZE;
+	}
+	if(timeout_ms != GPIO_CAPTURE_NO_TIMEOUT){
+		ticks = pdMS_TO_TICKS(timeout_ms);
+	}
+	if(GPIOCaptureAvailable() < min_events){
+		bool notified = false;
+		waiting_events = min_events;
+		waiting_task = xTaskGetCurrentTaskHandle();
+		/* An edge could have arrived before waiting_task was set */
+		if(GPIOCaptureAvailable() < min_events){
+			notified = (ulTaskNotifyTakeIndexed(GPIO_CAPTURE_NOTIFY_INDEX, pdTRUE, ticks) > 0);
+		}
+		portENTER_CRITICAL(&waiting_lock);
+		bool given = (waiting_task == NULL);
+		waiting_task = NULL;
+		portEXIT_CRITICAL(&waiting_lock);
+		if(given && !notified){
+			/* The ISR notified after the timeout: don't leave it pending for the task */
+			ulTaskNotifyTakeIndexed(GPIO_CAPTURE_NOTIFY_INDEX, pdTRUE, 0);
+		}
+	}
+	return GPIOCaptureAvailable();
+}
+
+uint32_t GPIOCaptureOverflows(void){
+	return overflow_count;
+}
+
+/*==================[end of file]============================================*/
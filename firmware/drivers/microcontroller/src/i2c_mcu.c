@@ -14,19 +14,58 @@
 #include <esp_err.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include "esp_rom_sys.h"
 //#include "sdkconfig.h"
 
 #include "i2c_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define I2C_NUM I2C_NUM_0
+#define I2C_REG_LINK_SIZE	I2C_LINK_RECOMMENDED_SIZE(2)	/*!< Command link of a register read (write + read) */
+#define I2C_CLEAR_CLOCKS	9		/*!< SCL pulses to release a slave holding SDA */
+#define I2C_CLEAR_HALF_US	5		/*!< Half period of the bus clear clock (100 kHz) */
 
 #undef ESP_ERROR_CHECK
 #define ESP_ERROR_CHECK(x)   do { esp_err_t rc = (x); if (rc != ESP_OK) { ESP_LOGE("err", "esp_err_t = %d", rc); /*assert(0 && #x);*/} } while(0);
 
 /*==================[internal data definition]===============================*/
+static uint32_t i2c_clock_rate = I2C_MASTER_FREQ_HZ;	/*!< Clock rate, to reinstall the driver after a bus clear */
 
 /*==================[internal functions declaration]=========================*/
 
+/*==================[internal functions definition]==========================*/
+/** Timeout in ticks (0: I2C_MASTER_TIMEOUT_MS)
+ */
+static TickType_t I2C_Ticks(uint16_t timeout){
+	return pdMS_TO_TICKS((timeout != 0) ? timeout : I2C_MASTER_TIMEOUT_MS);
+}
+
+/** Adds a register read to a command link: START, address + W, register, 
+ * repeated START, address + R, data. No STOP.
+ */
+static esp_err_t I2C_LinkRead(i2c_cmd_handle_t cmd, uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data){
+	esp_err_t err = ESP_OK;
+	err |= i2c_master_start(cmd);
+	err |= i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, 1);
+	err |= i2c_master_write_byte(cmd, regAddr, 1);
+	err |= i2c_master_start(cmd);
+	err |= i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_READ, 1);
+	err |= i2c_master_read(cmd, data, length, I2C_MASTER_LAST_NACK);
+	return err;
+}
+
+/** Adds a register write to a command link: START, address + W, register, data. No STOP.
+ */
+static esp_err_t I2C_LinkWrite(i2c_cmd_handle_t cmd, uint8_t devAddr, uint8_t regAddr, uint16_t length, const uint8_t *data){
+	esp_err_t err = ESP_OK;
+	err |= i2c_master_start(cmd);
+	err |= i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, 1);
+	err |= i2c_master_write_byte(cmd, regAddr, 1);
+	if(length > 0){
+		err |= i2c_master_write(cmd, data, length, 1);
+	}
+	return err;
+}
+
 /*==================[external functions definition]==========================*/
 
 /** Initialize I2C0
@@ -34,6 +73,7 @@
 bool I2C_initialize( uint32_t clockRateHz )
 {
 	int i2c_master_port = I2C_MASTER_NUM;
+	i2c_clock_rate = clockRateHz;
 
     i2c_config_t conf = {
         .mode = I2C_MODE_MASTER,
@@ -46,12 +86,47 @@ bool I2C_initialize( uint32_t clockRateHz )
 
     i2c_param_config(i2c_master_port, &conf);
 
-    return i2c_driver_install(i2c_master_port, conf.mode, I2C_MASTER_RX_BUF_DISABLE, I2C_MASTER_TX_BUF_DISABLE, 0);
-	return true;
+    return i2c_driver_install(i2c_master_port, conf.mode, I2C_MASTER_RX_BUF_DISABLE, I2C_MASTER_TX_BUF_DISABLE, 0) == ESP_OK;
 };
 
 
 
+/** Bus clear: clocks SCL until a slave stuck in the middle of a byte releases SDA, 
+ * then generates a STOP and reinstalls the driver.
+ * @return true if SDA was released
+ */
+bool I2C_BusRecover(void)
+{
+	gpio_num_t sda = (gpio_num_t)I2C_MASTER_SDA_IO;
+	gpio_num_t scl = (gpio_num_t)I2C_MASTER_SCL_IO;
+	bool released;
+
+	i2c_driver_delete(I2C_NUM);
+	gpio_set_level(sda, 1);
+	gpio_set_level(scl, 1);
+	gpio_set_direction(sda, GPIO_MODE_INPUT_OUTPUT_OD);
+	gpio_set_direction(scl, GPIO_MODE_INPUT_OUTPUT_OD);
+	esp_rom_delay_us(I2C_CLEAR_HALF_US);
+	for(uint8_t i = 0; (i < I2C_CLEAR_CLOCKS) && (gpio_get_level(sda) == 0); i++){
+		gpio_set_level(scl, 0);
+		esp_rom_delay_us(I2C_CLEAR_HALF_US);
+		gpio_set_level(scl, 1);
+		esp_rom_delay_us(I2C_CLEAR_HALF_US);
+	}
+	/* STOP: SDA rises while SCL is high */
+	gpio_set_level(scl, 0);
+	gpio_set_level(sda, 0);
+	esp_rom_delay_us(I2C_CLEAR_HALF_US);
+	gpio_set_level(scl, 1);
+	esp_rom_delay_us(I2C_CLEAR_HALF_US);
+	gpio_set_level(sda, 1);
+	esp_rom_delay_us(I2C_CLEAR_HALF_US);
+	released = (gpio_get_level(sda) == 1) && (gpio_get_level(scl) == 1);
+
+	/* i2c_param_config() gives the pins back to the controller */
+	return I2C_initialize(i2c_clock_rate) && released;
+}
+
 /** Enable or disable I2C
  * @param isEnabled true = enable, false = disable
  */
@@ -67,15 +142,16 @@ void I2C_enable(bool isEnabled) {
  * @param regAddr Register regAddr to read from
  * @param bitNum Bit position to read (0-7)
  * @param data Container for single bit value
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
  * @return Status of read operation (true = success)
  */
 int8_t I2C_readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data, uint16_t timeout) {
 
 
-	uint8_t b;
-    uint8_t count = I2C_readByte(devAddr, regAddr, &b, timeout);
-    *data = b & (1 << bitNum);
+	uint8_t count, b;
+    if ((count = I2C_readByte(devAddr, regAddr, &b, timeout)) != 0) {
+        *data = b & (1 << bitNum);
+    }
     return count;
 }
 
@@ -85,7 +161,7 @@ int8_t I2C_readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *da
  * @param bitStart First bit position to read (0-7)
  * @param length Number of bits to read (not more than 8)
  * @param data Container for right-aligned value (i.e. '101' read from any bitStart position will equal 0x05)
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
  * @return Status of read operation (true = success)
  */
 int8_t I2C_readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data, uint16_t timeout) {
@@ -108,7 +184,7 @@ int8_t I2C_readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t
  * @param devAddr I2C slave device address
  * @param regAddr Register regAddr to read from
  * @param data Container for byte value read from device
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
  * @return Status of read operation (true = success)
  */
 int8_t I2C_readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t timeout) {
@@ -120,27 +196,28 @@ int8_t I2C_readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t ti
  * @param regAddr First register regAddr to read from
  * @param length Number of bytes to read
  * @param data Buffer to store read data in
- * @param timeout Optional read timeout in milliseconds (0 to disable, leave off to use default class value in I2C_readTimeout)
- * @return I2C_TransferReturn_TypeDef http://downloads.energymicro.com/documentation/doxygen/group__I2C.html
+ * @param timeout Read timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
+ * @return Number of bytes read (0 = error)
  */
 int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout) {
+	/* Single transaction with repeated start, link built on the stack (no heap) */
+	uint8_t link[I2C_REG_LINK_SIZE];
 	i2c_cmd_handle_t cmd;
-	I2C_SelectRegister(devAddr, regAddr);
-
-	cmd = i2c_cmd_link_create();
-	ESP_ERROR_CHECK(i2c_master_start(cmd));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_READ, 1));
-
-	if(length>1)
-	ESP_ERROR_CHECK(i2c_master_read(cmd, data, length-1, I2C_MASTER_ACK));
-
-	ESP_ERROR_CHECK(i2c_master_read_byte(cmd, data+length-1, I2C_MASTER_NACK));
-
-	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS));
-	i2c_cmd_link_delete(cmd);
-
-	return length;
+	esp_err_t err;
+
+	if(length == 0){
+		return 0;
+	}
+	cmd = i2c_cmd_link_create_static(link, sizeof(link));
+	err = I2C_LinkRead(cmd, devAddr, regAddr, length, data);
+	err |= i2c_master_stop(cmd);
+	if(err == ESP_OK){
+		err = i2c_master_cmd_begin(I2C_NUM, cmd, I2C_Ticks(timeout));
+	}
+	i2c_cmd_link_delete_static(cmd);
+	ESP_ERROR_CHECK(err);
+
+	return (err == ESP_OK) ? length : 0;
 }
 
 bool I2C_writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data){
@@ -151,15 +228,7 @@ bool I2C_writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data){
 }
 
 void I2C_SelectRegister(uint8_t devAddr, uint8_t reg){
-	i2c_cmd_handle_t cmd;
-
-	cmd = i2c_cmd_link_create();
-	ESP_ERROR_CHECK(i2c_master_start(cmd));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, 1));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, reg, 1));
-	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS));
-	i2c_cmd_link_delete(cmd);
+	ESP_ERROR_CHECK(i2c_master_write_to_device(I2C_NUM, devAddr, &reg, 1, I2C_Ticks(0)));
 }
 
 /** write a single bit in an 8-bit device register.
@@ -171,7 +240,9 @@ void I2C_SelectRegister(uint8_t devAddr, uint8_t reg){
  */
 bool I2C_writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data) {
     uint8_t b;
-    I2C_readByte(devAddr, regAddr, &b, 0);
+    if (I2C_readByte(devAddr, regAddr, &b, 0) == 0) {
+        return false;
+    }
     b = (data != 0) ? (b | (1 << bitNum)) : (b & ~(1 << bitNum));
     return I2C_writeByte(devAddr, regAddr, b);
 }
@@ -212,18 +283,7 @@ bool I2C_writeBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t l
  * @return Status of operation (true = success)
  */
 bool I2C_writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data) {
-	i2c_cmd_handle_t cmd;
-
-	cmd = i2c_cmd_link_create();
-	ESP_ERROR_CHECK(i2c_master_start(cmd));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, 1));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, regAddr, 1));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, data, 1));
-	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS));
-	i2c_cmd_link_delete(cmd);
-
-	return true;
+	return I2C_writeBytes(devAddr, regAddr, 1, &data);
 }
 
 /** Write single byte to an 8-bit device register.
@@ -234,20 +294,76 @@ bool I2C_writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data) {
  * @return Status of operation (true = success)
  */
 bool I2C_writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data){
+	uint8_t link[I2C_REG_LINK_SIZE];
 	i2c_cmd_handle_t cmd;
+	esp_err_t err;
+
+	cmd = i2c_cmd_link_create_static(link, sizeof(link));
+	err = I2C_LinkWrite(cmd, devAddr, regAddr, length, data);
+	err |= i2c_master_stop(cmd);
+	if(err == ESP_OK){
+		err = i2c_master_cmd_begin(I2C_NUM, cmd, I2C_Ticks(0));
+	}
+	i2c_cmd_link_delete_static(cmd);
+	ESP_ERROR_CHECK(err);
+	return err == ESP_OK;
+}
 
-	cmd = i2c_cmd_link_create();
-	ESP_ERROR_CHECK(i2c_master_start(cmd));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, 1));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, regAddr, 1));
-	ESP_ERROR_CHECK(i2c_master_write(cmd, data, length-1, 0));
-	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, data[length-1], 1));
-	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS);
-	i2c_cmd_link_delete(cmd);
+/** Build a command link with a list of register reads and writes.
+ * @param batch Batch (keeps the command link)
+ * @param transfers Reads and writes, executed in order
+ * @param count Number of transfers (up to I2C_BATCH_MAX)
+ * @return Status of operation (true = success)
+ */
+bool I2C_BatchPrepare(i2c_batch_t *batch, const i2c_transfer_t *transfers, uint8_t count){
+	esp_err_t err = ESP_OK;
+
+	if((count == 0) || (count > I2C_BATCH_MAX)){
+		return false;
+	}
+	batch->cmd = i2c_cmd_link_create_static(batch->link, sizeof(batch->link));
+	/* Transfers after the first one begin with a repeated START, only the last one ends with STOP */
+	for(uint8_t i = 0; i < count; i++){
+		if(transfers[i].read){
+			err |= I2C_LinkRead(batch->cmd, transfers[i].devAddr, transfers[i].regAddr, transfers[i].length, transfers[i].data);
+		} else{
+			err |= I2C_LinkWrite(batch->cmd, transfers[i].devAddr, transfers[i].regAddr, transfers[i].length, transfers[i].data);
+		}
+	}
+	err |= i2c_master_stop(batch->cmd);
+	if(err != ESP_OK){
+		i2c_cmd_link_delete_static(batch->cmd);
+		batch->cmd = NULL;
+		return false;
+	}
 	return true;
 }
 
+/** Execute a batch built with I2C_BatchPrepare() (can be executed many times).
+ * @param batch Batch
+ * @param timeout Timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
+ * @return Status of operation (true = success)
+ */
+bool I2C_BatchRun(i2c_batch_t *batch, uint16_t timeout){
+	return I2C_BatchRunStatus(batch, timeout) == ESP_OK;
+}
+
+/** Execute a batch built with I2C_BatchPrepare() and return the driver result.
+ * @param batch Batch
+ * @param timeout Timeout in milliseconds (0: I2C_MASTER_TIMEOUT_MS)
+ * @return ESP_OK, ESP_FAIL (NACK), ESP_ERR_TIMEOUT (timeout or bus busy) or ESP_ERR_INVALID_STATE
+ */
+esp_err_t I2C_BatchRunStatus(i2c_batch_t *batch, uint16_t timeout){
+	esp_err_t err;
+
+	if(batch->cmd == NULL){
+		return ESP_ERR_INVALID_ARG;
+	}
+	err = i2c_master_cmd_begin(I2C_NUM, batch->cmd, I2C_Ticks(timeout));
+	/* Failures are returned (the caller retries or recovers the bus) */
+	ESP_ERROR_CHECK_WITHOUT_ABORT(err);
+	return err;
+}
 
 /**
  * read word
@@ -259,9 +375,9 @@ bool I2C_writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *d
  */
 int8_t I2C_readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16_t timeout){
 	uint8_t msb[2] = {0,0};
-	I2C_readBytes(devAddr, regAddr, 2, msb, 0);
+	int8_t count = I2C_readBytes(devAddr, regAddr, 2, msb, timeout);
 	*data = (int16_t)((msb[0] << 8) | msb[1]);
-	return 0;
+	return count;
 }
 
 /*==================[end of file]============================================*/
@@ -0,0 +1,174 @@
+/**
+ * @file i2c_scheduler_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "i2c_scheduler_mcu.h"
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+/*==================[macros and definitions]=================================*/
+#define I2C_NUM						I2C_MASTER_NUM
+#define I2C_SCHEDULER_RETRIES		1		/*!< Retries of the requests of I2CSchedulerTransfer() */
+
+#if I2C_SCHEDULER_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES
+#error "The I2C scheduler needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES > I2C_SCHEDULER_NOTIFY_INDEX"
+#endif
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static QueueHandle_t request_queue[I2C_PRIORITIES];	/*!< Pending requests (pointers) of each priority */
+static TaskHandle_t scheduler_task = NULL;			/*!< Task that owns the bus */
+static i2c_scheduler_config_t scheduler_cfg;		/*!< Configuration */
+static i2c_batch_t scheduler_batch;					/*!< Command link of the request in execution */
+static volatile uint32_t recoveries = 0;			/*!< Bus clears done */
+static portMUX_TYPE state_lock = portMUX_INITIALIZER_UNLOCKED;	/*!< Wake up and end of a request, as one step */
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void I2CSchedulerSetTimeout(void){
+	if(scheduler_cfg.stretch_timeout != 0){
+		i2c_set_timeout(I2C_NUM, scheduler_cfg.stretch_timeout);
+	}
+}
+
+static void I2CSchedulerExecute(i2c_request_t *request){
+	esp_err_t err = ESP_FAIL;
+	void (*func_p)(void*) = request->func_p;
+	void *param_p = request->param_p;
+	TaskHandle_t task = request->task;
+
+	if(I2C_BatchPrepare(&scheduler_batch, request->transfers, request->count)){
+		for(uint8_t attempt = 0; (attempt <= request->retries) && (err != ESP_OK); attempt++){
+			err = I2C_BatchRunStatus(&scheduler_batch, scheduler_cfg.timeout_ms);
+			if((err == ESP_ERR_TIMEOUT) || (err == ESP_ERR_INVALID_STATE)){
+				/* A slave may be holding the bus: leave it free for the retry 
+				 * (or for the next request). After a NACK the STOP was sent, 
+				 * so the request is just retried */
+				I2C_BusRecover();
+				I2CSchedulerSetTimeout();
+				recoveries++;
+			}
+		}
+	}
+	if(func_p != NULL){
+		func_p(param_p);
+	}
+	/* The request may be released by its owner as soon as its state changes:
+	 * it is published last, together with the notification, so a waiting
+	 * task sees the new state only after its notification was given */
+	portENTER_CRITICAL(&state_lock);
+	if(task != NULL){
+		xTaskNotifyGiveIndexed(task, I2C_SCHEDULER_NOTIFY_INDEX);
+	}
+	request->state = (err == ESP_OK) ? I2C_REQUEST_DONE : I2C_REQUEST_ERROR;
+	portEXIT_CRITICAL(&state_lock);
+}
+
+static i2c_request_state_t I2CSchedulerState(const i2c_request_t *request){
+	i2c_request_state_t state;
+	portENTER_CRITICAL(&state_lock);
+	state = request->state;
+	portEXIT_CRITICAL(&state_lock);
+	return state;
+}
+
+static bool I2CSchedulerQueue(i2c_request_t *request, TaskHandle_t task){
+	if((scheduler_task == NULL) || (request->priority >= I2C_PRIORITIES) ||
+	   (request->count == 0) || (request->count > I2C_BATCH_MAX) ||
+	   (request->state == I2C_REQUEST_PENDING)){
+		return false;
+	}
+	for(uint8_t i = 0; i < request->count; i++){
+		if(request->transfers[i].read && (request->transfers[i].length == 0)){
+			return false;
+		}
+	}
+	request->task = task;
+	request->state = I2C_REQUEST_PENDING;
+	if(xQueueSend(request_queue[request->priority], &request, 0) != pdTRUE){
+		request->state = I2C_REQUEST_IDLE;
+		return false;
+	}
+	xTaskNotifyGiveIndexed(scheduler_task, I2C_SCHEDULER_NOTIFY_INDEX);
+	return true;
+}
+
+static void I2CSchedulerTask(void *param){
+	i2c_request_t *request;
+	uint8_t priority;
+	while(true){
+		/* The notification value counts the submitted requests (callbacks 
+		 * running in this task can still use index 0, e.g. DelayUs()) */
+		ulTaskNotifyTakeIndexed(I2C_SCHEDULER_NOTIFY_INDEX, pdFALSE, portMAX_DELAY);
+		for(priority = 0; priority < I2C_PRIORITIES; priority++){
+			if(xQueueReceive(request_queue[priority], &request, 0) == pdTRUE){
+				I2CSchedulerExecute(request);
+				break;
+			}
+		}
+	}
+}
+/*==================[external functions definition]==========================*/
+bool I2CSchedulerInit(const i2c_scheduler_config_t *config){
+	if(scheduler_task != NULL){
+		return false;
+	}
+	scheduler_cfg = *config;
+	for(uint8_t p = 0; p < I2C_PRIORITIES; p++){
+		request_queue[p] = xQueueCreate(I2C_SCHEDULER_QUEUE_SIZE, sizeof(i2c_request_t*));
+		if(request_queue[p] == NULL){
+			return false;
+		}
+	}
+	if(!I2C_initialize(scheduler_cfg.clock_rate)){
+		return false;
+	}
+	I2CSchedulerSetTimeout();
+	recoveries = 0;
+	if(xTaskCreate(&I2CSchedulerTask, "i2c_scheduler", I2C_SCHEDULER_STACK, NULL, scheduler_cfg.task_priority, &scheduler_task) != pdPASS){
+		scheduler_task = NULL;
+		return false;
+	}
+	return true;
+}
+
+bool I2CSchedulerSubmit(i2c_request_t *request){
+	return I2CSchedulerQueue(request, NULL);
+}
+
+bool I2CSchedulerTransfer(const i2c_transfer_t *transfers, uint8_t count, i2c_priority_t priority){
+	i2c_request_t request = {
+		.transfers = transfers,
+		.count = count,
+		.priority = priority,
+		.retries = I2C_SCHEDULER_RETRIES,
+		.state = I2C_REQUEST_IDLE,
+	};
+	if(!I2CSchedulerQueue(&request, xTaskGetCurrentTaskHandle())){
+		return false;
+	}
+	/* Every request ends (each attempt is limited by the timeout) with one
+	 * notification, given before its state changes: take one notification
+	 * per wake up, so none is left behind once the state is not pending */
+	do{
+		ulTaskNotifyTakeIndexed(I2C_SCHEDULER_NOTIFY_INDEX, pdFALSE, portMAX_DELAY);
+	} while(I2CSchedulerState(&request) == I2C_REQUEST_PENDING);
+	return request.state == I2C_REQUEST_DONE;
+}
+
+uint32_t I2CSchedulerRecoveries(void){
+	return recoveries;
+}
+
+/*==================[end of file]============================================*/
@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <string.h>
 #include "driver/spi_master.h"
+#include "freertos/FreeRTOS.h"
 #include "gpio_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define PIN_NUM_MISO	GPIO_22	/*!<  */
@@ -22,9 +23,37 @@
 #define PIN_NUM_CS1		GPIO_19	/*!<  */
 #define PIN_NUM_CS2		GPIO_18	/*!<  */
 #define PIN_NUM_CS3		GPIO_9	/*!<  */
+#define SPI_DEVICES		3		/*!< Devices of the bus (one for each CS pin) */
+#define SPI_QUEUE_SIZE	SPI_BATCH_MAX	/*!< Transactions queued at the same time for each device (a whole batch fits in one) */
+#define SPI_TXDATA_SIZE	4		/*!< Bytes that fit inside a transaction (no buffer needed) */
 /*==================[internal data declaration]==============================*/
-spi_device_handle_t spi_1, spi_2, spi_3;
-const spi_bus_config_t bus_cfg = {
+/**
+ * @brief State of each device of the bus
+ */
+typedef struct {
+    spi_device_handle_t handle;     /*!< ESP-IDF device (NULL: not initialized) */
+    transfer_mode_t transfer_mode;  /*!< Transfer mode */
+    void (*isr_p)(void*);           /*!< Transaction end callback (SPI_INTERRUPT mode) */
+    void *user_data;                /*!< Callback parameter */
+} spi_device_state_t;
+
+/**
+ * @brief Batch of transactions in flight
+ */
+typedef struct {
+    spi_transaction_t trans[SPI_BATCH_MAX];     /*!< Transactions (must live until they end) */
+    spi_dev_t devices[SPI_BATCH_MAX];           /*!< Device of each transaction */
+    uint8_t *rx_buffers[SPI_BATCH_MAX];         /*!< Where to copy data received inside the transaction */
+    uint8_t count;                              /*!< Transactions of the batch */
+    uint8_t collected;                          /*!< Transactions whose result was read */
+    volatile uint8_t finished;                  /*!< Transactions ended (counted in ISR) */
+    void (*done_p)(void*);                      /*!< Called when the last transaction ends */
+    void *done_data;                            /*!< Callback parameter */
+} spi_batch_t;
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static const spi_bus_config_t bus_cfg = {
     .miso_io_num = PIN_NUM_MISO,
     .mosi_io_num = PIN_NUM_MOSI,
     .sclk_io_num = PIN_NUM_CLK,
@@ -32,197 +61,192 @@ const spi_bus_config_t bus_cfg = {
     .quadhd_io_num = -1,
     .max_transfer_sz = 4092
 };
-transfer_mode_t transfer_mode_1, transfer_mode_2, transfer_mode_3;
-void (*spi_1_isr_p)(void*);	/*!<  */
-void (*spi_2_isr_p)(void*);	/*!<  */
-void (*spi_3_isr_p)(void*);	/*!<  */
-void *spi_1_user_data;	    /*!<  */
-void *spi_2_user_data;	    /*!<  */
-void *spi_3_user_data;	    /*!<  */
-/*==================[internal functions declaration]=========================*/
-static void IRAM_ATTR spi_1_isr(spi_transaction_t *t){
-	spi_1_isr_p(spi_1_user_data);
-}
-static void IRAM_ATTR spi_2_isr(spi_transaction_t *t){
-	spi_2_isr_p(spi_2_user_data);
-}
-static void IRAM_ATTR spi_3_isr(spi_transaction_t *t){
-	spi_3_isr_p(spi_3_user_data);
-}
-/*==================[internal data definition]===============================*/
-
+static const gpio_t cs_pins[SPI_DEVICES] = {PIN_NUM_CS1, PIN_NUM_CS2, PIN_NUM_CS3};
+static spi_device_state_t spi_devices[SPI_DEVICES];     /*!< Devices of the bus */
+static spi_batch_t spi_batch;                           /*!< Batch in flight */
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Called by the SPI driver (in ISR context) at the end of every transaction
+ *
+ * Transactions carry the state of their device in user.
+ */
+static void IRAM_ATTR SpiPostTransfer(spi_transaction_t *t){
+    spi_device_state_t *dev = t->user;
+    if((dev->transfer_mode == SPI_INTERRUPT) && (dev->isr_p != NULL)){
+        dev->isr_p(dev->user_data);
+    }
+    if((t >= spi_batch.trans) && (t < &spi_batch.trans[spi_batch.count])){
+        /* Devices are served by the driver in its own order: the batch ends with its last transaction, whatever it is */
+        if((++spi_batch.finished == spi_batch.count) && (spi_batch.done_p != NULL)){
+            spi_batch.done_p(spi_batch.done_data);
+        }
+    }
+}
 
+/**
+ * @brief Fills a transaction (data up to 4 bytes goes inside the transaction)
+ */
+static void SpiFillTransaction(spi_transaction_t *t, spi_device_state_t *dev, uint16_t command,
+                               const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t size){
+    memset(t, 0, sizeof(spi_transaction_t));
+    t->cmd = command;
+    t->length = size * 8;           // size is in bytes, transaction length is in bits.
+    t->rxlength = (rx_buffer != NULL) ? size * 8 : 0;
+    t->user = dev;
+    if((tx_buffer != NULL) && (size <= SPI_TXDATA_SIZE)){
+        t->flags |= SPI_TRANS_USE_TXDATA;
+        memcpy(t->tx_data, tx_buffer, size);
+    } else{
+        t->tx_buffer = tx_buffer;
+    }
+    if((rx_buffer != NULL) && (size <= SPI_TXDATA_SIZE)){
+        t->flags |= SPI_TRANS_USE_RXDATA;
+    } else{
+        t->rx_buffer = rx_buffer;
+    }
+}
+
+/**
+ * @brief Single blocking transfer on a device
+ */
+static void SpiTransfer(spi_dev_t device, const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t size){
+    spi_device_state_t *dev;
+    spi_transaction_t t;
+    if((device >= SPI_DEVICES) || (spi_devices[device].handle == NULL)){
+        return;
+    }
+    dev = &spi_devices[device];
+    SpiFillTransaction(&t, dev, 0, tx_buffer, rx_buffer, size);
+    if(dev->transfer_mode == SPI_POLLING){
+        spi_device_polling_transmit(dev->handle, &t);
+    } else{
+        spi_device_transmit(dev->handle, &t);
+    }
+    if((rx_buffer != NULL) && (t.flags & SPI_TRANS_USE_RXDATA)){
+        memcpy(rx_buffer, t.rx_data, size);
+    }
+}
 /*==================[external functions definition]==========================*/
-uint8_t SpiInit(spi_mcu_config_t* spi){
+void SpiBusInit(void){
     static bool spi_initialized = false;
     if(!spi_initialized){
 	    spi_bus_initialize(SPI2_HOST, &bus_cfg, SPI_DMA_CH_AUTO);
         spi_initialized = true;
     }
+}
+
+gpio_t SpiGetCsPin(spi_dev_t device){
+    if(device >= SPI_DEVICES){
+        return PIN_NUM_CS1;
+    }
+    return cs_pins[device];
+}
+
+uint8_t SpiInit(spi_mcu_config_t* spi){
+    spi_device_state_t *dev;
 	spi_device_interface_config_t dev_cfg = {
+        .command_bits = spi->command_bits,
         .clock_speed_hz = spi->bitrate,     	
         .mode = spi->clk_mode,                  
-        .queue_size = 8,                        
+        .spics_io_num = SpiGetCsPin(spi->device),
+        .queue_size = SPI_QUEUE_SIZE,
+        .post_cb = SpiPostTransfer,
     };
-    switch(spi->device){
-        case SPI_1:
-            dev_cfg.spics_io_num = PIN_NUM_CS1;
-            transfer_mode_1 = spi->transfer_mode;
-            if(transfer_mode_1 == SPI_INTERRUPT){
-                dev_cfg.post_cb = spi_1_isr;
-            } 
-            spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_1);
-            spi_1_isr_p = spi->func_p;
-            spi_1_user_data = spi->param_p;
-            break;
-        case SPI_2:
-            dev_cfg.spics_io_num = PIN_NUM_CS2;
-            if(transfer_mode_2 == SPI_INTERRUPT){
-                dev_cfg.post_cb = spi_2_isr;
-            } 
-            transfer_mode_1 = spi->transfer_mode;
-            spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_2);
-            spi_2_isr_p = spi->func_p;
-            spi_2_user_data = spi->param_p;
-            break;
-        case SPI_3:
-            dev_cfg.spics_io_num = PIN_NUM_CS3;
-            if(transfer_mode_3 == SPI_INTERRUPT){
-                dev_cfg.post_cb = spi_3_isr;
-            } 
-            transfer_mode_1 = spi->transfer_mode;
-            spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_3);
-            spi_3_isr_p = spi->func_p;
-            spi_3_user_data = spi->param_p;
-            break;
+    if(spi->device >= SPI_DEVICES){
+        return 1;
+    }
+    dev = &spi_devices[spi->device];
+    SpiBusInit();
+    if(dev->handle != NULL){
+        /* Reconfiguration */
+        SpiDeInit(spi->device);
+    }
+    dev->transfer_mode = spi->transfer_mode;
+    dev->isr_p = spi->func_p;
+    dev->user_data = spi->param_p;
+    if(spi_bus_add_device(SPI2_HOST, &dev_cfg, &dev->handle) != ESP_OK){
+        dev->handle = NULL;
+        return 1;
     }
     return 0;
 }
 
 void SpiRead(spi_dev_t device, uint8_t * rx_buffer, uint32_t rx_buffer_size){
-    spi_transaction_t t;
-    memset(&t, 0, sizeof(t));       // Zero out the transaction
-    t.length = rx_buffer_size * 8;  // tx_buffer_size is in bytes, transaction length is in bits.
-    t.rxlength = rx_buffer_size * 8;
-    t.rx_buffer = rx_buffer;        // Data
-    switch(device){
-        case SPI_1:
-            switch(transfer_mode_1){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_1, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_1, &t); 
-                    break;
-            }
-            break;
-        case SPI_2:
-            switch(transfer_mode_2){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_2, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_2, &t); 
-                    break;
-            }
-            break;
-        case SPI_3:
-            switch(transfer_mode_3){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_3, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_3, &t); 
-                    break;
-            }
-            break;
-    }
+    SpiTransfer(device, NULL, rx_buffer, rx_buffer_size);
 }
 
 void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size){
-    spi_transaction_t t;
-    memset(&t, 0, sizeof(t));       // Zero out the transaction
-    t.length = tx_buffer_size * 8;  // tx_buffer_size is in bytes, transaction length is in bits.
-    t.tx_buffer = tx_buffer;        // Data
-    switch(device){
-        case SPI_1:
-            switch(transfer_mode_1){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_1, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_1, &t); 
-                    break;
-            }
-            break;
-        case SPI_2:
-            switch(transfer_mode_2){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_2, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_2, &t); 
-                    break;
-            }
-            break;
-        case SPI_3:
-            switch(transfer_mode_3){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_3, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_3, &t); 
-                    break;
-            }
-            break;
-    }
+    SpiTransfer(device, tx_buffer, NULL, tx_buffer_size);
 }
 
 void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size){
-    spi_transaction_t t;
-    memset(&t, 0, sizeof(t));       // Zero out the transaction
-    t.length = buffer_size * 8;     // tx_buffer_size is in bytes, transaction length is in bits.
-    t.rxlength = buffer_size * 8;
-    t.tx_buffer = tx_buffer;        // Data
-    t.rx_buffer = rx_buffer;        
-    switch(device){
-        case SPI_1:
-            switch(transfer_mode_1){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_1, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_1, &t); 
-                    break;
-            }
-            break;
-        case SPI_2:
-            switch(transfer_mode_2){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_2, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_2, &t); 
-                    break;
-            }
-            break;
-        case SPI_3:
-            switch(transfer_mode_3){
-                case SPI_POLLING:
-                    spi_device_polling_transmit(spi_3, &t); 
-                    break;
-                case SPI_INTERRUPT:
-                    spi_device_transmit(spi_3, &t); 
-                    break;
-            }
-            break;
+    SpiTransfer(device, tx_buffer, rx_buffer, buffer_size);
+}
+
+bool SpiBatchStart(const spi_transfer_t *transfers, uint8_t count, void *ptr_done_func, void *args){
+    if((count == 0) || (count > SPI_BATCH_MAX) || (spi_batch.collected < spi_batch.count)){
+        /* Invalid, or previous batch not collected with SpiBatchWait() */
+        return false;
+    }
+    for(uint8_t i = 0; i < count; i++){
+        if((transfers[i].device >= SPI_DEVICES) || (spi_devices[transfers[i].device].handle == NULL)){
+            return false;
+        }
+    }
+    spi_batch.count = count;
+    spi_batch.collected = 0;
+    spi_batch.finished = 0;
+    spi_batch.done_p = ptr_done_func;
+    spi_batch.done_data = args;
+    for(uint8_t i = 0; i < count; i++){
+        spi_device_state_t *dev = &spi_devices[transfers[i].device];
+        spi_transaction_t *t = &spi_batch.trans[i];
+        SpiFillTransaction(t, dev, transfers[i].command, transfers[i].tx_buffer, transfers[i].rx_buffer, transfers[i].size);
+        spi_batch.devices[i] = transfers[i].device;
+        spi_batch.rx_buffers[i] = transfers[i].rx_buffer;
+        spi_device_queue_trans(dev->handle, t, portMAX_DELAY);
+    }
+    return true;
+}
+
+bool SpiBatchWait(uint32_t timeout_ms){
+    TickType_t ticks = (timeout_ms == SPI_NO_TIMEOUT) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    while(spi_batch.collected < spi_batch.count){
+        /* Each device returns its own transactions in order */
+        spi_transaction_t *t;
+        if(spi_device_get_trans_result(spi_devices[spi_batch.devices[spi_batch.collected]].handle, &t, ticks) != ESP_OK){
+            return false;
+        }
+        if(t->flags & SPI_TRANS_USE_RXDATA){
+            memcpy(spi_batch.rx_buffers[t - spi_batch.trans], t->rx_data, t->rxlength / 8);
+        }
+        spi_batch.collected++;
+    }
+    return true;
+}
+
+bool SpiBusLock(spi_dev_t device, uint32_t timeout_ms){
+    TickType_t ticks = (timeout_ms == SPI_NO_TIMEOUT) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    if((device >= SPI_DEVICES) || (spi_devices[device].handle == NULL)){
+        return false;
+    }
+    return spi_device_acquire_bus(spi_devices[device].handle, ticks) == ESP_OK;
+}
+
+void SpiBusUnlock(spi_dev_t device){
+    if((device < SPI_DEVICES) && (spi_devices[device].handle != NULL)){
+        spi_device_release_bus(spi_devices[device].handle);
     }
 }
 
 uint8_t SpiDeInit(spi_dev_t device){
+    if((device >= SPI_DEVICES) || (spi_devices[device].handle == NULL)){
+        return 1;
+    }
+    spi_bus_remove_device(spi_devices[device].handle);
+    spi_devices[device].handle = NULL;
     return 0;
 }
 
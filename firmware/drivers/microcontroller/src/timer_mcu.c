@@ -135,6 +135,25 @@ void TimerStop(timer_mcu_t timer){
 	}
 }
 
+void TimerUpdatePeriod(timer_mcu_t timer, uint32_t period){
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = period, 
+		.reload_count = RESET_COUNT_VALUE,
+		.flags.auto_reload_on_alarm = true,
+	};
+	switch(timer){
+	 	case TIMER_A:
+			gptimer_set_alarm_action(timer_a, &alarm_config);
+	 	break;
+	 	case TIMER_B:
+			gptimer_set_alarm_action(timer_b, &alarm_config);
+	 	break;
+	 	case TIMER_C:
+			gptimer_set_alarm_action(timer_c, &alarm_config);
+	 	break;
+	}
+}
+
 void TimerReset(timer_mcu_t timer){
 	switch(timer){
 	 	case TIMER_A:
@@ -60,6 +60,7 @@ extern "C"
 
 #ifdef __cplusplus
 #include "mat.h"
+#include "fixed_mat.h"
 #endif
 
 #endif // _esp_dsp_H_
@@ -14,6 +14,7 @@
 
 #include "ekf.h"
 #include <float.h>
+#include <string.h>
 
 ekf::ekf(int x, int w) : NUMX(x),
     NUMW(w),
@@ -22,7 +23,15 @@ ekf::ekf(int x, int w) : NUMX(x),
     F(*new dspm::Mat(x, x)),
     G(*new dspm::Mat(x, w)),
     P(*new dspm::Mat(x, x)),
-    Q(*new dspm::Mat(w, w))
+    Q(*new dspm::Mat(w, w)),
+    Xlast(x, 1),
+    K1(x, 1),
+    K2(x, 1),
+    K3(x, 1),
+    K4(x, 1),
+    Fd(x, x),
+    FP(x, x),
+    GQ(x, w)
 {
 
     this->P *= 0;
@@ -35,6 +44,11 @@ ekf::ekf(int x, int w) : NUMX(x),
         this->HP[i] = 0;
         this->Km[i] = 0;
     }
+    this->Fd_nz = new uint16_t[x * x];
+    this->Fd_nz_count = new uint16_t[x];
+    this->G_nz = new uint16_t[x * w];
+    this->G_nz_count = new uint16_t[x];
+    this->h_nz = new uint16_t[x];
 }
 
 ekf::~ekf()
@@ -45,8 +59,13 @@ ekf::~ekf()
     delete &P;
     delete &Q;
 
-    delete this->HP;
-    delete this->Km;
+    delete[] this->HP;
+    delete[] this->Km;
+    delete[] this->Fd_nz;
+    delete[] this->Fd_nz_count;
+    delete[] this->G_nz;
+    delete[] this->G_nz_count;
+    delete[] this->h_nz;
 }
 
 void ekf::Process(float *u, float dt)
@@ -58,23 +77,34 @@ void ekf::Process(float *u, float dt)
 
 void ekf::RungeKutta(dspm::Mat &x, float *U, float dt)
 {
-
+    // All the steps work on the preallocated Xlast and K1..K4
     float dt2 = dt / 2.0f;
+    float dt6 = dt / 6.0f;
 
-    dspm::Mat Xlast = x;          // make a working copy
-    dspm::Mat K1 = StateXdot(x, U); // k1 = f(x, u)
-    x = Xlast + (K1 * dt2);
+    for (int i = 0; i < this->NUMX; i++) {
+        Xlast(i, 0) = x(i, 0);          // make a working copy
+    }
+    StateXdot(x, U, K1); // k1 = f(x, u)
+    for (int i = 0; i < this->NUMX; i++) {
+        x(i, 0) = Xlast(i, 0) + K1(i, 0) * dt2;
+    }
 
-    dspm::Mat K2 = StateXdot(x, U); // k2 = f(x + 0.5*dT*k1, u)
-    x = Xlast + K2 * dt2;
+    StateXdot(x, U, K2); // k2 = f(x + 0.5*dT*k1, u)
+    for (int i = 0; i < this->NUMX; i++) {
+        x(i, 0) = Xlast(i, 0) + K2(i, 0) * dt2;
+    }
 
-    dspm::Mat K3 = StateXdot(x, U); // k3 = f(x + 0.5*dT*k2, u)
-    x = Xlast + K3 * dt;
+    StateXdot(x, U, K3); // k3 = f(x + 0.5*dT*k2, u)
+    for (int i = 0; i < this->NUMX; i++) {
+        x(i, 0) = Xlast(i, 0) + K3(i, 0) * dt;
+    }
 
-    dspm::Mat K4 = StateXdot(x, U); // k4 = f(x + dT * k3, u)
+    StateXdot(x, U, K4); // k4 = f(x + dT * k3, u)
 
     // Xnew = X + dT * (k1 + 2 * k2 + 2 * k3 + k4) / 6
-    x = Xlast + (K1 + 2.0f * K2 + 2.0f * K3 + K4) * (dt / 6.0f);
+    for (int i = 0; i < this->NUMX; i++) {
+        x(i, 0) = Xlast(i, 0) + (K1(i, 0) + 2.0f * K2(i, 0) + 2.0f * K3(i, 0) + K4(i, 0)) * dt6;
+    }
 }
 
 dspm::Mat ekf::SkewSym4x4(float w[3])
@@ -137,65 +167,143 @@ dspm::Mat ekf::qProduct(float *q)
 
 void ekf::CovariancePrediction(float dt)
 {
-    dspm::Mat f = this->F * dt;
-
-    f = f + dspm::Mat::eye(this->NUMX);
-
-    dspm::Mat f_t = f.t();
-    this->P = ((f * this->P) * f_t) + (dt * dt) * ((G * Q) * G.t());
-}
+    // P = Fd*P*Fd' + dt^2*G*Q*G', with Fd = I + F*dt
+    // Fd and G are sparse (most of F and G are zero for the IMU models):
+    // the non zero elements of each row are listed once, and the products
+    // only use them. P is symmetric, only its upper triangle is calculated.
+    int n = this->NUMX;
+    int w = this->NUMW;
+    for (int i = 0; i < n; i++) {
+        uint16_t *nz = &Fd_nz[i * n];
+        uint16_t count = 0;
+        for (int j = 0; j < n; j++) {
+            float fd = this->F(i, j) * dt;
+            if (i == j) {
+                fd += 1.0f;
+            }
+            Fd(i, j) = fd;
+            if (fd != 0) {
+                nz[count++] = j;
+            }
+        }
+        Fd_nz_count[i] = count;
 
-void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
-{
-    float HPHR, Error;
-    dspm::Mat Y(measured, H.rows, 1);
-    dspm::Mat Z(expected, H.rows, 1);
+        nz = &G_nz[i * w];
+        count = 0;
+        for (int j = 0; j < w; j++) {
+            if (this->G(i, j) != 0) {
+                nz[count++] = j;
+            }
+        }
+        G_nz_count[i] = count;
+    }
 
-    for (int m = 0; m < H.rows; m++) {
-        for (int j = 0; j < this->NUMX; j++) {
-            // Find Hp = H*P
-            HP[j] = 0;
+    // FP = Fd*P and GQ = G*Q
+    for (int i = 0; i < n; i++) {
+        float *fp = &FP(i, 0);
+        for (int j = 0; j < n; j++) {
+            fp[j] = 0;
         }
-        for (int k = 0; k < this->NUMX; k++) {
-            for (int j = 0; j < this->NUMX; j++) {
-                // Find Hp = H*P
-                HP[j] += H(m, k) * P(k, j);
+        for (int c = 0; c < Fd_nz_count[i]; c++) {
+            int k = Fd_nz[i * n + c];
+            float fd = Fd(i, k);
+            const float *p = &this->P(k, 0);
+            for (int j = 0; j < n; j++) {
+                fp[j] += fd * p[j];
             }
         }
-        HPHR = R[m]; // Find  HPHR = H*P*H' + R
-        for (int k = 0; k < this->NUMX; k++) {
-            HPHR += HP[k] * H(m, k);
+        float *gq = &GQ(i, 0);
+        for (int j = 0; j < w; j++) {
+            gq[j] = 0;
         }
-        float invHPHR = 1.0f / HPHR;
-        for (int k = 0; k < this->NUMX; k++) {
-            Km[k] = HP[k] * invHPHR; // find K = HP/HPHR
+        for (int c = 0; c < G_nz_count[i]; c++) {
+            int k = G_nz[i * w + c];
+            float g = this->G(i, k);
+            const float *q = &this->Q(k, 0);
+            for (int j = 0; j < w; j++) {
+                gq[j] += g * q[j];
+            }
         }
-        for (int i = 0; i < this->NUMX; i++) {
-            // Find P(m)= P(m-1) + K*HP
-            for (int j = i; j < NUMX; j++) {
-                P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j];
+    }
+
+    // P(i, j) = FP(i, :)*Fd(j, :)' + dt^2*GQ(i, :)*G(j, :)', for j >= i
+    float dt_2 = dt * dt;
+    for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++) {
+            float fpf = 0;
+            for (int c = 0; c < Fd_nz_count[j]; c++) {
+                int k = Fd_nz[j * n + c];
+                fpf += FP(i, k) * Fd(j, k);
+            }
+            float gqg = 0;
+            for (int c = 0; c < G_nz_count[j]; c++) {
+                int k = G_nz[j * w + c];
+                gqg += GQ(i, k) * this->G(j, k);
             }
+            this->P(i, j) = this->P(j, i) = fpf + dt_2 * gqg;
         }
+    }
+}
+
+void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
+{
+    // Non correlated measurements: one scalar update per row of H
+    for (int m = 0; m < H.rows; m++) {
+        this->UpdateScalar(&H(m, 0), measured[m], expected[m], R[m]);
+    }
+}
 
-        Error = Y(m, 0) - Z(m, 0);
-        for (int i = 0; i < this->NUMX; i++) {
-            // Find X(m)= X(m-1) + K*Error
-            X(i, 0) = X(i, 0) + Km[i] * Error;
+void ekf::UpdateScalar(const float *h, float measured, float expected, float R)
+{
+    uint16_t count = 0;
+    for (int k = 0; k < this->NUMX; k++) {
+        if (h[k] != 0) {
+            h_nz[count++] = k;
+        }
+    }
+    for (int j = 0; j < this->NUMX; j++) {
+        // Find Hp = H*P
+        HP[j] = 0;
+    }
+    for (int c = 0; c < count; c++) {
+        int k = h_nz[c];
+        const float *p = &P(k, 0);
+        for (int j = 0; j < this->NUMX; j++) {
+            HP[j] += h[k] * p[j];
+        }
+    }
+    float HPHR = R; // Find  HPHR = H*P*H' + R
+    for (int c = 0; c < count; c++) {
+        HPHR += HP[h_nz[c]] * h[h_nz[c]];
+    }
+    float invHPHR = 1.0f / HPHR;
+    for (int k = 0; k < this->NUMX; k++) {
+        Km[k] = HP[k] * invHPHR; // find K = HP/HPHR
+    }
+    for (int i = 0; i < this->NUMX; i++) {
+        // Find P(m)= P(m-1) + K*HP
+        for (int j = i; j < NUMX; j++) {
+            P(i, j) = P(j, i) = P(i, j) - Km[i] * HP[j];
         }
     }
+
+    float Error = measured - expected;
+    for (int i = 0; i < this->NUMX; i++) {
+        // Find X(m)= X(m-1) + K*Error
+        X(i, 0) = X(i, 0) + Km[i] * Error;
+    }
 }
 
 void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
 {
-    dspm::Mat h_t = H.t();
-    dspm::Mat S = H * P * h_t; // +diag(R);
+    dspm::Mat S = H * P * H.t(); // +diag(R);
     for (size_t i = 0; i < H.rows; i++) {
         S(i, i) += R[i];
     }
 
     dspm::Mat S_ = S.pinv(); // 1 / S
 
-    dspm::Mat K = (P * h_t) * S_;
+    dspm::Mat K = P * H.t() * S_;
     this->P = (dspm::Mat::eye(this->NUMX) - K * H) * P;
 
     dspm::Mat Y(measured, H.rows, 1);
@@ -206,12 +314,18 @@ void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
 }
 
 dspm::Mat ekf::quat2rotm(float q[4])
+{
+    dspm::Mat Rm(3, 3);
+    quat2rotm(q, Rm);
+    return Rm;
+}
+
+void ekf::quat2rotm(const float q[4], dspm::Mat &Rm)
 {
     float q0 = q[0];
     float q1 = q[1];
     float q2 = q[2];
     float q3 = q[3];
-    dspm::Mat Rm(3, 3);
 
     Rm(0, 0) = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
     Rm(1, 0) = 2.0f * (q1 * q2 + q0 * q3);
@@ -222,8 +336,6 @@ dspm::Mat ekf::quat2rotm(float q[4])
     Rm(0, 2) = 2.0f * (q1 * q3 + q0 * q2);
     Rm(1, 2) = 2.0f * (q2 * q3 - q0 * q1);
     Rm(2, 2) = (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
-
-    return Rm;
 }
 
 dspm::Mat ekf::quat2eul(const float q[4])
@@ -388,28 +500,36 @@ dspm::Mat ekf::dFdq(dspm::Mat &vector, dspm::Mat &q)
 dspm::Mat ekf::dFdq_inv(dspm::Mat &vector, dspm::Mat &q)
 {
     dspm::Mat result(3, 4);
-    result(0, 0) = q.data[0] * vector.data[0] + q.data[3] * vector.data[1] - q.data[2] * vector.data[2];
-    result(0, 1) = q.data[1] * vector.data[0] + q.data[2] * vector.data[1] + q.data[3] * vector.data[2];
-    result(0, 2) = -q.data[2] * vector.data[0] + q.data[1] * vector.data[1] - q.data[0] * vector.data[2];
-    result(0, 3) = -q.data[3] * vector.data[0] + q.data[0] * vector.data[1] + q.data[1] * vector.data[2];
-
-    result(1, 0) = -q.data[3] * vector.data[0] + q.data[0] * vector.data[1] + q.data[1] * vector.data[2];
-    result(1, 1) = q.data[2] * vector.data[0] - q.data[1] * vector.data[1] + q.data[0] * vector.data[2];
-    result(1, 2) = q.data[1] * vector.data[0] + q.data[2] * vector.data[1] + q.data[3] * vector.data[2];
-    result(1, 3) = -q.data[0] * vector.data[0] - q.data[3] * vector.data[1] + q.data[2] * vector.data[2];
-
-    result(2, 0) = q.data[2] * vector.data[0] - q.data[1] * vector.data[1] + q.data[0] * vector.data[2];
-    result(2, 1) = q.data[3] * vector.data[0] - q.data[0] * vector.data[1] - q.data[1] * vector.data[2];
-    result(2, 2) = q.data[0] * vector.data[0] + q.data[3] * vector.data[1] - q.data[2] * vector.data[2];
-    result(2, 3) = q.data[1] * vector.data[0] + q.data[2] * vector.data[1] + q.data[3] * vector.data[2];
-
-    result *= 2;
+    dFdq_inv(vector.data, q.data, result);
     return result;
 }
 
+void ekf::dFdq_inv(const float *v, const float *q, dspm::Mat &result)
+{
+    result(0, 0) = 2 * (q[0] * v[0] + q[3] * v[1] - q[2] * v[2]);
+    result(0, 1) = 2 * (q[1] * v[0] + q[2] * v[1] + q[3] * v[2]);
+    result(0, 2) = 2 * (-q[2] * v[0] + q[1] * v[1] - q[0] * v[2]);
+    result(0, 3) = 2 * (-q[3] * v[0] + q[0] * v[1] + q[1] * v[2]);
+
+    result(1, 0) = 2 * (-q[3] * v[0] + q[0] * v[1] + q[1] * v[2]);
+    result(1, 1) = 2 * (q[2] * v[0] - q[1] * v[1] + q[0] * v[2]);
+    result(1, 2) = 2 * (q[1] * v[0] + q[2] * v[1] + q[3] * v[2]);
+    result(1, 3) = 2 * (-q[0] * v[0] - q[3] * v[1] + q[2] * v[2]);
+
+    result(2, 0) = 2 * (q[2] * v[0] - q[1] * v[1] + q[0] * v[2]);
+    result(2, 1) = 2 * (q[3] * v[0] - q[0] * v[1] - q[1] * v[2]);
+    result(2, 2) = 2 * (q[0] * v[0] + q[3] * v[1] - q[2] * v[2]);
+    result(2, 3) = 2 * (q[1] * v[0] + q[2] * v[1] + q[3] * v[2]);
+}
+
 dspm::Mat ekf::StateXdot(dspm::Mat &x, float *u)
 {
     dspm::Mat U(u, this->G.cols, 1);
     dspm::Mat Xdot = (this->F * x + this->G * U);
     return Xdot;
 }
+
+void ekf::StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot)
+{
+    xdot = StateXdot(x, u);
+}
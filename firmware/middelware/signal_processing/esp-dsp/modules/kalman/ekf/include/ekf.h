@@ -31,7 +31,8 @@ public:
 
     /**
      * Constructor of EKF.
-     * THe constructor allocate main memory for the matrixes.
+     * THe constructor allocate main memory for the matrixes, and the
+     * workspaces of Process(): a filter step doesn't use the heap.
      * @param[in] x: - amount of states in EKF. x[n] = F*x[n-1] + G*u + W. Size of matrix F
      * @param[in] w: - amount of control measurements and noise inputs. Size of matrix G
     */
@@ -112,6 +113,15 @@ public:
      *      - derivative of input vector x and u
      */
     virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
+    /**
+     * Derivative of state vector X, without heap allocation.
+     * Used by RungeKutta(). The default implementation calls StateXdot(x, u):
+     * systems should override this method to have an allocation free Process().
+     * @param[in] x: state vector
+     * @param[in] u: control measurement
+     * @param[out] xdot: derivative of input vector x and u (NUMX x 1)
+     */
+    virtual void StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot);
     /**
      * Calculation of system state matrices F and G
      * @param[in] x: state vector
@@ -139,6 +149,17 @@ public:
      * @param[in] R: measurement noise covariance values
      */
     virtual void Update(dspm::Mat &H, float *measured, float *expected, float *R);
+    /**
+     * Update of current state by one scalar measurement.
+     * Used by Update() for each row of H: non correlated measurements need
+     * no matrix inversion. Zero elements of h are skipped, and only the
+     * upper triangle of P is calculated (and copied to the lower one).
+     * @param[in] h: derivative row (NUMX values)
+     * @param[in] measured: measured value
+     * @param[in] expected: expected value
+     * @param[in] R: measurement noise variance
+     */
+    virtual void UpdateScalar(const float *h, float measured, float expected, float R);
     /**
      * Update of current state by measured values.
      * This method just as a reference for research purpose.
@@ -159,6 +180,28 @@ public:
     */
     float *Km;
 
+    /**
+     * Workspaces of RungeKutta(): state copy and derivatives (NUMX x 1)
+    */
+    dspm::Mat Xlast, K1, K2, K3, K4;
+    /**
+     * Workspaces of CovariancePrediction(): discrete F and F*P (NUMX x NUMX)
+    */
+    dspm::Mat Fd, FP;
+    /**
+     * Workspace of CovariancePrediction(): G*Q (NUMX x NUMW)
+    */
+    dspm::Mat GQ;
+    /**
+     * Columns of the non zero elements of each row of Fd (NUMX x NUMX) and G (NUMX x NUMW),
+     * and their amount per row (NUMX). Used by CovariancePrediction() to skip zeros.
+    */
+    uint16_t *Fd_nz, *Fd_nz_count, *G_nz, *G_nz_count;
+    /**
+     * Workspace of UpdateScalar(): columns of the non zero elements of h (NUMX)
+    */
+    uint16_t *h_nz;
+
 public:
     // Additional universal helper methods
     /**
@@ -170,6 +213,13 @@ public:
      */
     static dspm::Mat quat2rotm(float q[4]);
 
+    /**
+     * Convert quaternion to rotation matrix, without heap allocation.
+     * @param[in] q: quaternion
+     * @param[out] Rm: rotation matrix 3x3
+     */
+    static void quat2rotm(const float q[4], dspm::Mat &Rm);
+
     /**
      * Convert rotation matrix to quaternion.
      * @param[in] R: rotation matrix
@@ -225,6 +275,14 @@ public:
      */
     static dspm::Mat dFdq_inv(dspm::Mat &vector, dspm::Mat &quat);
 
+    /**
+     * Df/dq: Derivative of vector by inverted quaternion, without heap allocation.
+     * @param[in] vector: input vector
+     * @param[in] quat: quaternion
+     * @param[out] result: derivative matrix 3x4 (can be a sub-matrix, e.g. a part of H)
+     */
+    static void dFdq_inv(const float *vector, const float *quat, dspm::Mat &result);
+
     /**
      * Make skew-symmetric matrix of vector.
      * @param[in] w: source vector
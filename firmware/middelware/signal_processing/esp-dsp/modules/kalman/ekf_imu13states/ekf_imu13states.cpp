@@ -16,7 +16,10 @@
 
 ekf_imu13states::ekf_imu13states() : ekf(13, 18),
     mag0(3, 1),
-    accel0(3, 1)
+    accel0(3, 1),
+    Href(6, 13),
+    HrefAtt(10, 13),
+    Rm(3, 3)
 {
     this->NUMU = 3;
 }
@@ -51,53 +54,84 @@ void ekf_imu13states::Init()
 }
 
 dspm::Mat ekf_imu13states::StateXdot(dspm::Mat &x, float *u)
+{
+    dspm::Mat Xdot(this->NUMX, 1);
+    StateXdot(x, u, Xdot);
+    return Xdot;
+}
+
+void ekf_imu13states::StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot)
 {
     float wx = u[0] - x(4, 0); // subtract the biases on gyros
     float wy = u[1] - x(5, 0);
     float wz = u[2] - x(6, 0);
-
-    float w[] = {wx, wy, wz};
-    dspm::Mat q = dspm::Mat(x.data, 4, 1);
-
-    // qdot = Q * w
-    dspm::Mat Omega = 0.5 * SkewSym4x4(w);
-    dspm::Mat qdot = Omega * q;
-    dspm::Mat Xdot(this->NUMX, 1);
-    Xdot *= 0;
-    Xdot.Copy(qdot, 0, 0);
+    float q0 = x(0, 0);
+    float q1 = x(1, 0);
+    float q2 = x(2, 0);
+    float q3 = x(3, 0);
+
+    // qdot = 0.5 * SkewSym4x4(w) * q
+    xdot(0, 0) = 0.5f * (-wx * q1 - wy * q2 - wz * q3);
+    xdot(1, 0) = 0.5f * (wx * q0 + wz * q2 - wy * q3);
+    xdot(2, 0) = 0.5f * (wy * q0 - wz * q1 + wx * q3);
+    xdot(3, 0) = 0.5f * (wz * q0 + wy * q1 - wx * q2);
     // dwbias = 0
     // dMang_Ampl = 0
     // dMang_offset = 0
-    return Xdot;
+    for (int i = 4; i < this->NUMX; i++) {
+        xdot(i, 0) = 0;
+    }
 }
 
 void ekf_imu13states::LinearizeFG(dspm::Mat &x, float *u)
 {
     float w[3] = {(u[0] - x(4, 0)), (u[1] - x(5, 0)), (u[2] - x(6, 0))}; // subtract the biases on gyros
-    // float w[3] = {u[0], u[1], u[2]}; // subtract the biases on gyros
-
-    this->F *= 0; // Initialize F and G matrixes.
-    this->G *= 0;
-
-    // dqdot / dq - skey matrix
-    F.Copy(0.5 * ekf::SkewSym4x4(w), 0, 0);
-
-    // dqdot/dvector
-    dspm::Mat dq = -0.5 * qProduct(x.data);
-    dspm::Mat dq_q = dq.Get(0, 4, 1, 3);
-
-    // dqdot / dnw
-    G.Copy(dq_q, 0, 0);
-    // dqdot / dwbias
-    F.Copy(dq_q, 0, 4);
-
-    dspm::Mat rotm = -1 * this->quat2rotm(x.data); // Convert quat to rotation matrix
+    float q0 = x(0, 0);
+    float q1 = x(1, 0);
+    float q2 = x(2, 0);
+    float q3 = x(3, 0);
+
+    this->F.clear(); // Initialize F and G matrixes.
+    this->G.clear();
+
+    // dqdot / dq - skew matrix: 0.5 * SkewSym4x4(w)
+    F(0, 1) = -0.5f * w[0];
+    F(0, 2) = -0.5f * w[1];
+    F(0, 3) = -0.5f * w[2];
+    F(1, 0) = 0.5f * w[0];
+    F(1, 2) = 0.5f * w[2];
+    F(1, 3) = -0.5f * w[1];
+    F(2, 0) = 0.5f * w[1];
+    F(2, 1) = -0.5f * w[2];
+    F(2, 3) = 0.5f * w[0];
+    F(3, 0) = 0.5f * w[2];
+    F(3, 1) = 0.5f * w[1];
+    F(3, 2) = -0.5f * w[0];
+
+    // dqdot/dvector: columns 1..3 of -0.5 * qProduct(q)
+    float dq_q[4][3] = {
+        { 0.5f * q1,  0.5f * q2,  0.5f * q3},
+        {-0.5f * q0,  0.5f * q3, -0.5f * q2},
+        {-0.5f * q3, -0.5f * q0,  0.5f * q1},
+        { 0.5f * q2, -0.5f * q1, -0.5f * q0},
+    };
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 3; c++) {
+            G(r, c) = dq_q[r][c];     // dqdot / dnw
+            F(r, 4 + c) = dq_q[r][c]; // dqdot / dwbias
+        }
+    }
 
-    G.Copy(rotm, 7, 6);
-    G.Copy(dspm::Mat::eye(3), 4, 3);   // random noise wbias
-    G.Copy(dspm::Mat::eye(3), 7, 12);  // random noise magnetometer amplitude
-    G.Copy(dspm::Mat::eye(3), 10, 9);  // magnetometer offset constant
-    G.Copy(dspm::Mat::eye(3), 10, 15); // random noise offset constant
+    ekf::quat2rotm(x.data, Rm); // Convert quat to rotation matrix
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            G(7 + r, 6 + c) = -Rm(r, c);
+        }
+        G(4 + r, 3 + r) = 1;   // random noise wbias
+        G(7 + r, 12 + r) = 1;  // random noise magnetometer amplitude
+        G(10 + r, 9 + r) = 1;  // magnetometer offset constant
+        G(10 + r, 15 + r) = 1; // random noise offset constant
+    }
 }
 
 void ekf_imu13states::Test()
@@ -184,110 +218,90 @@ void ekf_imu13states::TestFull(bool enable_att)
     std::cout << "Final State data : " << this->X.t() << std::endl;
 }
 
-void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
+void ekf_imu13states::RefMeasurement(dspm::Mat &H, float *accel_data, float *magn_data, bool magn_state, float *measured, float *expected)
 {
-    dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
-
+    float *quat = this->X.data;
+    float *magn = &this->X.data[7];
+    float *magn_offset = &this->X.data[10];
+
+    H.clear();
+    ekf::quat2rotm(quat, Rm); // Re = Rm'
+
+    if (magn_state) {
+        // We include these two lines to update magnetometer initial state
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                H(r, 7 + c) = Rm(c, r);
+            }
+            H(r, 10 + r) = 1;
+        }
+    }
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
-
+    dspm::Mat dAccel_dq = H.getROI(3, 0, 3, 4);
+    ekf::dFdq_inv(this->accel0.data, quat, dAccel_dq);
     // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    dspm::Mat dMagn_dq = H.getROI(0, 0, 3, 4);
+    ekf::dFdq_inv(magn, quat, dMagn_dq);
+
+    // expected_magn = Re * magn + magn_offset, expected_accel = Re * accel0
+    for (int i = 0; i < 3; i++) {
+        float em = magn_offset[i];
+        float ea = 0;
+        for (int k = 0; k < 3; k++) {
+            em += Rm(k, i) * magn[k];
+            ea += Rm(k, i) * this->accel0.data[k];
+        }
+        measured[i] = magn_data[i];
+        expected[i] = em;
+        measured[i + 3] = accel_data[i];
+        expected[i + 3] = ea;
+    }
+}
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+void ekf_imu13states::NormalizeQuat()
+{
+    float *quat = this->X.data;
+    float norm = sqrtf(quat[0] * quat[0] + quat[1] * quat[1] + quat[2] * quat[2] + quat[3] * quat[3]);
+    for (int i = 0; i < 4; i++) {
+        quat[i] /= norm;
+    }
+}
 
+void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
+{
     float measured_data[6];
     float expected_data[6];
-    for (size_t i = 0; i < 3; i++) {
-        measured_data[i] = magn_data[i];
-        expected_data[i] = expected_magn.data[i];
-        measured_data[i + 3] = accel_data[i];
-        expected_data[i + 3] = expected_accel.data[i];
-    }
 
-    this->Update(H, measured_data, expected_data, R);
-    quat /= quat.norm();
+    RefMeasurement(Href, accel_data, magn_data, false, measured_data, expected_data);
+    this->Update(Href, measured_data, expected_data, R);
+    NormalizeQuat();
 }
 
 void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_data, float R[6])
 {
-    dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
-
-    // We include these two line to update magnetometer initial state
-    H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
-
-    // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
-
-    // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
-
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
-
     float measured_data[6];
     float expected_data[6];
-    for (size_t i = 0; i < 3; i++) {
-        measured_data[i] = magn_data[i];
-        expected_data[i] = expected_magn.data[i];
-        measured_data[i + 3] = accel_data[i];
-        expected_data[i + 3] = expected_accel.data[i];
-    }
 
-    this->Update(H, measured_data, expected_data, R);
-    quat /= quat.norm();
+    RefMeasurement(Href, accel_data, magn_data, true, measured_data, expected_data);
+    this->Update(Href, measured_data, expected_data, R);
+    NormalizeQuat();
 }
 
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10])
 {
-    dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(10, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
-
-    H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
-    // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
-    // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
-
-    // dq/dq
-    H.Copy(dspm::Mat::eye(4), 6, 1);
-
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
-
     float measured_data[10];
     float expected_data[10];
-    for (size_t i = 0; i < 3; i++) {
-        measured_data[i] = magn_data[i];
-        expected_data[i] = expected_magn.data[i];
-        measured_data[i + 3] = accel_data[i];
-        expected_data[i + 3] = expected_accel.data[i];
+
+    RefMeasurement(HrefAtt, accel_data, magn_data, true, measured_data, expected_data);
+    // dq/dq
+    for (int i = 0; i < 4; i++) {
+        HrefAtt(6 + i, 1 + i) = 1;
     }
     for (size_t i = 0; i < 4; i++) {
         measured_data[i + 6] = attitude[i];
         expected_data[i + 6] = this->X.data[i];
     }
 
-    this->Update(H, measured_data, expected_data, R);
-    quat /= quat.norm();
+    this->Update(HrefAtt, measured_data, expected_data, R);
+    NormalizeQuat();
 }
@@ -37,6 +37,7 @@ public:
     // Method calculates Xdot values depends on U
     // U - gyroscope values in radian per seconds (rad/sec)
     virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
+    virtual void StateXdot(dspm::Mat &x, float *u, dspm::Mat &xdot);
     virtual void LinearizeFG(dspm::Mat &x, float *u);
 
     /**
@@ -93,6 +94,21 @@ public:
      */
     void UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10]);
 
+    /**
+     * Workspaces of the reference measurement updates: H of the accelerometer and
+     * magnetometer updates (6 x NUMX), H with attitude (10 x NUMX) and rotation matrix (3 x 3)
+     */
+    dspm::Mat Href, HrefAtt, Rm;
+
+private:
+    /**
+     * Fill the accelerometer and magnetometer rows of H (rows 0..5), and the measured and expected values.
+     *
+     * @param[in] H: derivative matrix
+     * @param[in] magn_state: magnetometer vector and offset rows are included (calibration)
+     */
+    void RefMeasurement(dspm::Mat &H, float *accel_data, float *magn_data, bool magn_state, float *measured, float *expected);
+    void NormalizeQuat();
 };
 
 #endif // _ekf_imu13states_H_
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string.h>
+#include <stdlib.h>
 #include "unity.h"
 #include "dsp_platform.h"
 #include "esp_log.h"
@@ -22,6 +23,48 @@
 
 static const char *TAG = "ekf_imu13states";
 
+// Heap allocations made through new/new[] (dspm::Mat buffers) while counting is enabled
+static volatile int alloc_count = 0;
+static volatile bool alloc_counting = false;
+
+void *operator new(size_t size)
+{
+    if (alloc_counting) {
+        alloc_count++;
+    }
+    void *ptr = malloc(size);
+    if (ptr == NULL) {
+        abort();
+    }
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+// Sized versions (C++14), so every delete matches the replaced operator new
+void operator delete(void *ptr, size_t size) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void *ptr, size_t size) noexcept
+{
+    operator delete[](ptr);
+}
+
 
 TEST_CASE("ekf_imu13states functionality gyro only", "[dspm]")
 {
@@ -58,3 +101,94 @@ TEST_CASE("ekf_imu13states functionality gyro and magn", "[dspm]")
     printf("Expected result = %i, calculated result = %i\n", 200, (int)(1000 * ekf13->X.data[5] + 0.5));
     printf("Expected result = %i, calculated result = %i\n", 300, (int)(1000 * ekf13->X.data[6] + 0.5));
 }
+
+TEST_CASE("ekf_imu13states no heap allocation in Process and Update", "[dspm]")
+{
+    ekf_imu13states *ekf13 = new  ekf_imu13states();
+    ekf13->Init();
+    float gyro[3] = {0.1, 0.2, 0.3};
+    float accel[3] = {0, 0, 1};
+    float magn[3] = {1, 0, 0};
+    float attitude[4] = {1, 0, 0, 0};
+    float R[10];
+    for (size_t i = 0; i < 10; i++) {
+        R[i] = 0.01;
+    }
+
+    alloc_count = 0;
+    alloc_counting = true;
+    unsigned int start_b = xthal_get_ccount();
+    for (int n = 0; n < 200; n++) {
+        ekf13->Process(gyro, 0.005);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    int process_allocs = alloc_count;
+    for (int n = 0; n < 200; n++) {
+        ekf13->UpdateRefMeasurement(accel, magn, R);
+        ekf13->UpdateRefMeasurementMagn(accel, magn, R);
+        ekf13->UpdateRefMeasurement(accel, magn, attitude, R);
+    }
+    alloc_counting = false;
+    ESP_LOGI(TAG, "Process: %i cycles", (end_b - start_b) / 200);
+
+    TEST_ASSERT_EQUAL(0, process_allocs);
+    TEST_ASSERT_EQUAL(0, alloc_count - process_allocs);
+    delete ekf13;
+}
+
+TEST_CASE("ekf_imu13states benchmark", "[dspm]")
+{
+    ekf_imu13states *ekf13 = new  ekf_imu13states();
+    ekf13->Init();
+    float gyro[3] = {0.1, 0.2, 0.3};
+    float measured[3] = {0.01, 0.02, 0.99};
+    float expected[3] = {0, 0.1, 0.2};
+    float R[3] = {0.01, 0.01, 0.01};
+    const int repeat = 100;
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int n = 0; n < repeat; n++) {
+        ekf13->Process(gyro, 0.005);
+    }
+    unsigned int end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "Process: %i cycles", (end_b - start_b) / repeat);
+
+    // Covariance propagation keeps P exactly symmetric
+    for (int i = 0; i < ekf13->NUMX; i++) {
+        for (int j = i + 1; j < ekf13->NUMX; j++) {
+            TEST_ASSERT_TRUE(ekf13->P(i, j) == ekf13->P(j, i));
+        }
+    }
+
+    dspm::Mat H(3, ekf13->NUMX);
+    H *= 0;
+    ekf::dFdq_inv(ekf13->accel0.data, ekf13->X.data, H);
+    dspm::Mat X0 = ekf13->X;
+    dspm::Mat P0 = ekf13->P;
+
+    // Sequential scalar updates
+    start_b = xthal_get_ccount();
+    for (int n = 0; n < repeat; n++) {
+        ekf13->X = X0;
+        ekf13->P = P0;
+        ekf13->Update(H, measured, expected, R);
+    }
+    end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "Update (sequential): %i cycles", (end_b - start_b) / repeat);
+    dspm::Mat X_seq = ekf13->X;
+
+    // Full gain with the inverse of H*P*H' + R
+    start_b = xthal_get_ccount();
+    for (int n = 0; n < repeat; n++) {
+        ekf13->X = X0;
+        ekf13->P = P0;
+        ekf13->UpdateRef(H, measured, expected, R);
+    }
+    end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "UpdateRef (inverse): %i cycles", (end_b - start_b) / repeat);
+
+    for (int i = 0; i < ekf13->NUMX; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, ekf13->X(i, 0), X_seq(i, 0));
+    }
+    delete ekf13;
+}
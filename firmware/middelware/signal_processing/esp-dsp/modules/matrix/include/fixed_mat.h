@@ -0,0 +1,487 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dspm_fixed_mat_h_
+#define _dspm_fixed_mat_h_
+#include "mat.h"
+#include "esp_log.h"
+
+/**
+ * Products with up to this amount of multiplications (3x3x3, 4x4x4, 4x4x1...)
+ * and element-wise operations with up to this amount of elements are fully
+ * unrolled. Bigger ones only unroll the dot products (the rows/columns are
+ * loops), to keep the code size reasonable.
+ */
+#ifndef DSPM_FIXED_UNROLL_MAX
+#define DSPM_FIXED_UNROLL_MAX 64
+#endif
+
+/**
+ * The kernels are expanded in the caller even without optimizations (-Og)
+ */
+#define DSPM_FIXED_INLINE inline __attribute__((always_inline))
+
+namespace dspm {
+
+/**
+ * @brief   Unrolled dot product
+ *
+ * sum of a[k * A_STEP] * b[k * B_STEP] for k = 0..N-1, added in order
+ * (the same result as dspm_mult_f32).
+ */
+template <int N, int A_STEP, int B_STEP>
+struct FixedDot {
+    static DSPM_FIXED_INLINE float run(const float *a, const float *b)
+    {
+        return FixedDot<N - 1, A_STEP, B_STEP>::run(a, b) + a[(N - 1) * A_STEP] * b[(N - 1) * B_STEP];
+    }
+};
+template <int A_STEP, int B_STEP>
+struct FixedDot<1, A_STEP, B_STEP> {
+    static DSPM_FIXED_INLINE float run(const float *a, const float *b)
+    {
+        return a[0] * b[0];
+    }
+};
+
+/**
+ * @brief   Product kernel
+ *
+ * c[i][j] = sum of a[i * A_ROW + k * A_COL] * b[k * B_ROW + j * B_COL],
+ * for a result of R x C and K terms. The steps select A or its transpose,
+ * and B or its transpose, without copies. c must not be a or b.
+ */
+template <int R, int K, int C, int A_ROW, int A_COL, int B_ROW, int B_COL,
+          bool UNROLL = (R * K * C <= DSPM_FIXED_UNROLL_MAX)>
+struct FixedProduct {
+    static DSPM_FIXED_INLINE void run(const float *a, const float *b, float *c)
+    {
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                c[i * C + j] = FixedDot<K, A_COL, B_ROW>::run(a + i * A_ROW, b + j * B_COL);
+            }
+        }
+    }
+};
+template <int N, int K, int C, int A_ROW, int A_COL, int B_ROW, int B_COL>
+struct FixedProductElements {
+    static DSPM_FIXED_INLINE void run(const float *a, const float *b, float *c)
+    {
+        FixedProductElements < N - 1, K, C, A_ROW, A_COL, B_ROW, B_COL >::run(a, b, c);
+        c[N - 1] = FixedDot<K, A_COL, B_ROW>::run(a + ((N - 1) / C) * A_ROW, b + ((N - 1) % C) * B_COL);
+    }
+};
+template <int K, int C, int A_ROW, int A_COL, int B_ROW, int B_COL>
+struct FixedProductElements<0, K, C, A_ROW, A_COL, B_ROW, B_COL> {
+    static DSPM_FIXED_INLINE void run(const float *, const float *, float *) {}
+};
+template <int R, int K, int C, int A_ROW, int A_COL, int B_ROW, int B_COL>
+struct FixedProduct<R, K, C, A_ROW, A_COL, B_ROW, B_COL, true> {
+    static DSPM_FIXED_INLINE void run(const float *a, const float *b, float *c)
+    {
+        FixedProductElements<R * C, K, C, A_ROW, A_COL, B_ROW, B_COL>::run(a, b, c);
+    }
+};
+
+/**
+ * @brief   Element-wise operations
+ */
+struct FixedOpAdd {
+    static DSPM_FIXED_INLINE float apply(float a, float b)
+    {
+        return a + b;
+    }
+};
+struct FixedOpSub {
+    static DSPM_FIXED_INLINE float apply(float a, float b)
+    {
+        return a - b;
+    }
+};
+struct FixedOpMul {
+    static DSPM_FIXED_INLINE float apply(float a, float b)
+    {
+        return a * b;
+    }
+};
+
+/**
+ * @brief   Element-wise kernel
+ *
+ * c[i] = Op(a[i], b[i * B_STEP]) for N elements: B_STEP = 0 for a scalar
+ * operand. c can be a or b.
+ */
+template <int N, int B_STEP, typename Op, bool UNROLL = (N <= DSPM_FIXED_UNROLL_MAX)>
+struct FixedElementwise {
+    static DSPM_FIXED_INLINE void run(const float *a, const float *b, float *c)
+    {
+        for (int i = 0; i < N; i++) {
+            c[i] = Op::apply(a[i], b[i * B_STEP]);
+        }
+    }
+};
+template <int N, int B_STEP, typename Op>
+struct FixedElementwise<N, B_STEP, Op, true> {
+    static DSPM_FIXED_INLINE void run(const float *a, const float *b, float *c)
+    {
+        FixedElementwise < N - 1, B_STEP, Op, true >::run(a, b, c);
+        c[N - 1] = Op::apply(a[N - 1], b[(N - 1) * B_STEP]);
+    }
+};
+template <int B_STEP, typename Op>
+struct FixedElementwise<0, B_STEP, Op, true> {
+    static DSPM_FIXED_INLINE void run(const float *, const float *, float *) {}
+};
+
+/**
+ * @brief   Matrix with dimensions known at compile time
+ *
+ * The elements are stored inside the object (row-major, no padding): on the
+ * stack, in a static variable or in another object, without heap
+ * allocations. The arithmetic is expanded for the exact size, so small
+ * matrices (3x3, 4x4, 3x1...) have no loop overhead, and wrong dimensions
+ * are compile errors.
+ *
+ * Mat interoperability: view() is a Mat that uses this buffer (no copy),
+ * so any Mat method or function can read and write it, and getROI() gives
+ * sub-matrices of it. A Mat (or a Mat ROI) of the right size can be copied
+ * in with the constructor and out with copyTo().
+ *
+ * @tparam R: amount of rows
+ * @tparam C: amount of columns
+ */
+template <int R, int C>
+class FixedMat {
+    static_assert(R > 0 && C > 0, "FixedMat dimensions must be positive");
+public:
+    static constexpr int rows = R;      /*!< Amount of rows*/
+    static constexpr int cols = C;      /*!< Amount of columns*/
+    static constexpr int length = R * C;/*!< Total amount of elements*/
+    float data[R * C];                  /*!< Matrix data*/
+
+    /**
+     * Matrix with all the elements 0.
+     */
+    FixedMat() : data() {}
+
+    /**
+     * Matrix with a copy of the data.
+     * @param[in] values: R * C elements, row-major
+     */
+    explicit FixedMat(const float *values)
+    {
+        for (int i = 0; i < R * C; i++) {
+            data[i] = values[i];
+        }
+    }
+
+    /**
+     * Matrix with a copy of a Mat.
+     * If the Mat is not R x C, the error is logged and the matrix is 0.
+     * @param[in] m: matrix or sub-matrix (ROI)
+     */
+    explicit FixedMat(const Mat &m) : data()
+    {
+        if ((m.rows != R) || (m.cols != C)) {
+            matSizeError("FixedMat(Mat)");
+            return;
+        }
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                data[i * C + j] = m.data[i * m.stride + j];
+            }
+        }
+    }
+
+    /**
+     * Copy the matrix into a Mat.
+     * @param[out] m: R x C matrix or sub-matrix (ROI)
+     *
+     * @return
+     *      - false if m is not R x C (nothing is copied)
+     */
+    bool copyTo(Mat &m) const
+    {
+        if ((m.rows != R) || (m.cols != C)) {
+            matSizeError("FixedMat::copyTo");
+            return false;
+        }
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                m.data[i * m.stride + j] = data[i * C + j];
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    float &operator()(int row, int col)
+    {
+        return data[row * C + col];
+    }
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    const float &operator()(int row, int col) const
+    {
+        return data[row * C + col];
+    }
+
+    /**
+     * Mat that uses the buffer of this matrix.
+     * Changes through the Mat are changes of this matrix. Assign it to a Mat
+     * variable (not at its declaration) to get a copy.
+     *
+     * @return
+     *      - R x C Mat with external buffer
+     */
+    Mat view()
+    {
+        return Mat(data, R, C);
+    }
+
+    /**
+     * Sub-matrix of this matrix (no copy).
+     * @param[in] startRow: start row position of area of interest (ROI)
+     * @param[in] startCol: start column position of area of interest (ROI)
+     * @param[in] roiRows: amount of rows of ROI
+     * @param[in] roiCols: amount of columns of ROI
+     *
+     * @return
+     *      - Mat ROI that refers to the data of this matrix
+     *      - empty Mat (0 x 0) if the ROI is not inside the matrix
+     */
+    Mat getROI(int startRow, int startCol, int roiRows, int roiCols)
+    {
+        if ((startRow < 0) || (startCol < 0) || (roiRows < 0) || (roiCols < 0) ||
+                (startRow + roiRows > R) || (startCol + roiCols > C)) {
+            ESP_LOGE("FixedMat", "getROI Error: ROI %dx%d at (%d, %d) out of matrix %dx%d", roiRows, roiCols, startRow, startCol, R, C);
+            return Mat(data, 0, 0, C);
+        }
+        return Mat(data + startRow * C + startCol, roiRows, roiCols, C);
+    }
+
+    /**
+     * Transposed matrix.
+     *
+     * @return
+     *      - C x R matrix
+     */
+    FixedMat<C, R> t() const
+    {
+        FixedMat<C, R> result;
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                result.data[j * R + i] = data[i * C + j];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Identity matrix (square matrices only).
+     *
+     * @return
+     *      - R x R identity matrix
+     */
+    static FixedMat eye()
+    {
+        static_assert(R == C, "FixedMat::eye() needs a square matrix");
+        FixedMat result;
+        for (int i = 0; i < R; i++) {
+            result.data[i * C + i] = 1;
+        }
+        return result;
+    }
+
+    /**
+     * Element-wise addition.
+     * @param[in] A: matrix to add
+     *
+     * @return
+     *      - this matrix
+     */
+    FixedMat &operator+=(const FixedMat &A)
+    {
+        FixedElementwise<R * C, 1, FixedOpAdd>::run(data, A.data, data);
+        return *this;
+    }
+    /**
+     * Element-wise subtraction.
+     * @param[in] A: matrix to subtract
+     *
+     * @return
+     *      - this matrix
+     */
+    FixedMat &operator-=(const FixedMat &A)
+    {
+        FixedElementwise<R * C, 1, FixedOpSub>::run(data, A.data, data);
+        return *this;
+    }
+    /**
+     * Add a constant to all the elements.
+     * @param[in] c: constant
+     *
+     * @return
+     *      - this matrix
+     */
+    FixedMat &operator+=(float c)
+    {
+        FixedElementwise<R * C, 0, FixedOpAdd>::run(data, &c, data);
+        return *this;
+    }
+    /**
+     * Multiply all the elements by a constant.
+     * @param[in] c: constant
+     *
+     * @return
+     *      - this matrix
+     */
+    FixedMat &operator*=(float c)
+    {
+        FixedElementwise<R * C, 0, FixedOpMul>::run(data, &c, data);
+        return *this;
+    }
+};
+
+/**
+ * Matrix product C = A * B.
+ * @param[in] A: R x K matrix
+ * @param[in] B: K x C matrix
+ * @param[out] result: R x C matrix, must not be A or B
+ */
+template <int R, int K, int C>
+DSPM_FIXED_INLINE void mult(const FixedMat<R, K> &A, const FixedMat<K, C> &B, FixedMat<R, C> &result)
+{
+    FixedProduct<R, K, C, K, 1, C, 1>::run(A.data, B.data, result.data);
+}
+
+/**
+ * Product with the transpose of the second matrix: result = A * B'.
+ * B' is not built, B is read by rows.
+ * @param[in] A: R x K matrix
+ * @param[in] B: C x K matrix
+ * @param[out] result: R x C matrix, must not be A or B
+ */
+template <int R, int K, int C>
+DSPM_FIXED_INLINE void multTransposed(const FixedMat<R, K> &A, const FixedMat<C, K> &B, FixedMat<R, C> &result)
+{
+    FixedProduct<R, K, C, K, 1, 1, K>::run(A.data, B.data, result.data);
+}
+
+/**
+ * Product with the transpose of the first matrix: result = A' * B.
+ * A' is not built, A is read by columns.
+ * @param[in] A: K x R matrix
+ * @param[in] B: K x C matrix
+ * @param[out] result: R x C matrix, must not be A or B
+ */
+template <int R, int K, int C>
+DSPM_FIXED_INLINE void transposedMult(const FixedMat<K, R> &A, const FixedMat<K, C> &B, FixedMat<R, C> &result)
+{
+    FixedProduct<R, K, C, 1, R, C, 1>::run(A.data, B.data, result.data);
+}
+
+/**
+ * Matrix product.
+ * @param[in] A: R x K matrix
+ * @param[in] B: K x C matrix
+ *
+ * @return
+ *      - R x C matrix A * B
+ */
+template <int R, int K, int C>
+FixedMat<R, C> operator*(const FixedMat<R, K> &A, const FixedMat<K, C> &B)
+{
+    FixedMat<R, C> result;
+    mult(A, B, result);
+    return result;
+}
+
+/**
+ * Element-wise addition.
+ * @param[in] A: first matrix
+ * @param[in] B: second matrix
+ *
+ * @return
+ *      - A + B
+ */
+template <int R, int C>
+FixedMat<R, C> operator+(const FixedMat<R, C> &A, const FixedMat<R, C> &B)
+{
+    FixedMat<R, C> result;
+    FixedElementwise<R * C, 1, FixedOpAdd>::run(A.data, B.data, result.data);
+    return result;
+}
+
+/**
+ * Element-wise subtraction.
+ * @param[in] A: first matrix
+ * @param[in] B: second matrix
+ *
+ * @return
+ *      - A - B
+ */
+template <int R, int C>
+FixedMat<R, C> operator-(const FixedMat<R, C> &A, const FixedMat<R, C> &B)
+{
+    FixedMat<R, C> result;
+    FixedElementwise<R * C, 1, FixedOpSub>::run(A.data, B.data, result.data);
+    return result;
+}
+
+/**
+ * Multiplication by a constant.
+ * @param[in] A: matrix
+ * @param[in] c: constant
+ *
+ * @return
+ *      - A * c
+ */
+template <int R, int C>
+FixedMat<R, C> operator*(const FixedMat<R, C> &A, float c)
+{
+    FixedMat<R, C> result;
+    FixedElementwise<R * C, 0, FixedOpMul>::run(A.data, &c, result.data);
+    return result;
+}
+
+/**
+ * Multiplication by a constant.
+ * @param[in] c: constant
+ * @param[in] A: matrix
+ *
+ * @return
+ *      - c * A
+ */
+template <int R, int C>
+FixedMat<R, C> operator*(float c, const FixedMat<R, C> &A)
+{
+    return A * c;
+}
+
+} /* namespace dspm */
+#endif //_dspm_fixed_mat_h_
@@ -15,6 +15,8 @@
 #ifndef _dspm_mat_h_
 #define _dspm_mat_h_
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
 /**
  * @brief   DSP matrix namespace
@@ -22,6 +24,46 @@
  * DSP library matrix namespace.
  */
 namespace dspm {
+template <typename E> class MatExpr;
+template <typename E> class MatTranspose;
+class MatRef;
+
+/**
+ * @brief   Strided access to matrix data
+ *
+ * Element [row][col] is data[row * row_step + col * col_step] * scale.
+ * Used for the operands of the products in matrix expressions: a matrix,
+ * its transpose and a scaled matrix are read without copies.
+ */
+struct MatView {
+    const float *data;      /*!< First element*/
+    int row_step;           /*!< Distance between two rows*/
+    int col_step;           /*!< Distance between two columns*/
+    float scale;            /*!< Factor of all the elements*/
+
+    /**
+     * @brief Dot product of a row of this view and a column of another view
+     *
+     * @param[in] row: row of this view
+     * @param[in] b: other view
+     * @param[in] col: column of the other view
+     * @param[in] n: amount of elements
+     *
+     * @return
+     *      - sum of this[row][k] * b[k][col]
+     */
+    float dot(int row, const MatView &b, int col, int n) const
+    {
+        const float *pa = data + row * row_step;
+        const float *pb = b.data + col * b.col_step;
+        float sum = 0;
+        for (int k = 0; k < n; k++) {
+            sum += pa[k * col_step] * pb[k * b.row_step];
+        }
+        return sum * scale * b.scale;
+    }
+};
+
 /**
  * @brief   Matrix
  *
@@ -116,6 +158,26 @@ public:
      */
     Mat(const Mat &src);
 
+    /**
+     * @brief Move matrix.
+     *
+     * If src owns its buffer, the buffer is taken (no allocation, no copy) and
+     * src is left as an empty 0x0 matrix. Otherwise the same as the copy constructor.
+     *
+     * @param[in] src: source matrix
+     */
+    Mat(Mat &&src);
+
+    /**
+     * @brief Evaluate a matrix expression.
+     *
+     * Allocates the result and evaluates the expression directly into it.
+     *
+     * @param[in] expr: expression, result of matrix operators
+     */
+    template <typename E>
+    Mat(const MatExpr<E> &expr);
+
     /**
      * @brief Create a subset of matrix as ROI (Region of Interest)
      *
@@ -207,6 +269,36 @@ public:
      */
     Mat &operator=(const Mat &src);
 
+    /**
+     * Move operator
+     *
+     * If the size changes and src owns its buffer, the buffer is taken
+     * instead of allocating a new one. A matrix of the same size keeps its
+     * buffer (and the sub-matrices of it), as with the copy operator.
+     *
+     * @param[in] src: source matrix
+     *
+     * @return
+     *      - matrix copy
+     */
+    Mat &operator=(Mat &&src);
+
+    /**
+     * Assign a matrix expression
+     *
+     * The expression is evaluated directly into this matrix, without
+     * intermediate matrices. If the expression reads this matrix in a way
+     * that the result would overwrite values still needed (products,
+     * transposition, size change), it's evaluated into a temporary first.
+     *
+     * @param[in] expr: expression, result of matrix operators
+     *
+     * @return
+     *      - result matrix
+     */
+    template <typename E>
+    Mat &operator=(const MatExpr<E> &expr);
+
     /**
      * Access to the matrix elements.
      * @param[in] row: row position
@@ -253,6 +345,17 @@ public:
      *      - result matrix: result += C
      */
     Mat &operator+=(float C);
+
+    /**
+     * += operator with a matrix expression, evaluated in place
+     *
+     * @param[in] expr: expression, result of matrix operators
+     *
+     * @return
+     *      - result matrix: result += expr
+     */
+    template <typename E>
+    Mat &operator+=(const MatExpr<E> &expr);
     /**
      * -= operator
      * The operator use DSP optimized implementation of multiplication.
@@ -275,6 +378,17 @@ public:
      */
     Mat &operator-=(float C);
 
+    /**
+     * -= operator with a matrix expression, evaluated in place
+     *
+     * @param[in] expr: expression, result of matrix operators
+     *
+     * @return
+     *      - result matrix: result -= expr
+     */
+    template <typename E>
+    Mat &operator-=(const MatExpr<E> &expr);
+
     /**
      * *= operator
      * The operator use DSP optimized implementation of multiplication.
@@ -333,11 +447,18 @@ public:
     /**
      * Matrix transpose.
      * Change rows and columns between each other.
+     * The result is an expression: the transposed matrix is not stored,
+     * unless it's assigned to a Mat.
+     *
+     * @note The expression refers to this matrix, it doesn't copy it:
+     * "auto x = m.t();" dangles once m is destroyed or moved. It has no
+     * data and no Mat methods (e.g. getROI()): store it first,
+     * dspm::Mat x = m.t(); or dspm::Mat(m.t()).getROI(...).
      *
      * @return
-     *      - transposed matrix
+     *      - transposed matrix (expression)
      */
-    Mat t();
+    MatTranspose<MatRef> t() const;
 
     /**
      * Create identity matrix.
@@ -513,11 +634,82 @@ public:
      *      - determinant value
      */
     float det(int n);
+
+    /**
+     * @brief   Check if two matrices share memory
+     *
+     * @param[in] m: other matrix
+     *
+     * @return
+     *      - true if the memory areas of the matrices overlap
+     */
+    bool overlaps(const Mat &m) const;
+
+    /**
+     * @brief   Matrix product into a given matrix
+     * The method use DSP optimized implementation of multiplication.
+     *
+     * @param[in] A: Input matrix A [M]x[N]
+     * @param[in] B: Input matrix B [N]x[K]
+     * @param[out] C: result matrix A*B [M]x[K], must not overlap A or B
+     */
+    static void mult(const Mat &A, const Mat &B, Mat &C);
+
+    /**
+     * @brief   Matrix product of two views into a given matrix
+     *
+     * @param[in] A: Input view A [M]x[N]
+     * @param[in] B: Input view B [N]x[K]
+     * @param[in] n: N
+     * @param[out] C: result matrix A*B [M]x[K], must not overlap A or B
+     */
+    static void mult(const MatView &A, const MatView &B, int n, Mat &C);
+
+    /**
+     * @brief   Sum of two matrices into a given matrix
+     * The method use DSP optimized implementation.
+     *
+     * @param[in] A: Input matrix A
+     * @param[in] B: Input matrix B
+     * @param[out] C: result matrix A+B
+     */
+    static void add(const Mat &A, const Mat &B, Mat &C);
+
+    /**
+     * @brief   Subtraction of two matrices into a given matrix
+     * The method use DSP optimized implementation.
+     *
+     * @param[in] A: Input matrix A
+     * @param[in] B: Input matrix B
+     * @param[out] C: result matrix A-B
+     */
+    static void sub(const Mat &A, const Mat &B, Mat &C);
+
+    /**
+     * @brief   Multiplication of a matrix by a constant into a given matrix
+     * The method use DSP optimized implementation.
+     *
+     * @param[in] A: Input matrix A
+     * @param[in] C: constant
+     * @param[out] result: result matrix A*C
+     */
+    static void mulc(const Mat &A, float C, Mat &result);
+
+    /**
+     * @brief   Sum of a matrix and a constant into a given matrix
+     * The method use DSP optimized implementation.
+     *
+     * @param[in] A: Input matrix A
+     * @param[in] C: constant
+     * @param[out] result: result matrix A+C
+     */
+    static void addc(const Mat &A, float C, Mat &result);
 private:
     Mat cofactor(int row, int col, int n);
     Mat adjoint();
 
     void allocate(); // Allocate buffer
+    bool resize(int rows, int cols); // Allocate buffer for a new size (not for sub-matrices)
     Mat expHelper(const Mat &m, int num);
 };
 /**
@@ -550,110 +742,765 @@ std::ostream &operator<<(std::ostream &os, const Mat::Rect &rect);
  */
 std::istream &operator>>(std::istream &is, Mat &m);
 
+/**
+ * @brief   Matrix expression
+ *
+ * The matrix operators (+, -, *, / and t()) don't calculate the result:
+ * they return an expression that keeps the operands. The expression is
+ * evaluated when it's assigned to a Mat (or used to create one), in one pass
+ * directly into the destination buffer. A chain like A*B + C needs no
+ * intermediate matrix, and in F*P*F.t() only F*P is stored (the operand of
+ * a product that is not a matrix, its transpose or a scaled matrix is
+ * evaluated once into a temporary matrix).
+ *
+ * Expressions refer to their matrix operands, so they must be used in the
+ * statement that creates them: don't keep them in "auto" variables.
+ * Element access and t() are available, other Mat methods need a Mat:
+ * dspm::Mat(A * B).inverse().
+ */
+template <typename E>
+class MatExpr {
+public:
+    int rows;               /*!< Amount of rows of the result*/
+    int cols;               /*!< Amount of columns of the result*/
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] rows: amount of rows of the result
+     * @param[in] cols: amount of columns of the result
+     */
+    MatExpr(int rows, int cols) : rows(rows), cols(cols) {}
+
+    /**
+     * @brief Derived expression
+     */
+    const E &self() const
+    {
+        return static_cast<const E &>(*this);
+    }
+
+    /**
+     * Calculate one element of the result.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of the result [row][col]
+     */
+    float operator()(int row, int col) const
+    {
+        return self().at(row, col);
+    }
+
+    /**
+     * Transpose of the expression.
+     *
+     * @return
+     *      - transposed expression
+     */
+    MatTranspose<E> t() const &
+    {
+        return MatTranspose<E>(self());
+    }
+    /**
+     * Transpose of the expression.
+     *
+     * @return
+     *      - transposed expression
+     */
+    MatTranspose<E> t() &&
+    {
+        return MatTranspose<E>(std::move(static_cast<E &>(*this)));
+    }
+
+    /**
+     * @brief Evaluate the result into dst, element by element
+     *
+     * @param[out] dst: matrix with the size of the result, not read by the expression
+     */
+    void evalTo(Mat &dst) const
+    {
+        for (int row = 0; row < this->rows; row++) {
+            for (int col = 0; col < this->cols; col++) {
+                dst(row, col) = self().at(row, col);
+            }
+        }
+    }
+};
+
+/**
+ * Log the error of operands with wrong dimensions.
+ * @param[in] op: operator name
+ */
+void matSizeError(const char *op);
+
+/**
+ * @brief   Matrix operand of an expression, by reference
+ */
+class MatRef : public MatExpr<MatRef> {
+public:
+    /**
+     * @brief Constructor
+     * @param[in] src: matrix
+     */
+    explicit MatRef(const Mat &src) : MatExpr<MatRef>(src.rows, src.cols), m(src) {}
+
+    float at(int row, int col) const
+    {
+        return m(row, col);
+    }
+    /**
+     * @brief Matrix of the operand
+     * @return
+     *      - the matrix, NULL for expressions that are not a matrix
+     */
+    const Mat *plain() const
+    {
+        return &m;
+    }
+    /**
+     * @brief Strided access to the elements (matrices, transposed or scaled matrices)
+     */
+    MatView view() const
+    {
+        MatView v = {m.data, m.stride, 1, 1};
+        return v;
+    }
+    /**
+     * @brief Check if the expression reads dst
+     *
+     * @param[in] dst: destination matrix
+     * @param[in] same_pos: reading the element that is being written is allowed
+     *
+     * @return
+     *      - true if the result can't be written directly into dst
+     */
+    bool aliases(const Mat &dst, bool same_pos) const
+    {
+        if (same_pos && (m.data == dst.data) && (m.stride == dst.stride)) {
+            return false;
+        }
+        return m.overlaps(dst);
+    }
+    void evalTo(Mat &dst) const
+    {
+        dst = m;
+    }
+
+private:
+    const Mat &m;
+};
+
+/**
+ * @brief   Matrix operand of an expression, temporary matrix owned by the expression
+ */
+class MatOwn : public MatExpr<MatOwn> {
+public:
+    /**
+     * @brief Constructor
+     * @param[in] src: matrix, its buffer is moved to the expression
+     */
+    explicit MatOwn(Mat &&src) : MatExpr<MatOwn>(src.rows, src.cols), m(std::move(src)) {}
+
+    float at(int row, int col) const
+    {
+        return m(row, col);
+    }
+    const Mat *plain() const
+    {
+        return &m;
+    }
+    MatView view() const
+    {
+        MatView v = {m.data, m.stride, 1, 1};
+        return v;
+    }
+    bool aliases(const Mat &dst, bool same_pos) const
+    {
+        if (same_pos && (m.data == dst.data) && (m.stride == dst.stride)) {
+            return false;
+        }
+        return m.overlaps(dst);
+    }
+    void evalTo(Mat &dst) const
+    {
+        dst = m;
+    }
+
+private:
+    Mat m;
+};
+
+/**
+ * @brief   Transposed expression
+ */
+template <typename E>
+class MatTranspose : public MatExpr<MatTranspose<E> > {
+public:
+    /**
+     * @brief Constructor
+     * @param[in] e: expression to transpose
+     */
+    explicit MatTranspose(E e) : MatExpr<MatTranspose<E> >(e.cols, e.rows), e(std::move(e)) {}
+
+    float at(int row, int col) const
+    {
+        return e.at(col, row);
+    }
+    const Mat *plain() const
+    {
+        return NULL;
+    }
+    MatView view() const
+    {
+        MatView v = e.view();
+        int step = v.row_step;
+        v.row_step = v.col_step;
+        v.col_step = step;
+        return v;
+    }
+    bool aliases(const Mat &dst, bool) const
+    {
+        return e.aliases(dst, false);
+    }
+
+private:
+    E e;
+};
+
+/**
+ * @brief   Element by element operations of two expressions
+ */
+struct MatOpAdd {
+    static float apply(float a, float b)
+    {
+        return a + b;
+    }
+    static void eval(const Mat &A, const Mat &B, Mat &C)
+    {
+        Mat::add(A, B, C);
+    }
+};
+struct MatOpSub {
+    static float apply(float a, float b)
+    {
+        return a - b;
+    }
+    static void eval(const Mat &A, const Mat &B, Mat &C)
+    {
+        Mat::sub(A, B, C);
+    }
+};
+struct MatOpDiv {
+    static float apply(float a, float b)
+    {
+        return a / b;
+    }
+    static void eval(const Mat &A, const Mat &B, Mat &C)
+    {
+        for (int row = 0; row < C.rows; row++) {
+            for (int col = 0; col < C.cols; col++) {
+                C(row, col) = A(row, col) / B(row, col);
+            }
+        }
+    }
+};
+
+/**
+ * @brief   Element by element operation of two expressions
+ */
+template <typename A, typename B, typename Op>
+class MatBinary : public MatExpr<MatBinary<A, B, Op> > {
+public:
+    /**
+     * @brief Constructor
+     * @param[in] a: first operand
+     * @param[in] b: second operand
+     * @param[in] op: operator name, for the error message
+     */
+    MatBinary(A a, B b, const char *op) : MatExpr<MatBinary<A, B, Op> >(a.rows, a.cols), a(std::move(a)), b(std::move(b))
+    {
+        if ((this->a.rows != this->b.rows) || (this->a.cols != this->b.cols)) {
+            matSizeError(op);
+            this->rows = 0;
+            this->cols = 0;
+        }
+    }
+
+    float at(int row, int col) const
+    {
+        return Op::apply(a.at(row, col), b.at(row, col));
+    }
+    const Mat *plain() const
+    {
+        return NULL;
+    }
+    bool aliases(const Mat &dst, bool same_pos) const
+    {
+        return a.aliases(dst, same_pos) || b.aliases(dst, same_pos);
+    }
+    void evalTo(Mat &dst) const
+    {
+        const Mat *ma = a.plain();
+        const Mat *mb = b.plain();
+        if (ma && mb) {
+            Op::eval(*ma, *mb, dst);
+        } else if (!b.aliases(dst, false)) {
+            // a with its own evaluation (a product...) and then b
+            a.evalTo(dst);
+            if (mb) {
+                Op::eval(dst, *mb, dst);
+            } else {
+                for (int row = 0; row < this->rows; row++) {
+                    for (int col = 0; col < this->cols; col++) {
+                        dst(row, col) = Op::apply(dst(row, col), b.at(row, col));
+                    }
+                }
+            }
+        } else {
+            MatExpr<MatBinary<A, B, Op> >::evalTo(dst);
+        }
+    }
+
+private:
+    A a;
+    B b;
+};
+
+/**
+ * @brief   Operations of an expression with a constant
+ */
+struct MatOpMulc {
+    static float apply(float a, float c)
+    {
+        return a * c;
+    }
+    static void eval(const Mat &A, float C, Mat &result)
+    {
+        Mat::mulc(A, C, result);
+    }
+};
+struct MatOpAddc {
+    static float apply(float a, float c)
+    {
+        return a + c;
+    }
+    static void eval(const Mat &A, float C, Mat &result)
+    {
+        Mat::addc(A, C, result);
+    }
+};
+
+/**
+ * @brief   Element by element operation of an expression with a constant
+ */
+template <typename A, typename Op>
+class MatScalar : public MatExpr<MatScalar<A, Op> > {
+public:
+    /**
+     * @brief Constructor
+     * @param[in] a: operand
+     * @param[in] c: constant
+     */
+    MatScalar(A a, float c) : MatExpr<MatScalar<A, Op> >(a.rows, a.cols), a(std::move(a)), c(c) {}
+
+    float at(int row, int col) const
+    {
+        return Op::apply(a.at(row, col), c);
+    }
+    const Mat *plain() const
+    {
+        return NULL;
+    }
+    MatView view() const
+    {
+        MatView v = a.view();
+        v.scale *= c;
+        return v;
+    }
+    bool aliases(const Mat &dst, bool same_pos) const
+    {
+        return a.aliases(dst, same_pos);
+    }
+    void evalTo(Mat &dst) const
+    {
+        const Mat *ma = a.plain();
+        if (ma) {
+            Op::eval(*ma, c, dst);
+        } else {
+            // In place, after a
+            a.evalTo(dst);
+            Op::eval(dst, c, dst);
+        }
+    }
+
+private:
+    A a;
+    float c;
+};
+
+/**
+ * @brief   Matrix product of two expressions
+ *
+ * The operands are read through their views (see MatFactor).
+ */
+template <typename A, typename B>
+class MatProduct : public MatExpr<MatProduct<A, B> > {
+public:
+    /**
+     * @brief Constructor
+     * @param[in] a: first operand [M]x[N]
+     * @param[in] b: second operand [N]x[K]
+     */
+    MatProduct(A a, B b) : MatExpr<MatProduct<A, B> >(a.rows, b.cols), a(std::move(a)), b(std::move(b))
+    {
+        if (this->a.cols != this->b.rows) {
+            matSizeError("*");
+            this->rows = 0;
+            this->cols = 0;
+        }
+    }
+
+    float at(int row, int col) const
+    {
+        return a.view().dot(row, b.view(), col, a.cols);
+    }
+    const Mat *plain() const
+    {
+        return NULL;
+    }
+    bool aliases(const Mat &dst, bool) const
+    {
+        return a.aliases(dst, false) || b.aliases(dst, false);
+    }
+    void evalTo(Mat &dst) const
+    {
+        const Mat *ma = a.plain();
+        const Mat *mb = b.plain();
+        if (ma && mb) {
+            Mat::mult(*ma, *mb, dst);
+        } else {
+            Mat::mult(a.view(), b.view(), a.cols, dst);
+        }
+    }
+
+private:
+    A a;
+    B b;
+};
+
+/**
+ * @brief   Operand types of the matrix operators
+ *
+ * A Mat variable is used by reference, a temporary Mat is moved into the
+ * expression, and expressions are used as they are.
+ */
+template <typename T, bool = std::is_base_of<MatExpr<typename std::decay<T>::type>, typename std::decay<T>::type>::value>
+struct MatOperand {
+    static const bool value = true;
+    typedef typename std::decay<T>::type type;
+};
+template <typename T>
+struct MatOperand<T, false> {
+    static const bool value = false;
+};
+template <>
+struct MatOperand<Mat &, false> {
+    static const bool value = true;
+    typedef MatRef type;
+};
+template <>
+struct MatOperand<const Mat &, false> {
+    static const bool value = true;
+    typedef MatRef type;
+};
+template <>
+struct MatOperand<const Mat, false> {
+    static const bool value = true;
+    typedef MatRef type;
+};
+template <>
+struct MatOperand<Mat, false> {
+    static const bool value = true;
+    typedef MatOwn type;
+};
+
+/**
+ * @brief   Operand types of the matrix product
+ *
+ * Matrices, transposed matrices and scaled matrices are read directly,
+ * other expressions are evaluated into a temporary matrix first.
+ */
+template <typename E>
+struct MatDirect {
+    static const bool value = false;
+};
+template <>
+struct MatDirect<MatRef> {
+    static const bool value = true;
+};
+template <>
+struct MatDirect<MatOwn> {
+    static const bool value = true;
+};
+template <typename E>
+struct MatDirect<MatTranspose<E> > {
+    static const bool value = MatDirect<E>::value;
+};
+template <typename E>
+struct MatDirect<MatScalar<E, MatOpMulc> > {
+    static const bool value = MatDirect<E>::value;
+};
+
+template <typename E, bool = MatDirect<E>::value>
+struct MatFactor {
+    typedef E type;
+    static E make(E &&e)
+    {
+        return std::move(e);
+    }
+};
+template <typename E>
+struct MatFactor<E, false> {
+    typedef MatOwn type;
+    static MatOwn make(E &&e)
+    {
+        return MatOwn(Mat(e));
+    }
+};
+
 /**
  * + operator, sum of two matrices
- * The operator use DSP optimized implementation of multiplication.
+ * The operator use DSP optimized implementation, when the operands are matrices.
  *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
+ * @param[in] a: Input matrix or expression A
+ * @param[in] b: Input matrix or expression B
  *
  * @return
- *     - result matrix A+B
+ *     - expression A+B
 */
-Mat operator+(const Mat &A, const Mat &B);
+template <typename A, typename B>
+typename std::enable_if < MatOperand<A>::value &&MatOperand<B>::value,
+         MatBinary<typename MatOperand<A>::type, typename MatOperand<B>::type, MatOpAdd> >::type
+         operator+(A &&a, B &&b)
+{
+    typedef typename MatOperand<A>::type TA;
+    typedef typename MatOperand<B>::type TB;
+    return MatBinary<TA, TB, MatOpAdd>(TA(std::forward<A>(a)), TB(std::forward<B>(b)), "+");
+}
 /**
  * + operator, sum of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
+ * The operator use DSP optimized implementation, when the operand is a matrix.
  *
- * @param[in] A: Input matrix A
+ * @param[in] a: Input matrix or expression A
  * @param[in] C: Input constant
  *
  * @return
- *     - result matrix A+C
+ *     - expression A+C
 */
-Mat operator+(const Mat &A, float C);
+template <typename A>
+typename std::enable_if<MatOperand<A>::value, MatScalar<typename MatOperand<A>::type, MatOpAddc> >::type
+operator+(A &&a, float C)
+{
+    typedef typename MatOperand<A>::type TA;
+    return MatScalar<TA, MatOpAddc>(TA(std::forward<A>(a)), C);
+}
 
 /**
  * - operator, subtraction of two matrices
- * The operator use DSP optimized implementation of multiplication.
+ * The operator use DSP optimized implementation, when the operands are matrices.
  *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
+ * @param[in] a: Input matrix or expression A
+ * @param[in] b: Input matrix or expression B
  *
  * @return
- *     - result matrix A-B
+ *     - expression A-B
 */
-Mat operator-(const Mat &A, const Mat &B);
+template <typename A, typename B>
+typename std::enable_if < MatOperand<A>::value &&MatOperand<B>::value,
+         MatBinary<typename MatOperand<A>::type, typename MatOperand<B>::type, MatOpSub> >::type
+         operator-(A &&a, B &&b)
+{
+    typedef typename MatOperand<A>::type TA;
+    typedef typename MatOperand<B>::type TB;
+    return MatBinary<TA, TB, MatOpSub>(TA(std::forward<A>(a)), TB(std::forward<B>(b)), "-");
+}
 /**
- * - operator, sum of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
+ * - operator, subtraction of constant from matrix
+ * The operator use DSP optimized implementation, when the operand is a matrix.
  *
- * @param[in] A: Input matrix A
+ * @param[in] a: Input matrix or expression A
  * @param[in] C: Input constant
  *
  * @return
- *     - result matrix A+C
+ *     - expression A-C
 */
-Mat operator-(const Mat &A, float C);
+template <typename A>
+typename std::enable_if<MatOperand<A>::value, MatScalar<typename MatOperand<A>::type, MatOpAddc> >::type
+operator-(A &&a, float C)
+{
+    typedef typename MatOperand<A>::type TA;
+    return MatScalar<TA, MatOpAddc>(TA(std::forward<A>(a)), -C);
+}
 
 /**
  * * operator, multiplication of two matrices.
- * The operator use DSP optimized implementation of multiplication.
+ * The operator use DSP optimized implementation of multiplication, when the
+ * operands are matrices.
  *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
+ * @param[in] a: Input matrix or expression A
+ * @param[in] b: Input matrix or expression B
  *
  * @return
- *     - result matrix A*B
+ *     - expression A*B
 */
-Mat operator*(const Mat &A, const Mat &B);
-
+template <typename A, typename B>
+typename std::enable_if < MatOperand<A>::value &&MatOperand<B>::value,
+         MatProduct<typename MatFactor<typename MatOperand<A>::type>::type,
+         typename MatFactor<typename MatOperand<B>::type>::type> >::type
+         operator*(A &&a, B &&b)
+{
+    typedef typename MatOperand<A>::type TA;
+    typedef typename MatOperand<B>::type TB;
+    return MatProduct<typename MatFactor<TA>::type, typename MatFactor<TB>::type>(
+               MatFactor<TA>::make(TA(std::forward<A>(a))), MatFactor<TB>::make(TB(std::forward<B>(b))));
+}
 /**
  * * operator, multiplication of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
+ * The operator use DSP optimized implementation, when the operand is a matrix.
  *
- * @param[in] A: Input matrix A
+ * @param[in] a: Input matrix or expression A
  * @param[in] C: floating point value
  *
  * @return
- *     - result matrix A*B
+ *     - expression A*C
 */
-Mat operator*(const Mat &A, float C);
-
+template <typename A>
+typename std::enable_if<MatOperand<A>::value, MatScalar<typename MatOperand<A>::type, MatOpMulc> >::type
+operator*(A &&a, float C)
+{
+    typedef typename MatOperand<A>::type TA;
+    return MatScalar<TA, MatOpMulc>(TA(std::forward<A>(a)), C);
+}
 /**
  * * operator, multiplication of matrix with constant
- * The operator use DSP optimized implementation of multiplication.
+ * The operator use DSP optimized implementation, when the operand is a matrix.
  *
  * @param[in] C: floating point value
- * @param[in] A: Input matrix A
+ * @param[in] a: Input matrix or expression A
  *
  * @return
- *     - result matrix A*B
+ *     - expression C*A
 */
-Mat operator*(float C, const Mat &A);
+template <typename A>
+typename std::enable_if<MatOperand<A>::value, MatScalar<typename MatOperand<A>::type, MatOpMulc> >::type
+operator*(float C, A &&a)
+{
+    typedef typename MatOperand<A>::type TA;
+    return MatScalar<TA, MatOpMulc>(TA(std::forward<A>(a)), C);
+}
 
 /**
  * / operator, divide of matrix by constant
- * The operator use DSP optimized implementation of multiplication.
+ * The operator use DSP optimized implementation, when the operand is a matrix.
  *
- * @param[in] A: Input matrix A
+ * @param[in] a: Input matrix or expression A
  * @param[in] C: floating point value
  *
  * @return
- *     - result matrix A*B
+ *     - expression A/C
 */
-Mat operator/(const Mat &A, float C);
+template <typename A>
+typename std::enable_if<MatOperand<A>::value, MatScalar<typename MatOperand<A>::type, MatOpMulc> >::type
+operator/(A &&a, float C)
+{
+    typedef typename MatOperand<A>::type TA;
+    return MatScalar<TA, MatOpMulc>(TA(std::forward<A>(a)), 1 / C);
+}
 
 /**
  * / operator, divide matrix A by matrix B
  *
- * @param[in] A: Input matrix A
- * @param[in] B: Input matrix B
+ * @param[in] a: Input matrix or expression A
+ * @param[in] b: Input matrix or expression B
  *
  * @return
- *     - result matrix C, where C[i,j] = A[i,j]/B[i,j]
+ *     - expression C, where C[i,j] = A[i,j]/B[i,j]
 */
-Mat operator/(const Mat &A, const Mat &B);
+template <typename A, typename B>
+typename std::enable_if < MatOperand<A>::value &&MatOperand<B>::value,
+         MatBinary<typename MatOperand<A>::type, typename MatOperand<B>::type, MatOpDiv> >::type
+         operator/(A &&a, B &&b)
+{
+    typedef typename MatOperand<A>::type TA;
+    typedef typename MatOperand<B>::type TB;
+    return MatBinary<TA, TB, MatOpDiv>(TA(std::forward<A>(a)), TB(std::forward<B>(b)), "/");
+}
+
+template <typename E>
+Mat::Mat(const MatExpr<E> &expr)
+{
+    this->rows = expr.rows;
+    this->cols = expr.cols;
+    this->sub_matrix = false;
+    this->stride = this->cols;
+    this->padding = 0;
+    allocate();
+    expr.self().evalTo(*this);
+}
+
+template <typename E>
+Mat &Mat::operator=(const MatExpr<E> &expr)
+{
+    const E &e = expr.self();
+    bool same_size = (this->rows == e.rows) && (this->cols == e.cols);
+    if (e.aliases(*this, same_size)) {
+        // The expression reads this matrix: evaluate it apart
+        Mat temp(expr);
+        return (*this = std::move(temp));
+    }
+    if (!same_size && !this->resize(e.rows, e.cols)) {
+        return *this;
+    }
+    e.evalTo(*this);
+    return *this;
+}
+
+template <typename E>
+Mat &Mat::operator+=(const MatExpr<E> &expr)
+{
+    const E &e = expr.self();
+    if ((this->rows != e.rows) || (this->cols != e.cols) || e.aliases(*this, true)) {
+        return (*this += Mat(expr));
+    }
+    for (int row = 0; row < this->rows; row++) {
+        for (int col = 0; col < this->cols; col++) {
+            (*this)(row, col) += e.at(row, col);
+        }
+    }
+    return *this;
+}
+
+template <typename E>
+Mat &Mat::operator-=(const MatExpr<E> &expr)
+{
+    const E &e = expr.self();
+    if ((this->rows != e.rows) || (this->cols != e.cols) || e.aliases(*this, true)) {
+        return (*this -= Mat(expr));
+    }
+    for (int row = 0; row < this->rows; row++) {
+        for (int col = 0; col < this->cols; col++) {
+            (*this)(row, col) -= e.at(row, col);
+        }
+    }
+    return *this;
+}
+
+inline MatTranspose<MatRef> Mat::t() const
+{
+    return MatTranspose<MatRef>(MatRef(*this));
+}
 
 /**
  * == operator, compare two matrices
@@ -133,6 +133,32 @@ Mat::Mat(const Mat &m)
     }
 }
 
+Mat::Mat(Mat &&m)
+{
+    this->rows = m.rows;
+    this->cols = m.cols;
+    this->padding = m.padding;
+    this->stride = m.stride;
+    this->data = m.data;
+    this->sub_matrix = m.sub_matrix;
+    this->length = m.length;
+
+    if (m.sub_matrix) {
+        this->ext_buff = true;
+    } else if (m.ext_buff) {
+        allocate();
+        memcpy(this->data, m.data, this->length * sizeof(float));
+    } else {
+        // Take the buffer, m is left empty
+        this->ext_buff = false;
+        m.data = NULL;
+        m.rows = 0;
+        m.cols = 0;
+        m.stride = 0;
+        m.length = 0;
+    }
+}
+
 Mat Mat::getROI(int startRow, int startCol, int roiRows, int roiCols, int stride)
 {
     Mat result(this->data, roiRows, roiCols, 0);
@@ -257,6 +283,35 @@ Mat &Mat::operator=(const Mat &m)
     return *this;
 }
 
+Mat &Mat::operator=(Mat &&m)
+{
+    if (this == &m) {
+        return *this;
+    }
+
+    // Same size, sub-matrices or external buffers: copy the data
+    if ((this->rows == m.rows && this->cols == m.cols) || this->sub_matrix || m.sub_matrix || m.ext_buff) {
+        return (*this = static_cast<const Mat &>(m));
+    }
+    if (!this->ext_buff) {
+        delete[] this->data;
+    }
+    this->rows = m.rows;
+    this->cols = m.cols;
+    this->stride = m.stride;
+    this->padding = m.padding;
+    this->length = m.length;
+    this->data = m.data;
+    this->ext_buff = false;
+    this->sub_matrix = false;
+    m.data = NULL;
+    m.rows = 0;
+    m.cols = 0;
+    m.stride = 0;
+    m.length = 0;
+    return *this;
+}
+
 Mat &Mat::operator+=(const Mat &m)
 {
     if ((this->rows != m.rows) || (this->cols != m.cols)) {
@@ -378,17 +433,6 @@ void Mat::swapRows(int r1, int r2)
     }
 }
 
-Mat Mat::t()
-{
-    Mat ret(this->cols, this->rows);
-    for (int i = 0; i < this->rows; ++i) {
-        for (int j = 0; j < this->cols; ++j) {
-            ret(j, i) = this->data[i * this->stride + j];
-        }
-    }
-    return ret;
-}
-
 Mat Mat::eye(int size)
 {
     Mat temp(size, size);
@@ -818,168 +862,137 @@ Mat Mat::inverse()
     return result;
 }
 
-void Mat::allocate()
+bool Mat::overlaps(const Mat &m) const
 {
-    this->ext_buff = false;
-    this->length = this->rows * this->cols;
-    data = new float[this->length];
-    ESP_LOGD("Mat", "allocate(%i) = %p", this->length, this->data);
+    if ((this->rows == 0) || (this->cols == 0) || (m.rows == 0) || (m.cols == 0)) {
+        return false;
+    }
+    // Memory from the first to the last element of each matrix
+    const float *end = this->data + (this->rows - 1) * this->stride + this->cols;
+    const float *m_end = m.data + (m.rows - 1) * m.stride + m.cols;
+    return (this->data < m_end) && (m.data < end);
 }
 
-Mat Mat::expHelper(const Mat &m, int num)
+void Mat::mult(const Mat &A, const Mat &B, Mat &C)
 {
-    if (num == 0) {
-        return Mat::eye(m.rows);
-    } else if (num == 1) {
-        return m;
-    } else if (num % 2 == 0) {  // num is even
-        return expHelper(m * m, num / 2);
-    } else {                    // num is odd
-        return m * expHelper(m * m, (num - 1) / 2);
+    if (A.sub_matrix || B.sub_matrix || C.sub_matrix) {
+        dspm_mult_ex_f32(A.data, B.data, C.data, A.rows, A.cols, B.cols, A.padding, B.padding, C.padding);
+    } else {
+        dspm_mult_f32(A.data, B.data, C.data, A.rows, A.cols, B.cols);
     }
 }
 
-Mat operator+(const Mat &m1, const Mat &m2)
+void Mat::mult(const MatView &A, const MatView &B, int n, Mat &C)
 {
-    if ((m1.rows != m2.rows) || (m1.cols != m2.cols)) {
-        ESP_LOGW("Mat", "operator + Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
-    }
-
-    if (m1.sub_matrix || m2.sub_matrix) {
-        Mat temp(m1.rows, m2.cols);
-        dspm_add_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m1.padding, m2.padding, temp.padding, 1, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m1);
-        return (temp += m2);
+    float scale = A.scale * B.scale;
+    for (int row = 0; row < C.rows; row++) {
+        const float *a = A.data + row * A.row_step;
+        for (int col = 0; col < C.cols; col++) {
+            const float *b = B.data + col * B.col_step;
+            float sum = 0;
+            for (int k = 0; k < n; k++) {
+                sum += a[k * A.col_step] * b[k * B.row_step];
+            }
+            C(row, col) = sum * scale;
+        }
     }
 }
 
-Mat operator+(const Mat &m, float C)
+void Mat::add(const Mat &A, const Mat &B, Mat &C)
 {
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_addc_f32(m.data, temp.data, C, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
+    if (A.sub_matrix || B.sub_matrix || C.sub_matrix) {
+        dspm_add_f32(A.data, B.data, C.data, A.rows, A.cols, A.padding, B.padding, C.padding, 1, 1, 1);
     } else {
-        Mat temp(m);
-        return (temp += C);
+        dsps_add_f32(A.data, B.data, C.data, A.length, 1, 1, 1);
     }
 }
 
-bool operator==(const Mat &m1, const Mat &m2)
+void Mat::sub(const Mat &A, const Mat &B, Mat &C)
 {
-    if ((m1.cols != m2.cols) || (m1.rows != m2.rows)) {
-        return false;
-    }
-
-    for (int row = 0; row < m1.rows; row++) {
-        for (int col = 0; col < m1.cols; col++) {
-            if (m1(row, col) != m2(row, col)) {
-                ESP_LOGW("Mat", "operator == Error: %i %i, m1.data=%f, m2.data=%f \n", row, col, m1(row, col), m2(row, col));
-                return false;
-            }
-        }
+    if (A.sub_matrix || B.sub_matrix || C.sub_matrix) {
+        dspm_sub_f32(A.data, B.data, C.data, A.rows, A.cols, A.padding, B.padding, C.padding, 1, 1, 1);
+    } else {
+        dsps_sub_f32(A.data, B.data, C.data, A.length, 1, 1, 1);
     }
-
-    return true;
 }
 
-Mat operator-(const Mat &m1, const Mat &m2)
+void Mat::mulc(const Mat &A, float C, Mat &result)
 {
-    if ((m1.rows != m2.rows) || (m1.cols != m2.cols)) {
-        ESP_LOGW("Mat", "operator - Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
-    }
-
-    if (m1.sub_matrix || m2.sub_matrix) {
-        Mat temp(m1.rows, m1.cols);
-        dspm_sub_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m1.padding, m2.padding, temp.padding, 1, 1, 1);
-        return temp;
+    if (A.sub_matrix || result.sub_matrix) {
+        dspm_mulc_f32(A.data, result.data, C, A.rows, A.cols, A.padding, result.padding, 1, 1);
     } else {
-        Mat temp(m1);
-        return (temp -= m2);
+        dsps_mulc_f32_ansi(A.data, result.data, A.length, C, 1, 1);
     }
 }
 
-Mat operator-(const Mat &m, float C)
+void Mat::addc(const Mat &A, float C, Mat &result)
 {
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_addc_f32(m.data, temp.data, -C, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
+    if (A.sub_matrix || result.sub_matrix) {
+        dspm_addc_f32(A.data, result.data, C, A.rows, A.cols, A.padding, result.padding, 1, 1);
     } else {
-        Mat temp(m);
-        return (temp -= C);
+        dsps_addc_f32_ansi(A.data, result.data, A.length, C, 1, 1);
     }
 }
 
-Mat operator*(const Mat &m1, const Mat &m2)
+bool Mat::resize(int rows, int cols)
 {
-    if (m1.cols != m2.rows) {
-        ESP_LOGW("Mat", "operator * Error: matrices do not have correct dimensions");
-        Mat err_ret;
-        return err_ret;
+    if (this->sub_matrix) {
+        ESP_LOGE("Mat", "operator = Error for sub-matrices: operands matrices dimensions %dx%d and %dx%d do not match", this->rows, this->cols, rows, cols);
+        return false;
     }
-    Mat temp(m1.rows, m2.cols);
-
-    if (m1.sub_matrix || m2.sub_matrix) {
-        dspm_mult_ex_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols, m1.padding, m2.padding, temp.padding);
-    } else {
-        dspm_mult_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols);
+    if (!this->ext_buff) {
+        delete[] this->data;
     }
-
-    return temp;
-
+    this->rows = rows;
+    this->cols = cols;
+    this->stride = cols;
+    this->padding = 0;
+    allocate();
+    return true;
 }
 
-Mat operator*(const Mat &m, float num)
+void matSizeError(const char *op)
 {
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_mulc_f32(m.data, temp.data, num, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp *= num);
-    }
+    ESP_LOGW("Mat", "operator %s Error: matrices do not have correct dimensions", op);
 }
 
-Mat operator*(float num, const Mat &m)
+void Mat::allocate()
 {
-    return (m * num);
+    this->ext_buff = false;
+    this->length = this->rows * this->cols;
+    data = new float[this->length];
+    ESP_LOGD("Mat", "allocate(%i) = %p", this->length, this->data);
 }
 
-Mat operator/(const Mat &m, float num)
+Mat Mat::expHelper(const Mat &m, int num)
 {
-    if (m.sub_matrix) {
-        Mat temp(m.rows, m.cols);
-        dspm_mulc_f32(m.data, temp.data, 1 / num, m.rows, m.cols, m.padding, temp.padding, 1, 1);
-        return temp;
-    } else {
-        Mat temp(m);
-        return (temp /= num);
+    if (num == 0) {
+        return Mat::eye(m.rows);
+    } else if (num == 1) {
+        return m;
+    } else if (num % 2 == 0) {  // num is even
+        return expHelper(m * m, num / 2);
+    } else {                    // num is odd
+        return m * expHelper(m * m, (num - 1) / 2);
     }
 }
 
-Mat operator/(const Mat &A, const Mat &B)
+bool operator==(const Mat &m1, const Mat &m2)
 {
-    if ((A.rows != B.rows) || (A.cols != B.cols)) {
-        ESP_LOGW("Mat", "Operator + Error: matrices do not have equal dimensions");
-        Mat err_ret;
-        return err_ret;
+    if ((m1.cols != m2.cols) || (m1.rows != m2.rows)) {
+        return false;
     }
 
-    Mat temp(A.rows, A.cols);
-    for (int row = 0; row < A.rows; row++) {
-        for (int col = 0; col < A.cols; col++) {
-            temp(row, col) = A(row, col) / B(row, col);
+    for (int row = 0; row < m1.rows; row++) {
+        for (int col = 0; col < m1.cols; col++) {
+            if (m1(row, col) != m2(row, col)) {
+                ESP_LOGW("Mat", "operator == Error: %i %i, m1.data=%f, m2.data=%f \n", row, col, m1(row, col), m2(row, col));
+                return false;
+            }
         }
     }
-    return temp;
+
+    return true;
 }
 
 ostream &operator<<(ostream &os, const Mat &m)
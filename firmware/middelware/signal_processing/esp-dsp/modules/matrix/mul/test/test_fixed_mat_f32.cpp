@@ -0,0 +1,217 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_dsp.h"
+#include "dsp_platform.h"
+#include "esp_log.h"
+
+#include "dspm_mult.h"
+#include "esp_attr.h"
+#include "dsp_tests.h"
+#include "fixed_mat.h"
+
+static const char *TAG = "dspm_FixedMat";
+
+template <int R, int C>
+static void fill(dspm::FixedMat<R, C> &m, float offset)
+{
+    for (int i = 0 ; i < R * C ; i++) {
+        m.data[i] = offset + 0.1f * (i % 7) - 0.05f * (i % 5);
+    }
+}
+
+TEST_CASE("FixedMat class operations", "[dspm]")
+{
+    dspm::FixedMat<3, 4> A;
+    dspm::FixedMat<4, 2> B;
+    dspm::FixedMat<2, 4> Bt;
+    dspm::FixedMat<4, 3> At;
+    float expected[3 * 2];
+    fill(A, 1);
+    fill(B, -2);
+    for (int i = 0 ; i < 4 ; i++) {
+        for (int j = 0 ; j < 2 ; j++) {
+            Bt(j, i) = B(i, j);
+        }
+        for (int j = 0 ; j < 3 ; j++) {
+            At(i, j) = A(j, i);
+        }
+    }
+    dspm_mult_f32_ansi(A.data, B.data, expected, 3, 4, 2);
+
+    // Products: the same result as dspm_mult_f32
+    dspm::FixedMat<3, 2> AB = A * B;
+    dspm::FixedMat<3, 2> ABt;
+    dspm::FixedMat<3, 2> AtB;
+    dspm::multTransposed(A, Bt, ABt);
+    dspm::transposedMult(At, B, AtB);
+    for (int i = 0 ; i < 3 * 2 ; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(expected[i], AB.data[i]);
+        TEST_ASSERT_EQUAL_FLOAT(expected[i], ABt.data[i]);
+        TEST_ASSERT_EQUAL_FLOAT(expected[i], AtB.data[i]);
+    }
+
+    // Bigger than DSPM_FIXED_UNROLL_MAX: loops over the elements
+    dspm::FixedMat<13, 13> F;
+    dspm::FixedMat<13, 13> P;
+    dspm::FixedMat<13, 13> FP;
+    dspm::FixedMat<13, 13> FPFt;
+    float FP_ref[13 * 13];
+    float FPFt_ref[13 * 13];
+    fill(F, 0.5f);
+    fill(P, 1);
+    dspm::FixedMat<13, 13> Ft = F.t();
+    dspm::mult(F, P, FP);
+    dspm::multTransposed(FP, F, FPFt);
+    dspm_mult_f32_ansi(F.data, P.data, FP_ref, 13, 13, 13);
+    dspm_mult_f32_ansi(FP_ref, Ft.data, FPFt_ref, 13, 13, 13);
+    for (int i = 0 ; i < 13 * 13 ; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(FP_ref[i], FP.data[i]);
+        TEST_ASSERT_EQUAL_FLOAT(FPFt_ref[i], FPFt.data[i]);
+    }
+
+    // Element-wise operations
+    dspm::FixedMat<3, 4> sum = A + A * 2;
+    dspm::FixedMat<3, 4> diff = sum - A;
+    diff += 1;
+    diff -= A;
+    diff *= 0.5f;
+    for (int i = 0 ; i < 3 * 4 ; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(A.data[i] * 3, sum.data[i]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, (A.data[i] + 1) * 0.5f, diff.data[i]);
+    }
+    dspm::FixedMat<4, 4> I = dspm::FixedMat<4, 4>::eye();
+    dspm::FixedMat<4, 4> Q;
+    fill(Q, 3);
+    dspm::FixedMat<4, 4> IQ = I * Q;
+    TEST_ASSERT_EQUAL(0, memcmp(IQ.data, Q.data, sizeof(Q.data)));
+}
+
+TEST_CASE("FixedMat class with Mat", "[dspm]")
+{
+    dspm::FixedMat<4, 4> A;
+    fill(A, 1);
+
+    // The view uses the same buffer
+    dspm::Mat view = A.view();
+    TEST_ASSERT_TRUE(view.data == A.data);
+    view(1, 2) = 10;
+    TEST_ASSERT_EQUAL_FLOAT(10, A(1, 2));
+    dspm::Mat copy;
+    copy = A.view();
+    TEST_ASSERT_TRUE(copy.data != A.data);
+    TEST_ASSERT_EQUAL_FLOAT(10, copy(1, 2));
+
+    // Sub-matrices of a FixedMat
+    dspm::Mat roi = A.getROI(1, 1, 3, 2);
+    TEST_ASSERT_EQUAL(3, roi.rows);
+    TEST_ASSERT_EQUAL(2, roi.cols);
+    TEST_ASSERT_EQUAL_FLOAT(A(1, 1), roi(0, 0));
+    TEST_ASSERT_EQUAL_FLOAT(A(3, 2), roi(2, 1));
+    roi(2, 0) = -1;
+    TEST_ASSERT_EQUAL_FLOAT(-1, A(3, 1));
+    dspm::Mat outside = A.getROI(3, 3, 2, 2);
+    TEST_ASSERT_EQUAL(0, outside.rows);
+    TEST_ASSERT_EQUAL(0, outside.cols);
+
+    // From and to Mat ROIs
+    dspm::Mat M(6, 6);
+    dspm::Mat block = M.getROI(2, 1, 4, 4);
+    TEST_ASSERT_TRUE(A.copyTo(block));
+    TEST_ASSERT_EQUAL_FLOAT(A(0, 0), M(2, 1));
+    TEST_ASSERT_EQUAL_FLOAT(A(3, 3), M(5, 4));
+    TEST_ASSERT_EQUAL_FLOAT(0, M(5, 5));
+    dspm::FixedMat<4, 4> B(block);
+    TEST_ASSERT_EQUAL(0, memcmp(A.data, B.data, sizeof(A.data)));
+    dspm::FixedMat<3, 3> wrong(block);
+    TEST_ASSERT_EQUAL_FLOAT(0, wrong(0, 0));
+    TEST_ASSERT_FALSE(wrong.copyTo(block));
+
+    // Mat operations on FixedMat data
+    dspm::Mat product = A.view() * B.view();
+    dspm::FixedMat<4, 4> AB = A * B;
+    for (int i = 0 ; i < 4 ; i++) {
+        for (int j = 0 ; j < 4 ; j++) {
+            TEST_ASSERT_EQUAL_FLOAT(product(i, j), AB(i, j));
+        }
+    }
+}
+
+TEST_CASE("FixedMat class benchmark", "[dspm]")
+{
+    const int repeat = 100;
+    dspm::FixedMat<3, 3> R3;
+    dspm::FixedMat<3, 3> S3;
+    dspm::FixedMat<3, 3> result3;
+    fill(R3, 1);
+    fill(S3, -1);
+    dspm::Mat R3m = R3.view();
+    dspm::Mat S3m = S3.view();
+    dspm::Mat result3m(3, 3);
+
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat ; i++) {
+        dspm::mult(R3, S3, result3);
+        S3(0, 0) = result3(0, 0) * 0.5f;
+    }
+    unsigned int end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "FixedMat 3x3 * 3x3: %i cycles", (end_b - start_b) / repeat);
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat ; i++) {
+        dspm::Mat::mult(R3m, S3m, result3m);
+        S3m(0, 0) = result3m(0, 0) * 0.5f;
+    }
+    end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "Mat 3x3 * 3x3 (preallocated): %i cycles", (end_b - start_b) / repeat);
+
+    const int N = 13;
+    dspm::FixedMat<N, N> F;
+    dspm::FixedMat<N, N> P;
+    dspm::FixedMat<N, N> Q;
+    dspm::FixedMat<N, N> FP;
+    fill(F, 0.1f);
+    F *= 0.02f;
+    F += dspm::FixedMat<N, N>::eye();
+    fill(P, 1);
+    dspm::Mat Fm = F.view();
+    dspm::Mat Pm;
+    Pm = P.view();
+    dspm::Mat Qm = Q.view();
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat / 10 ; i++) {
+        dspm::mult(F, P, FP);
+        dspm::multTransposed(FP, F, P);
+        P += Q;
+    }
+    end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "FixedMat P = F*P*F' + Q (13x13): %i cycles", (end_b - start_b) / (repeat / 10));
+
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat / 10 ; i++) {
+        Pm = Fm * Pm * Fm.t() + Qm;
+    }
+    end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "Mat P = F*P*F' + Q (13x13): %i cycles", (end_b - start_b) / (repeat / 10));
+
+    for (int m = 0 ; m < N ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4 * fabsf(Pm(m, n)), Pm(m, n), P(m, n));
+        }
+    }
+}
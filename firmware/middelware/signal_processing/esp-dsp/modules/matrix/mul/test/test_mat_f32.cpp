@@ -257,3 +257,139 @@ TEST_CASE("Mat class operators", "[dspm]")
 
     delete[] check_array;
 }
+
+TEST_CASE("Mat class expressions", "[dspm]")
+{
+    int N = 5;
+    dspm::Mat A(N, N);
+    dspm::Mat B(N, N);
+    dspm::Mat C(N, N);
+    dspm::Mat ref(N, N);
+    for (int m = 0 ; m < N ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            A(m, n) = m - n * 0.5f;
+            B(m, n) = (m * N + n) % 7;
+            C(m, n) = m * n;
+        }
+    }
+
+    // A*B + C, into the destination buffer
+    dspm::Mat result(N, N);
+    float *result_data = result.data;
+    result = A * B + C;
+    for (int m = 0 ; m < N ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            float sum = C(m, n);
+            for (int k = 0 ; k < N ; k++) {
+                sum += A(m, k) * B(k, n);
+            }
+            ref(m, n) = sum;
+        }
+    }
+    TEST_ASSERT_TRUE(result_data == result.data);
+    TEST_ASSERT_TRUE(result == ref);
+
+    // A*B*A' with the destination as operand
+    for (int m = 0 ; m < N ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            float sum = 0;
+            for (int k = 0 ; k < N ; k++) {
+                for (int l = 0 ; l < N ; l++) {
+                    sum += A(m, k) * B(k, l) * A(n, l);
+                }
+            }
+            ref(m, n) = sum;
+        }
+    }
+    dspm::Mat P = B;
+    float *P_data = P.data;
+    P = A * P * A.t();
+    TEST_ASSERT_TRUE(P_data == P.data);
+    for (int m = 0 ; m < N ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-3, ref(m, n), P(m, n));
+        }
+    }
+
+    // Same matrix element by element, transposed, and resized
+    result = A;
+    result = result + C - 2 * result;
+    TEST_ASSERT_TRUE(result == C - A);
+    result = A.getROI(0, 0, 2, N);
+    result = result.t();
+    TEST_ASSERT_EQUAL(N, result.rows);
+    TEST_ASSERT_EQUAL(2, result.cols);
+    for (int m = 0 ; m < 2 ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            TEST_ASSERT_EQUAL_FLOAT(A(m, n), result(n, m));
+        }
+    }
+    result = (A * 2 + 1).t() / 2;
+    TEST_ASSERT_EQUAL_FLOAT((A(1, 3) * 2 + 1) / 2, result(3, 1));
+
+    // Sub-matrix as destination
+    dspm::Mat big(N + 2, N + 2);
+    dspm::Mat roi = big.getROI(1, 1, N, N);
+    roi = A * B + C;
+    TEST_ASSERT_TRUE(roi == A * B + C);
+    TEST_ASSERT_EQUAL_FLOAT(0, big(0, 0));
+    TEST_ASSERT_EQUAL_FLOAT(0, big(N + 1, N + 1));
+
+    // In place update
+    result = C;
+    result += A * B;
+    TEST_ASSERT_TRUE(result == A * B + C);
+    result -= A * B;
+    TEST_ASSERT_TRUE(result == C);
+
+    // Move: the buffer is taken, not copied
+    dspm::Mat moved(std::move(result));
+    TEST_ASSERT_TRUE(moved.data == result_data);
+    TEST_ASSERT_EQUAL(0, result.rows);
+    result = dspm::Mat(2, 3);
+    TEST_ASSERT_EQUAL(2, result.rows);
+    TEST_ASSERT_EQUAL(3, result.cols);
+}
+
+TEST_CASE("Mat class expressions benchmark", "[dspm]")
+{
+    int N = 13;
+    dspm::Mat F = dspm::Mat::eye(N);
+    dspm::Mat P(N, N);
+    dspm::Mat Q(N, N);
+    for (int m = 0 ; m < N ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            F(m, n) += 0.01f * (m - n);
+            P(m, n) = (m == n) ? 1 : 0.001f;
+        }
+    }
+    dspm::Mat P_expr = P;
+    dspm::Mat P_step = P;
+    const int repeat = 10;
+
+    // One temporary (F*P), F' is not stored and the result goes to P
+    unsigned int start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat ; i++) {
+        P_expr = F * P_expr * F.t() + Q;
+    }
+    unsigned int end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "P = F*P*F' + Q with expressions: %i cycles", (end_b - start_b) / repeat);
+
+    // Every step into a matrix
+    start_b = xthal_get_ccount();
+    for (int i = 0 ; i < repeat ; i++) {
+        dspm::Mat Ft = F.t();
+        dspm::Mat FP = F * P_step;
+        dspm::Mat FPFt = FP * Ft;
+        P_step = FPFt;
+        P_step += Q;
+    }
+    end_b = xthal_get_ccount();
+    ESP_LOGI(TAG, "P = F*P*F' + Q step by step: %i cycles", (end_b - start_b) / repeat);
+
+    for (int m = 0 ; m < N ; m++) {
+        for (int n = 0 ; n < N ; n++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4, P_step(m, n), P_expr(m, n));
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#ifndef IMU_FUSION_H_
+#define IMU_FUSION_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup IMU_Fusion IMU Fusion
+ ** @{ */
+
+/** \brief Attitude estimation from accelerometer and gyroscope samples (e.g. MPU6050)
+ *
+ * Raw samples are converted to SI units (rad/s, m/s^2) with the full scale
+ * ranges and the calibration offsets and gains. Each sample runs the
+ * prediction step of the ekf_imu13states filter (gyroscope integration,
+ * dt taken from the sample timestamps), and every update_divider samples the
+ * accelerometer corrects the attitude and the gyroscope bias. Accelerometer
+ * samples far from 1 g (the sensor is being accelerated) are not used.
+ *
+ * The first sample sets the initial attitude from the gravity direction, so
+ * roll and pitch are right from the start.
+ *
+ * @note Without magnetometer the heading (yaw) is only integrated from the
+ * gyroscope: it drifts slowly.
+ *
+ * This module doesn't depend on FreeRTOS nor on the drivers: it runs on the
+ * host (see tools/imu_replay). imu_fusion_service feeds it from the MPU6050
+ * FIFO.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define IMU_FUSION_GRAVITY		9.80665f	/*!< Standard gravity (m/s^2) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Sensor calibration (applied after the conversion to SI units)
+ *
+ * value = (raw * range scale - offset) * gain
+ */
+typedef struct {
+	float accel_offset[3];		/*!< Accelerometer offset (m/s^2) */
+	float accel_gain[3];		/*!< Accelerometer gain (0: 1.0) */
+	float gyro_offset[3];		/*!< Gyroscope offset (rad/s), the filter estimates the remaining bias */
+} imu_fusion_calibration_t;
+
+/**
+ * @brief Fusion configuration
+ */
+typedef struct {
+	uint16_t rate_hz;			/*!< Nominal sample rate (used when timestamps are missing or have gaps) */
+	uint8_t accel_range;		/*!< Accelerometer full scale (MPU6050_ACCEL_FS_x: 0 to 3) */
+	uint8_t gyro_range;			/*!< Gyroscope full scale (MPU6050_GYRO_FS_x: 0 to 3) */
+	uint16_t update_divider;	/*!< Accelerometer update every update_divider samples (0: 1) */
+	float accel_noise;			/*!< Accelerometer measurement noise (R, normalized units, 0: default) */
+	float accel_gate;			/*!< Maximum |a| - 1 g (in g) of the samples used for updates (0: no gate) */
+	imu_fusion_calibration_t cal;	/*!< Calibration */
+} imu_fusion_config_t;
+
+/**
+ * @brief Sample in SI units
+ */
+typedef struct {
+	float accel[3];				/*!< Acceleration X, Y, Z (m/s^2) */
+	float gyro[3];				/*!< Angular rate X, Y, Z (rad/s) */
+} imu_fusion_sample_t;
+
+/**
+ * @brief Estimated attitude
+ */
+typedef struct {
+	float q[4];					/*!< Attitude quaternion (w, x, y, z) */
+	uint32_t timestamp;			/*!< Time of the last sample used (usec) */
+	bool updated;				/*!< The last sample ran an accelerometer update */
+} imu_fusion_attitude_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @brief Initialize (or restart) the filter
+ *
+ * @param config    Fusion configuration
+ * @return true
+ * @return false    if a range is not valid, or the filter could not be allocated or has an unexpected state size
+ */
+bool ImuFusionInit(const imu_fusion_config_t *config);
+
+/**
+ * @brief Convert a raw sample to SI units (ranges and calibration)
+ *
+ * @param accel     Accelerometer X, Y, Z (raw counts)
+ * @param gyro      Gyroscope X, Y, Z (raw counts)
+ * @param sample    Sample in SI units
+ */
+void ImuFusionConvert(const int16_t accel[3], const int16_t gyro[3], imu_fusion_sample_t *sample);
+
+/**
+ * @brief Process a raw sample
+ *
+ * @param accel     Accelerometer X, Y, Z (raw counts)
+ * @param gyro      Gyroscope X, Y, Z (raw counts)
+ * @param timestamp Time of the sample (usec)
+ * @param attitude  Attitude after the sample (can be NULL)
+ */
+void ImuFusionProcess(const int16_t accel[3], const int16_t gyro[3], uint32_t timestamp, imu_fusion_attitude_t *attitude);
+
+/**
+ * @brief Process a sample already in SI units
+ *
+ * @param sample    Sample in SI units
+ * @param timestamp Time of the sample (usec)
+ * @param attitude  Attitude after the sample (can be NULL)
+ */
+void ImuFusionProcessSample(const imu_fusion_sample_t *sample, uint32_t timestamp, imu_fusion_attitude_t *attitude);
+
+/**
+ * @brief Estimated gyroscope bias (not yet removed by the calibration)
+ *
+ * @param bias      Bias X, Y, Z (rad/s)
+ */
+void ImuFusionGyroBias(float bias[3]);
+#ifdef __cplusplus
+}
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* IMU_FUSION_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,95 @@
+#ifndef IMU_FUSION_SERVICE_H_
+#define IMU_FUSION_SERVICE_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup IMU_Fusion_Service IMU Fusion Service
+ ** @{ */
+
+/** \brief MPU6050 attitude service
+ *
+ * A task reads bursts of samples from the MPU6050 FIFO (see mpu6050_fifo),
+ * runs every sample through imu_fusion (prediction at the sensor rate,
+ * accelerometer updates every update_divider samples) and publishes the
+ * attitude after each burst: the newest one is kept for
+ * ImuFusionServiceRead(), and the optional callback is called.
+ *
+ * The delay from a sample to its attitude is about one burst (burst /
+ * rate_hz) plus the processing time: use short bursts for low latency and
+ * longer ones to reduce the wake ups.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "imu_fusion.h"
+#include "mpu6050_fifo.h"
+/*==================[macros]=================================================*/
+#define IMU_FUSION_SERVICE_BURST_MAX	32			/*!< Longest FIFO burst */
+#define IMU_FUSION_SERVICE_NO_TIMEOUT	0xFFFFFFFF	/*!< Wait forever on ImuFusionServiceRead() */
+/*==================[typedef]================================================*/
+/**
+ * @brief Service configuration
+ *
+ * The FIFO always stores accelerometer and gyroscope; fifo.rate_hz and
+ * fifo.burst also set the fusion nominal rate.
+ */
+typedef struct {
+	imu_fusion_config_t fusion;		/*!< Fusion configuration (rate_hz is taken from fifo) */
+	mpu6050_fifo_config_t fifo;		/*!< FIFO configuration (burst up to IMU_FUSION_SERVICE_BURST_MAX) */
+	uint8_t task_priority;			/*!< Priority of the service task */
+	void *func_p;					/*!< Called after each burst from the service task: void func(void *param_p) (can be NULL) */
+	void *param_p;					/*!< Callback parameter */
+} imu_fusion_service_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @brief Start the acquisition and the service task
+ *
+ * @note The MPU6050 must be initialized (MPU6050_initialize()) with the
+ * ranges given in config->fusion, and the INT pin configured as input.
+ *
+ * @param config    Service configuration
+ * @return true
+ * @return false    if the configuration is not valid, or the task could not be created
+ */
+bool ImuFusionServiceStart(const imu_fusion_service_config_t *config);
+
+/**
+ * @brief Wait for a new attitude
+ *
+ * @param attitude      Newest attitude
+ * @param timeout_ms    Maximum time to wait (0: only the one not read yet, IMU_FUSION_SERVICE_NO_TIMEOUT: forever)
+ * @return true
+ * @return false        on timeout
+ */
+bool ImuFusionServiceRead(imu_fusion_attitude_t *attitude, uint32_t timeout_ms);
+
+/**
+ * @brief Stop the service task and the acquisition
+ */
+void ImuFusionServiceStop(void);
+#ifdef __cplusplus
+}
+#endif
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* IMU_FUSION_SERVICE_H_ */
+
+/*==================[end of file]============================================*/
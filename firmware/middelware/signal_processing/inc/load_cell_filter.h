@@ -0,0 +1,130 @@
+#ifndef LOAD_CELL_FILTER_H_
+#define LOAD_CELL_FILTER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Load_Cell_Filter Load Cell Filter
+ ** @{ */
+
+/** \brief Streaming filter for load cell samples (e.g. HX711)
+ *
+ * Each sample goes through:
+ * - a median of the last N samples, that removes isolated spikes,
+ * - an adaptive exponential average: its window doubles while the load is
+ *   stable (up to 2^max_window_log2 samples) and collapses to
+ *   2^min_window_log2 when the input moves more than step_threshold, so the
+ *   output settles fast after a load change and is quiet when stable,
+ * - tare and scale in integer arithmetic (scale in Q16 units per count).
+ *
+ * Only integer arithmetic is used (no soft-float on cores without FPU), but
+ * the filter runs once per sample: it takes more CPU per reading than the
+ * block average of HX711_getUnits() (see tools/load_cell_bench).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define LOAD_CELL_MEDIAN_MAX	7	/*!< Maximum median window */
+#define LOAD_CELL_Q16_ONE		65536	/*!< 1.0 in Q16 */
+/*==================[typedef]================================================*/
+/**
+ * @brief Filter configuration
+ */
+typedef struct {
+	uint8_t median_size;		/*!< Median window (1: disabled, odd up to LOAD_CELL_MEDIAN_MAX) */
+	uint8_t min_window_log2;	/*!< Averaging window after a step (2^n samples) */
+	uint8_t max_window_log2;	/*!< Averaging window when stable (2^n samples, up to 16) */
+	int32_t step_threshold;		/*!< Deviation (in counts) that is considered a load change */
+} load_cell_filter_config_t;
+
+/**
+ * @brief Filter state
+ */
+typedef struct {
+	load_cell_filter_config_t config;			/*!< Configuration */
+	int32_t window[LOAD_CELL_MEDIAN_MAX];		/*!< Last samples for the median */
+	uint8_t window_count;						/*!< Samples in window */
+	uint8_t window_pos;							/*!< Next position to write in window */
+	int32_t acc;								/*!< Average in Q6 (counts * 64) */
+	uint8_t shift;								/*!< Current averaging window (log2) */
+	uint16_t stable_count;						/*!< Stable samples with the current window */
+	bool primed;								/*!< acc holds a value */
+	int32_t offset;								/*!< Tare (in counts) */
+	int32_t scale_q16;							/*!< Units per count in Q16 */
+} load_cell_filter_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a filter (tare 0, scale 1)
+ *
+ * @param filter    Filter state
+ * @param config    Filter configuration
+ */
+void LoadCellFilterInit(load_cell_filter_t *filter, const load_cell_filter_config_t *config);
+
+/**
+ * @brief Process a new raw sample
+ *
+ * @param filter    Filter state
+ * @param raw       Raw sample (counts)
+ * @return int32_t  Filtered sample (counts, without tare)
+ */
+int32_t LoadCellFilterUpdate(load_cell_filter_t *filter, int32_t raw);
+
+/**
+ * @brief Last filtered sample converted to units: (filtered - tare) * scale
+ *
+ * @param filter    Filter state
+ * @return int32_t  Value in the units given by the scale
+ */
+int32_t LoadCellFilterUnits(const load_cell_filter_t *filter);
+
+/**
+ * @brief Checks if the filter reached its longest averaging window
+ *
+ * @param filter    Filter state
+ * @return true     Load is stable
+ */
+bool LoadCellFilterStable(const load_cell_filter_t *filter);
+
+/**
+ * @brief Use the current filtered value as tare
+ *
+ * @param filter    Filter state
+ */
+void LoadCellFilterTare(load_cell_filter_t *filter);
+
+/**
+ * @brief Set the tare offset
+ *
+ * @param filter    Filter state
+ * @param offset    Tare (in counts)
+ */
+void LoadCellFilterSetOffset(load_cell_filter_t *filter, int32_t offset);
+
+/**
+ * @brief Set the scale
+ *
+ * @param filter    Filter state
+ * @param scale_q16 Units per count in Q16 (e.g. LOAD_CELL_Q16_ONE / 420 for 420 counts per gram)
+ */
+void LoadCellFilterSetScale(load_cell_filter_t *filter, int32_t scale_q16);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* LOAD_CELL_FILTER_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,188 @@
+/**
+ * @file imu_fusion.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <math.h>
+#include "imu_fusion.h"
+#include "ekf_imu13states.h"
+#include "fixed_mat.h"
+/*==================[macros and definitions]=================================*/
+#define ACCEL_LSB_2G		16384.0f	/*!< Counts per g with MPU6050_ACCEL_FS_2 */
+#define GYRO_LSB_250		131.0f		/*!< Counts per deg/s with MPU6050_GYRO_FS_250 */
+#define RANGES				4
+#define ACCEL_NOISE			0.01f		/*!< Default accelerometer R (normalized units) */
+#define MAX_GAP_SAMPLES		10			/*!< Longer gaps (or time going back) use the nominal period */
+#define FILTER_STATES		13			/*!< State size of ekf_imu13states */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static ekf_imu13states *filter = NULL;
+static dspm::FixedMat<3, FILTER_STATES> H;	/*!< Accelerometer update derivatives */
+static dspm::FixedMat<3, 3> Rm;				/*!< Rotation matrix of the attitude */
+static dspm::FixedMat<3, 1> gravity;		/*!< Reference gravity direction (filter accel0) */
+static imu_fusion_config_t fusion_cfg;
+static float accel_scale;					/*!< m/s^2 per count */
+static float gyro_scale;					/*!< rad/s per count */
+static float nominal_dt;					/*!< Sample period (s) */
+static uint32_t last_timestamp;
+static uint16_t update_count;				/*!< Samples since the last update */
+static bool started;						/*!< The first sample was processed */
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Attitude that takes the measured gravity direction to Z (yaw 0)
+ */
+static void ImuFusionAlign(const float a[3], float q[4]){
+	/* Rotation from a to (0, 0, 1): axis a x z, angle acos(a . z) (half angle trick) */
+	float w = 1.0f + a[2];
+	if(w < 1e-6f){
+		/* Upside down: half turn around X */
+		q[0] = 0; q[1] = 1; q[2] = 0; q[3] = 0;
+		return;
+	}
+	float n = sqrtf(w * w + a[1] * a[1] + a[0] * a[0]);
+	q[0] = w / n;
+	q[1] = a[1] / n;
+	q[2] = -a[0] / n;
+	q[3] = 0;
+}
+
+static void ImuFusionNormalize(float q[4]){
+	float n = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+	for(uint8_t i = 0; i < 4; i++){
+		q[i] /= n;
+	}
+}
+
+static void ImuFusionUpdate(const float a[3]){
+	float *quat = filter->X.data;
+	float measured[3] = {a[0], a[1], a[2]};
+	dspm::FixedMat<3, 1> expected;
+	float R[3] = {fusion_cfg.accel_noise, fusion_cfg.accel_noise, fusion_cfg.accel_noise};
+	/* The ekf functions fill them through Mat views of their buffers */
+	dspm::Mat Rm_view = Rm.view();
+	dspm::Mat H_view = H.view();
+
+	/* Expected gravity: Rm' * accel0 */
+	ekf::quat2rotm(quat, Rm_view);
+	dspm::transposedMult(Rm, gravity, expected);
+	ekf::dFdq_inv(gravity.data, quat, H_view);
+	filter->Update(H_view, measured, expected.data, R);
+	ImuFusionNormalize(filter->X.data);
+}
+/*==================[external functions definition]==========================*/
+bool ImuFusionInit(const imu_fusion_config_t *config){
+	if((config->accel_range >= RANGES) || (config->gyro_range >= RANGES) || (config->rate_hz == 0)){
+		return false;
+	}
+	fusion_cfg = *config;
+	if(fusion_cfg.update_divider == 0){
+		fusion_cfg.update_divider = 1;
+	}
+	if(fusion_cfg.accel_noise <= 0){
+		fusion_cfg.accel_noise = ACCEL_NOISE;
+	}
+	for(uint8_t i = 0; i < 3; i++){
+		if(fusion_cfg.cal.accel_gain[i] == 0){
+			fusion_cfg.cal.accel_gain[i] = 1.0f;
+		}
+	}
+	/* Each range doubles the previous one */
+	accel_scale = IMU_FUSION_GRAVITY / (ACCEL_LSB_2G / (1 << fusion_cfg.accel_range));
+	gyro_scale = ((float)M_PI / 180.0f) / (GYRO_LSB_250 / (1 << fusion_cfg.gyro_range));
+	nominal_dt = 1.0f / fusion_cfg.rate_hz;
+
+	if(filter == NULL){
+		filter = new ekf_imu13states();
+	}
+	/* H and the update are sized at compile time: the filter must match */
+	if(filter->NUMX != FILTER_STATES){
+		return false;
+	}
+	filter->X *= 0;
+	filter->P *= 0;
+	filter->Init();
+	H = dspm::FixedMat<3, FILTER_STATES>();
+	gravity = dspm::FixedMat<3, 1>(filter->accel0);
+	update_count = 0;
+	started = false;
+	return true;
+}
+
+void ImuFusionConvert(const int16_t accel[3], const int16_t gyro[3], imu_fusion_sample_t *sample){
+	for(uint8_t i = 0; i < 3; i++){
+		sample->accel[i] = (accel[i] * accel_scale - fusion_cfg.cal.accel_offset[i]) * fusion_cfg.cal.accel_gain[i];
+		sample->gyro[i] = gyro[i] * gyro_scale - fusion_cfg.cal.gyro_offset[i];
+	}
+}
+
+void ImuFusionProcess(const int16_t accel[3], const int16_t gyro[3], uint32_t timestamp, imu_fusion_attitude_t *attitude){
+	imu_fusion_sample_t sample;
+	ImuFusionConvert(accel, gyro, &sample);
+	ImuFusionProcessSample(&sample, timestamp, attitude);
+}
+
+void ImuFusionProcessSample(const imu_fusion_sample_t *sample, uint32_t timestamp, imu_fusion_attitude_t *attitude){
+	float a[3] = {0, 0, 0};		/* Gravity direction (only used when norm > 0) */
+	float norm = sqrtf(sample->accel[0] * sample->accel[0] + sample->accel[1] * sample->accel[1] +
+					   sample->accel[2] * sample->accel[2]);
+	bool updated = false;
+
+	if(norm > 0){
+		for(uint8_t i = 0; i < 3; i++){
+			a[i] = sample->accel[i] / norm;
+		}
+	}
+	if(!started){
+		if(norm > 0){
+			ImuFusionAlign(a, filter->X.data);
+		}
+		started = true;
+	} else {
+		float dt = (uint32_t)(timestamp - last_timestamp) * 1e-6f;
+		float u[3] = {sample->gyro[0], sample->gyro[1], sample->gyro[2]};
+		if((dt <= 0) || (dt > MAX_GAP_SAMPLES * nominal_dt)){
+			dt = nominal_dt;
+		}
+		filter->Process(u, dt);
+		ImuFusionNormalize(filter->X.data);
+
+		if(++update_count >= fusion_cfg.update_divider){
+			/* Only gravity: samples with other accelerations are skipped */
+			float deviation = fabsf(norm / IMU_FUSION_GRAVITY - 1.0f);
+			if((norm > 0) && ((fusion_cfg.accel_gate == 0) || (deviation <= fusion_cfg.accel_gate))){
+				ImuFusionUpdate(a);
+				update_count = 0;
+				updated = true;
+			}
+		}
+	}
+	last_timestamp = timestamp;
+
+	if(attitude != NULL){
+		for(uint8_t i = 0; i < 4; i++){
+			attitude->q[i] = filter->X.data[i];
+		}
+		attitude->timestamp = timestamp;
+		attitude->updated = updated;
+	}
+}
+
+void ImuFusionGyroBias(float bias[3]){
+	for(uint8_t i = 0; i < 3; i++){
+		bias[i] = filter->X.data[4 + i];
+	}
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,117 @@
+/**
+ * @file imu_fusion_service.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "imu_fusion_service.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+/*==================[macros and definitions]=================================*/
+#define SERVICE_STACK		4096
+#define READ_TIMEOUT_MS		100		/*!< FIFO wait, so a stop request is seen */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+static TaskHandle_t service_task = NULL;
+static QueueHandle_t attitude_box = NULL;		/*!< Newest attitude (queue of one, overwritten) */
+static imu_fusion_service_config_t service_cfg;
+static volatile bool stopping = false;
+static int16_t ax[IMU_FUSION_SERVICE_BURST_MAX], ay[IMU_FUSION_SERVICE_BURST_MAX], az[IMU_FUSION_SERVICE_BURST_MAX];
+static int16_t gx[IMU_FUSION_SERVICE_BURST_MAX], gy[IMU_FUSION_SERVICE_BURST_MAX], gz[IMU_FUSION_SERVICE_BURST_MAX];
+static uint32_t stamps[IMU_FUSION_SERVICE_BURST_MAX];
+static mpu6050_samples_t samples = {
+	.ax = ax, .ay = ay, .az = az,
+	.temp = NULL,
+	.gx = gx, .gy = gy, .gz = gz,
+	.timestamp = stamps,
+	.size = IMU_FUSION_SERVICE_BURST_MAX,
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void ImuFusionServiceTask(void *param){
+	imu_fusion_attitude_t attitude;
+	void (*func_p)(void*) = service_cfg.func_p;
+
+	while(!stopping){
+		uint16_t n = MPU6050FifoRead(&samples, READ_TIMEOUT_MS);
+		if(n == 0){
+			continue;
+		}
+		for(uint16_t i = 0; i < n; i++){
+			int16_t accel[3] = {ax[i], ay[i], az[i]};
+			int16_t gyro[3] = {gx[i], gy[i], gz[i]};
+			ImuFusionProcess(accel, gyro, stamps[i], &attitude);
+		}
+		xQueueOverwrite(attitude_box, &attitude);
+		if(func_p != NULL){
+			func_p(service_cfg.param_p);
+		}
+	}
+	MPU6050FifoStop();
+	service_task = NULL;
+	vTaskDelete(NULL);
+}
+/*==================[external functions definition]==========================*/
+bool ImuFusionServiceStart(const imu_fusion_service_config_t *config){
+	if((service_task != NULL) || (config->fifo.burst > IMU_FUSION_SERVICE_BURST_MAX)){
+		return false;
+	}
+	service_cfg = *config;
+	service_cfg.fifo.contents = MPU6050_FIFO_ACCEL | MPU6050_FIFO_GYRO;
+	service_cfg.fusion.rate_hz = service_cfg.fifo.rate_hz;
+	if(!ImuFusionInit(&service_cfg.fusion)){
+		return false;
+	}
+	if(attitude_box == NULL){
+		attitude_box = xQueueCreate(1, sizeof(imu_fusion_attitude_t));
+		if(attitude_box == NULL){
+			return false;
+		}
+	}
+	xQueueReset(attitude_box);
+	if(!MPU6050FifoStart(&service_cfg.fifo)){
+		return false;
+	}
+	stopping = false;
+	if(xTaskCreate(&ImuFusionServiceTask, "imu_fusion", SERVICE_STACK, NULL, service_cfg.task_priority, &service_task) != pdPASS){
+		service_task = NULL;
+		MPU6050FifoStop();
+		return false;
+	}
+	return true;
+}
+
+bool ImuFusionServiceRead(imu_fusion_attitude_t *attitude, uint32_t timeout_ms){
+	TickType_t ticks = portMAX_DELAY;
+	if(attitude_box == NULL){
+		return false;
+	}
+	if(timeout_ms != IMU_FUSION_SERVICE_NO_TIMEOUT){
+		ticks = pdMS_TO_TICKS(timeout_ms);
+	}
+	return xQueueReceive(attitude_box, attitude, ticks) == pdTRUE;
+}
+
+void ImuFusionServiceStop(void){
+	if(service_task == NULL){
+		return;
+	}
+	/* The task ends after its current FIFO wait */
+	stopping = true;
+	while(service_task != NULL){
+		vTaskDelay(pdMS_TO_TICKS(10));
+	}
+}
+
+/*==================[end of file]============================================*/
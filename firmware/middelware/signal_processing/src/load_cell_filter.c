@@ -0,0 +1,128 @@
+/**
+ * @file load_cell_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "load_cell_filter.h"
+/*==================[macros and definitions]=================================*/
+#define ACC_SHIFT       6       /* fractional bits of the average */
+#define MAX_WINDOW_LOG2 16
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static int32_t Median(const int32_t *window, uint8_t n){
+    int32_t sorted[LOAD_CELL_MEDIAN_MAX];
+    for(uint8_t i = 0; i < n; i++){
+        int32_t v = window[i];
+        int8_t j = i - 1;
+        while((j >= 0) && (sorted[j] > v)){
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+    return sorted[n / 2];
+}
+/*==================[external functions definition]==========================*/
+void LoadCellFilterInit(load_cell_filter_t *filter, const load_cell_filter_config_t *config){
+    filter->config = *config;
+    if(filter->config.median_size < 1){
+        filter->config.median_size = 1;
+    }
+    filter->config.median_size |= 1;
+    if(filter->config.median_size > LOAD_CELL_MEDIAN_MAX){
+        filter->config.median_size = LOAD_CELL_MEDIAN_MAX;
+    }
+    if(filter->config.max_window_log2 > MAX_WINDOW_LOG2){
+        filter->config.max_window_log2 = MAX_WINDOW_LOG2;
+    }
+    if(filter->config.min_window_log2 > filter->config.max_window_log2){
+        filter->config.min_window_log2 = filter->config.max_window_log2;
+    }
+    filter->window_count = 0;
+    filter->window_pos = 0;
+    filter->acc = 0;
+    filter->shift = filter->config.min_window_log2;
+    filter->stable_count = 0;
+    filter->primed = false;
+    filter->offset = 0;
+    filter->scale_q16 = LOAD_CELL_Q16_ONE;
+}
+
+int32_t LoadCellFilterUpdate(load_cell_filter_t *filter, int32_t raw){
+    load_cell_filter_config_t *cfg = &filter->config;
+    int32_t x = raw;
+    int32_t out, diff;
+
+    /* Spike rejection */
+    if(cfg->median_size > 1){
+        filter->window[filter->window_pos] = raw;
+        filter->window_pos = (filter->window_pos + 1) % cfg->median_size;
+        if(filter->window_count < cfg->median_size){
+            filter->window_count++;
+        }
+        x = Median(filter->window, filter->window_count);
+    }
+
+    if(!filter->primed){
+        filter->acc = x * (1 << ACC_SHIFT);
+        filter->primed = true;
+        return x;
+    }
+
+    /* Adaptive averaging */
+    out = filter->acc >> ACC_SHIFT;
+    diff = x - out;
+    if((diff > cfg->step_threshold) || (diff < -cfg->step_threshold)){
+        /* Load change: restart from the new value with the shortest window */
+        filter->acc = x * (1 << ACC_SHIFT);
+        filter->shift = cfg->min_window_log2;
+        filter->stable_count = 0;
+    } else{
+        filter->acc += ((x * (1 << ACC_SHIFT)) - filter->acc) >> filter->shift;
+        if(filter->shift < cfg->max_window_log2){
+            /* Window doubles after being filled with stable samples */
+            if(++filter->stable_count >= (1U << filter->shift)){
+                filter->shift++;
+                filter->stable_count = 0;
+            }
+        }
+    }
+    return filter->acc >> ACC_SHIFT;
+}
+
+int32_t LoadCellFilterUnits(const load_cell_filter_t *filter){
+    int64_t counts = (int64_t)(filter->acc >> ACC_SHIFT) - filter->offset;
+    return (int32_t)((counts * filter->scale_q16) >> 16);
+}
+
+bool LoadCellFilterStable(const load_cell_filter_t *filter){
+    return filter->primed && (filter->shift == filter->config.max_window_log2);
+}
+
+void LoadCellFilterTare(load_cell_filter_t *filter){
+    filter->offset = filter->acc >> ACC_SHIFT;
+}
+
+void LoadCellFilterSetOffset(load_cell_filter_t *filter, int32_t offset){
+    filter->offset = offset;
+}
+
+void LoadCellFilterSetScale(load_cell_filter_t *filter, int32_t scale_q16){
+    filter->scale_q16 = scale_q16;
+}
+
+/*==================[end of file]============================================*/
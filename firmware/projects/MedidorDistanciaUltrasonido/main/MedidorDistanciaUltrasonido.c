@@ -59,17 +59,17 @@ TaskHandle_t LeerSwitches_task_handle = NULL;
  * 		  de actualización de 1s.
 */
 static void MedirDistancia (void *pvParameter){
-
- while(true){
-
-	if (medir_distancia){
-
-	distancia = HcSr04ReadDistanceInCentimeters();}
-
+	hc_sr04_measure_t medida;
+	while(true){
+	if (medir_distancia && HcSr04Trigger()){
+		/* La tarea queda bloqueada sin consumir CPU hasta que termina el eco */
+		if (HcSr04GetMeasure(&medida, CONFIG_MEASURE_PERIOD)){
+			distancia = (medida.status == HC_SR04_TIMEOUT) ? 0 : medida.distance_mm / 10;
+		}}
 	vTaskDelay(CONFIG_MEASURE_PERIOD / portTICK_PERIOD_MS);
 	}
-
 }
+
 /**
  * @brief Función que enciende los leds de acuerdo a la distancia medida.
  * 		  Si la distancia<10cm, se apagan todos los leds.
@@ -172,7 +172,7 @@ void app_main(void){
 
 	LedsInit();
 	SwitchesInit();
-	HcSr04Init(GPIO_3, GPIO_2);
+	HcSr04AsyncInit(GPIO_3, GPIO_2);
 	LcdItsE0803Init();
 
 	xTaskCreate(&LeerSwitches, "Leer_Teclas", 512, NULL, 5, &LeerSwitches_task_handle);
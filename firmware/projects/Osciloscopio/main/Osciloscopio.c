@@ -3,12 +3,18 @@
  * @section genDesc General Description
  *
  * Programa que permite leer una señal analógica y convertirla a digital y viceversa. 
+ * La señal leída se grafica en el display LCD con desplazamiento continuo.
  *
  * @section hardConn Hardware Connection
  *
  * |    Peripheral  |   ESP32   	|
  * |:--------------:|:--------------|
  * | 	CH1 	 	| 	GPIO1		|
+ * | 	LCD CS	 	| 	GPIO19		|
+ * | 	LCD DC	 	| 	GPIO3		|
+ * | 	LCD RESET 	| 	GPIO2		|
+ * | 	LCD SCK	 	| 	GPIO20		|
+ * | 	LCD MOSI 	| 	GPIO21		|
  *
  *
  * @section changelog Changelog
@@ -17,6 +23,7 @@
  * |:----------:|:-----------------------------------------------|
  * | 25/04/2024 | Creación del Documento                         |
  * | 02/05/2024 | Finalizacion y Documentacion					 |
+ * | 19/10/2026 | Señal graficada en el LCD a 1 kHz				 |
  *
  * @author Tatiana Ailen Wendler (ailuwendler@gmail.com)
  *
@@ -29,22 +36,47 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include <timer_mcu.h>
-#include <uart_mcu.h>
 #include <analog_io_mcu.h>
 #include <switch.h>
+#include <ili9341.h>
 /*==================[macros and definitions]=================================*/
 
 /** @def CONFIG_MEASURE_PERIOD
  *  @brief Periodo en microsegundos que se utiliza para el timer que controla la conversion de analógico
  * a digital. Se calcula considerando la frecuencia de muestreo.
 */
-#define CONFIG_MEASURE_PERIOD 2000
+#define CONFIG_MEASURE_PERIOD 1000
 
 /** @def BUFFER_SIZE
  * @brief Tamanio del buffer que posee los datos del ecg.
 */
 #define BUFFER_SIZE 231
 
+/** @def PLOT_DECIMATION
+ * @brief Muestras por columna del grafico (se dibujan su minimo y maximo).
+*/
+#define PLOT_DECIMATION 4
+
+/** @def ADC_MAX
+ * @brief Maximo valor leido por el ADC.
+*/
+#define ADC_MAX 4095
+
+/** @def ECG_PERIOD_MIN
+ * @brief Periodo minimo (en microsegundos) del timer del ecg.
+*/
+#define ECG_PERIOD_MIN 500
+
+/** @def ECG_PERIOD_MAX
+ * @brief Periodo maximo (en microsegundos) del timer del ecg.
+*/
+#define ECG_PERIOD_MAX 20000
+
+/** @def ECG_PERIOD_STEP
+ * @brief Cambio del periodo del timer del ecg en cada evento de las teclas.
+*/
+#define ECG_PERIOD_STEP 100
+
 /*==================[internal data definition]===============================*/
 TaskHandle_t ConvertirADigital_task_handle = NULL;
 TaskHandle_t ConvertirAAnalogico_task_handle = NULL;
@@ -110,7 +142,7 @@ void FuncTimerB(void* param){
 }
 
 /**
- * @brief Funcion que permite leer una entrada analógica y convertirla a Digital. 
+ * @brief Funcion que permite leer una entrada analógica, convertirla a Digital y graficarla en el LCD. 
 */
 
 static void ConvertirADigital(void *param){
@@ -119,8 +151,8 @@ static void ConvertirADigital(void *param){
 
 	uint16_t lectura;
 	AnalogInputReadSingle(CH1, &lectura);
-	UartSendString(UART_PC, (char *)UartItoa(lectura, 10));
-	UartSendString(UART_PC, "\r" );
+	int32_t muestra = lectura;
+	ILI9341TraceAdd(&muestra);
 }}
 
 /**
@@ -145,38 +177,54 @@ static void ConvertirAAnalogico(void *param){
 }}
 
 /**
- * @brief Funcion de interrupcion de los switches. Al presionar el switch 1 se aumenta la frecuencia del muestro del ecg.
- * Con el switch 2 se disminuye la frecuencia del ecg. 
+ * @brief Tarea que atiende los eventos de los switches. Al presionar el switch 1 se aumenta la frecuencia del muestro del ecg.
+ * Con el switch 2 se disminuye la frecuencia del ecg. Manteniendo presionado el switch se repite el cambio.
  */
-void static LeerSwitches (void *pvParameter){
+static void LeerSwitches(void *pvParameter){
 
-	int tecla;
+	switch_event_t evento;
 
-	tecla = SwitchesRead();
+	while (true){
+	if (!SwitchEventsGet(&evento, SWITCH_EVENTS_NO_TIMEOUT) ||
+		(evento.type == SWITCH_EV_RELEASE) || (evento.type == SWITCH_EV_LONG_PRESS)){
+		continue;
+	}
 
-	switch (tecla)
+	switch (evento.key)
 	{
 	case SWITCH_1:
-		ECG_FREQUENCY = ECG_FREQUENCY - 100;
-		timer_ecg.period = ECG_FREQUENCY;
-		TimerInit(&timer_ecg);
-		TimerStart(timer_ecg.timer);
+		ECG_FREQUENCY = ECG_FREQUENCY - ECG_PERIOD_STEP;
+		if (ECG_FREQUENCY < ECG_PERIOD_MIN){
+			ECG_FREQUENCY = ECG_PERIOD_MIN;
+		}
 		break;
 	
 	case SWITCH_2:
-		ECG_FREQUENCY = ECG_FREQUENCY + 100;
-		timer_ecg.period = ECG_FREQUENCY;
-		TimerInit(&timer_ecg);
-		TimerStart(timer_ecg.timer);
+		ECG_FREQUENCY = ECG_FREQUENCY + ECG_PERIOD_STEP;
+		if (ECG_FREQUENCY > ECG_PERIOD_MAX){
+			ECG_FREQUENCY = ECG_PERIOD_MAX;
+		}
 		break;
+
+	default:
+		continue;
 	}
-}
+	/* Se cambia la alarma del timer ya creado (TimerInit() crearia otro timer) */
+	timer_ecg.period = ECG_FREQUENCY;
+	TimerUpdatePeriod(timer_ecg.timer, timer_ecg.period);
+}}
 
 
 /*==================[external functions definition]==========================*/
 void app_main(void){
 
-	SwitchesInit();
+	switch_events_config_t switches_config = {
+		.sample_period_ms = 5,
+		.debounce_ms = 20,
+		.long_press_ms = 600,
+		.repeat_ms = 200,
+	};
+	SwitchEventsInit(&switches_config);
 
 	analog_input_config_t entrada_analogica ={
 		.input = CH1,
@@ -186,17 +234,28 @@ void app_main(void){
 	AnalogInputInit(&entrada_analogica);
 	AnalogOutputInit();
 
-	serial_config_t serial_pc ={
-		.port = UART_PC,
-		.baud_rate = 115200,
-		.func_p = NULL,
-		.param_p = NULL,
+	/* Grafico: las 40 columnas de la izquierda quedan fijas para las etiquetas */
+	ILI9341Init(SPI_1, GPIO_3, GPIO_2);
+	ILI9341Rotate(ILI9341_Landscape_1);
+	ILI9341Fill(ILI9341_BLACK);
+	ILI9341DrawString(2, 10, "3.3V", &font_11, ILI9341_WHITE, ILI9341_BLACK);
+	ILI9341DrawString(2, 220, "0V", &font_11, ILI9341_WHITE, ILI9341_BLACK);
+	ili9341_trace_config_t grafico = {
+		.x = 40,
+		.width = 280,
+		.y = 10,
+		.height = 220,
+		.min = 0,
+		.max = ADC_MAX,
+		.decimation = PLOT_DECIMATION,
+		.traces = 1,
+		.colors = {ILI9341_YELLOW},
+		.background = ILI9341_BLACK,
+		.grid_color = ILI9341_DARKGREY,
+		.grid_x = 25,
+		.grid_y = 44,
 	};
-
-	UartInit(&serial_pc);
-
-	SwitchActivInt(SWITCH_1, LeerSwitches, NULL);
-	SwitchActivInt(SWITCH_2, LeerSwitches, NULL);
+	ILI9341TraceInit(&grafico);
 
 	timer_config_t timer_medicion = {
     	.timer = TIMER_A,
@@ -210,8 +269,9 @@ void app_main(void){
 
 	TimerInit(&timer_medicion);
 	TimerInit(&timer_ecg);
-	xTaskCreate(&ConvertirADigital, "Convertir señal a Digital", 512, NULL, 5, &ConvertirADigital_task_handle);
+	xTaskCreate(&ConvertirADigital, "Convertir señal a Digital", 2048, NULL, 5, &ConvertirADigital_task_handle);
 	xTaskCreate(&ConvertirAAnalogico, "Convertir señal a Analogica", 512, NULL, 5, &ConvertirAAnalogico_task_handle);
+	xTaskCreate(&LeerSwitches, "Leer switches", 2048, NULL, 4, NULL);
 	TimerStart(timer_medicion.timer);
 	TimerStart(timer_ecg.timer);
 	
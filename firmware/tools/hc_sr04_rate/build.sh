@@ -0,0 +1,10 @@
+#!/bin/sh
+# Builds hc_sr04_rate for the host with the hc_sr04_array driver sources.
+# host/ has the few ESP-IDF and FreeRTOS headers they include.
+set -e
+cd "$(dirname "$0")"
+DRV=../../drivers
+INC="-Ihost -I$DRV/devices/inc -I$DRV/microcontroller/inc"
+mkdir -p build
+${CC:-cc} -O2 $INC -o build/hc_sr04_rate hc_sr04_rate.c $DRV/devices/src/hc_sr04_array.c
+echo "build/hc_sr04_rate"
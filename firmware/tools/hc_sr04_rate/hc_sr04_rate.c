@@ -0,0 +1,236 @@
+/**
+ * @file hc_sr04_rate.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host simulation of the hc_sr04_array scheduler
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Runs the hc_sr04_array driver (the same source used by the firmware) with
+ * simulated time, GPIOs and capture queue, and reports the aggregate
+ * measurement rate given by HcSr04ArrayRate().
+ *
+ * Sensor model: every sensor sees a target at the same distance; the echo
+ * pin rises latency_us after the trigger and stays high for the round trip
+ * of the sound (58.3 us/cm). Task switches and ISR latencies of the target
+ * are not modeled, so the rates are upper bounds.
+ *
+ * Build (from this folder): ./build.sh
+ *
+ * Usage:
+ *   hc_sr04_rate                      (1 sensor, round-robin and 2 groups of 4, at 1 m and 3 m)
+ *   hc_sr04_rate [--sensors 8] [--groups 2] [--distance 100] [--guard 10000] [--latency 500] [--seconds 10]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hc_sr04_array.h"
+#include "gpio_capture_mcu.h"
+#include "delay_mcu.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+/*==================[macros and definitions]=================================*/
+#define US_PER_CM		58.3f	/*!< Echo width per cm of distance (343 m/s, round trip) */
+#define EDGES_MAX		(4 * HC_SR04_ARRAY_MAX)
+
+typedef struct {
+	uint8_t sensors;
+	uint8_t groups;
+	uint16_t distance_cm;
+	uint16_t guard_us;
+	uint16_t latency_us;
+	uint32_t seconds;
+} options_t;
+/*==================[internal data definition]===============================*/
+static int64_t now_us;						/*!< Simulated time */
+static int64_t end_us;						/*!< The scheduler is stopped after this time */
+static gpio_capture_event_t edges[EDGES_MAX];	/*!< Edges not read yet, by time (like the capture queue) */
+static uint16_t edges_qty;
+static hc_sr04_sensor_t sensors[HC_SR04_ARRAY_MAX];
+static options_t opt;
+static TaskHandle_t current_task;			/*!< Task running inside xTaskCreate() */
+/*==================[internal functions definition]==========================*/
+static void AddEdge(uint32_t timestamp, gpio_t pin, bool rising){
+	int16_t i = edges_qty - 1;
+	if(edges_qty >= EDGES_MAX){
+		return;
+	}
+	while((i >= 0) && (edges[i].timestamp > timestamp)){
+		edges[i + 1] = edges[i];
+		i--;
+	}
+	edges[i + 1] = (gpio_capture_event_t){.timestamp = timestamp, .pin = pin, .rising = rising};
+	edges_qty++;
+}
+
+/**
+ * @brief Time when n edges are available (or -1 if there will never be n)
+ */
+static int64_t NthEdgeTime(uint16_t n){
+	if(n == 0){
+		return now_us;
+	}
+	return (n > edges_qty) ? -1 : edges[n - 1].timestamp;
+}
+
+static uint32_t Run(const options_t *o){
+	hc_sr04_array_config_t cfg = {
+		.sensors = sensors,
+		.sensors_qty = o->sensors,
+		.guard_us = o->guard_us,
+		.median_size = 1,
+	};
+	for(uint8_t i = 0; i < o->sensors; i++){
+		sensors[i].trigger = (gpio_t)i;
+		sensors[i].echo = (gpio_t)(HC_SR04_ARRAY_MAX + i);
+		sensors[i].group = i % o->groups;
+	}
+	opt = *o;
+	now_us = 0;
+	edges_qty = 0;
+	end_us = (int64_t)o->seconds * 1000000;
+	if(!HcSr04ArrayInit(&cfg)){
+		fprintf(stderr, "invalid configuration\n");
+		exit(1);
+	}
+	/* The scheduler runs inside HcSr04ArrayStart() until DelayUs() stops it */
+	HcSr04ArrayStart();
+	return HcSr04ArrayRate();
+}
+
+static void Usage(void){
+	fprintf(stderr, "usage: hc_sr04_rate [--sensors N] [--groups G] [--distance CM] [--guard US] "
+					"[--latency US] [--seconds S]\n");
+	exit(1);
+}
+/*==================[simulated platform]=====================================*/
+int64_t esp_timer_get_time(void){
+	return now_us;
+}
+
+void DelayUs(uint16_t usec){
+	now_us += usec;
+	if(now_us >= end_us){
+		HcSr04ArrayStop();
+	}
+}
+
+void GPIOInit(gpio_t pin, io_t io){}
+
+void GPIOOn(gpio_t pin){
+	for(uint8_t i = 0; i < opt.sensors; i++){
+		if(sensors[i].trigger == pin){
+			uint32_t rise = (uint32_t)(now_us + opt.latency_us);
+			AddEdge(rise, sensors[i].echo, true);
+			AddEdge(rise + (uint32_t)(opt.distance_cm * US_PER_CM), sensors[i].echo, false);
+		}
+	}
+}
+
+void GPIOOff(gpio_t pin){}
+
+void GPIOCaptureActiv(gpio_t pin, gpio_capture_edge_t edge){}
+
+uint16_t GPIOCaptureRead(gpio_capture_event_t *events, uint16_t max_events){
+	uint16_t n = 0;
+	while((n < edges_qty) && (n < max_events) && (edges[n].timestamp <= now_us)){
+		events[n] = edges[n];
+		n++;
+	}
+	memmove(edges, &edges[n], (edges_qty - n) * sizeof(edges[0]));
+	edges_qty -= n;
+	return n;
+}
+
+uint16_t GPIOCaptureDiscard(uint32_t pin_mask){
+	uint16_t kept = 0;
+	uint16_t n = 0;
+	for(uint16_t i = 0; (i < edges_qty) && (edges[i].timestamp <= now_us); i++){
+		n++;
+		if(!(pin_mask & (1UL << edges[i].pin))){
+			edges[kept++] = edges[i];
+		}
+	}
+	memmove(&edges[kept], &edges[n], (edges_qty - n) * sizeof(edges[0]));
+	edges_qty -= n - kept;
+	return n - kept;
+}
+
+uint16_t GPIOCaptureWait(uint16_t min_events, uint32_t timeout_ms){
+	int64_t ready = NthEdgeTime(min_events);
+	int64_t timeout = now_us + (int64_t)timeout_ms * 1000;
+	if(ready < 0 || ready > timeout){
+		ready = timeout;
+	}
+	if(ready > now_us){
+		now_us = ready;
+	}
+	return min_events;
+}
+
+int xTaskCreate(void (*task)(void *), const char *name, uint32_t stack, void *param, unsigned priority,
+				TaskHandle_t *handle){
+	*handle = (TaskHandle_t)task;
+	current_task = *handle;
+	task(param);
+	current_task = NULL;
+	return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task){}
+
+void vTaskDelay(uint32_t ticks){
+	now_us += (int64_t)ticks * 1000;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void){
+	return current_task;
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char **argv){
+	options_t o = {
+		.sensors = 8,
+		.groups = 8,
+		.distance_cm = 100,
+		.guard_us = 10000,
+		.latency_us = 500,
+		.seconds = 10,
+	};
+	if(argc == 1){
+		const uint16_t distances[] = {100, 300};
+		printf("guard %u us, trigger latency %u us, %u s simulated\n", o.guard_us, o.latency_us, o.seconds);
+		printf("%-8s %-22s %s\n", "target", "configuration", "measurements/s");
+		for(uint8_t d = 0; d < 2; d++){
+			o.distance_cm = distances[d];
+			o.sensors = 1; o.groups = 1;
+			printf("%4u cm  %-22s %u\n", o.distance_cm, "1 sensor", Run(&o));
+			o.sensors = 8; o.groups = 8;
+			printf("%4u cm  %-22s %u\n", o.distance_cm, "round-robin, 8 sensors", Run(&o));
+			o.groups = 2;
+			printf("%4u cm  %-22s %u\n", o.distance_cm, "2 groups of 4", Run(&o));
+		}
+		return 0;
+	}
+	for(int i = 1; i < argc; i += 2){
+		if(i + 1 >= argc) Usage();
+		const char *a = argv[i];
+		long v = atol(argv[i + 1]);
+		if(!strcmp(a, "--sensors")) o.sensors = v;
+		else if(!strcmp(a, "--groups")) o.groups = v;
+		else if(!strcmp(a, "--distance")) o.distance_cm = v;
+		else if(!strcmp(a, "--guard")) o.guard_us = v;
+		else if(!strcmp(a, "--latency")) o.latency_us = v;
+		else if(!strcmp(a, "--seconds")) o.seconds = v;
+		else Usage();
+	}
+	if((o.groups == 0) || (o.groups > o.sensors)){
+		Usage();
+	}
+	printf("%u measurements/s\n", Run(&o));
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,4 @@
+/* Host build of hc_sr04_rate: simulated time (see hc_sr04_rate.c) */
+#pragma once
+#include <stdint.h>
+int64_t esp_timer_get_time(void);
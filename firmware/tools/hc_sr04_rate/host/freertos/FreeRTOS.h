@@ -0,0 +1,12 @@
+/* Host build of hc_sr04_rate: single thread, no scheduler */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#define portTICK_PERIOD_MS				1
+#define pdPASS							1
+#define portMUX_INITIALIZER_UNLOCKED	0
+#define portENTER_CRITICAL(mux)			((void)(mux))
+#define portEXIT_CRITICAL(mux)			((void)(mux))
+typedef int portMUX_TYPE;
+typedef void *TaskHandle_t;
+#define pdMS_TO_TICKS(ms)				(ms)
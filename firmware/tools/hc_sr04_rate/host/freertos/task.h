@@ -0,0 +1,8 @@
+/* Host build of hc_sr04_rate: the task runs inside xTaskCreate() until it stops */
+#pragma once
+#include "freertos/FreeRTOS.h"
+int xTaskCreate(void (*task)(void *), const char *name, uint32_t stack, void *param, unsigned priority,
+				TaskHandle_t *handle);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(uint32_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
@@ -0,0 +1,26 @@
+#!/bin/sh
+# Builds ili9341_bus for the host with the ILI9341 driver source and a mock
+# SPI bus. host/ has the ESP-IDF headers the driver includes.
+# ILI9341_SRC selects another version of the driver, e.g. to compare with a
+# previous revision:
+#   git show REV:firmware/drivers/devices/src/ili9341.c > /tmp/ili9341_old.c
+#   ILI9341_SRC=/tmp/ili9341_old.c OUT=ili9341_bus_old ./build.sh
+# EXTRAS=0 leaves out the compressed image benchmark and the checks (for
+# revisions without ILI9341DrawImage() or the trace renderer).
+set -e
+cd "$(dirname "$0")"
+DRV=../../drivers
+SRC=${ILI9341_SRC:-$DRV/devices/src/ili9341.c}
+OUT=${OUT:-ili9341_bus}
+mkdir -p build
+EXTRA_SRCS=
+if [ "${EXTRAS:-1}" != 0 ]; then
+	# Compressed version of the ESP-EDU picture, made with the converter of the firmware
+	python3 ../ili9341_image.py $DRV/devices/src/esp_edu_pic.c --raw 240x320 -n esp_edu -o build/esp_edu_img.c
+	EXTRA_SRCS="-DBUS_EXTRAS $DRV/devices/src/esp_edu_pic.c build/esp_edu_img.c"
+fi
+${CC:-cc} -O2 -Ihost -I$DRV/devices/inc -I$DRV/microcontroller/inc -o build/$OUT ili9341_bus.c "$SRC" \
+	$DRV/devices/src/fonts.c \
+	$DRV/devices/src/icons.c \
+	$EXTRA_SRCS
+echo "build/$OUT"
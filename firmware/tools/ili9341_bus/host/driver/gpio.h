@@ -0,0 +1,6 @@
+/* Host build of ili9341_bus: gpio_set_level() is given by the mock bus */
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+typedef int gpio_num_t;
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
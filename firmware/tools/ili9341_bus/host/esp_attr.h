@@ -0,0 +1,5 @@
+/* Host build of ili9341_bus: no memory placement */
+#pragma once
+#define IRAM_ATTR
+#define DMA_ATTR
+#define WORD_ALIGNED_ATTR	__attribute__((aligned(4)))
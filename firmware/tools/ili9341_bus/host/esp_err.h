@@ -0,0 +1,7 @@
+/* Host build of ili9341_bus: the part of esp_err.h used by the LCD driver */
+#pragma once
+#include <stddef.h>
+typedef int esp_err_t;
+#define ESP_OK				0
+#define ESP_FAIL			-1
+#define ESP_ERR_TIMEOUT		0x107
@@ -0,0 +1,6 @@
+/* Host build of ili9341_bus: heap capabilities are ignored */
+#pragma once
+#include <stdlib.h>
+#define MALLOC_CAP_DMA		(1 << 3)
+#define heap_caps_malloc(size, caps)	malloc(size)
+#define heap_caps_free(ptr)				free(ptr)
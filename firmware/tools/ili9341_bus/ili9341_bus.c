@@ -0,0 +1,552 @@
+/**
+ * @file ili9341_bus.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host benchmark of the bytes the ILI9341 driver sends on the SPI bus
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+/*
+ * Runs the ILI9341 driver (the same source used by the firmware) on a mock
+ * SPI bus. The mock decodes the command stream (column and page address set,
+ * memory write) into a virtual frame memory and counts the bytes and
+ * transactions of each drawing operation. Transactions are decoded when the
+ * driver collects them (or before reading the frame memory), like a DMA that
+ * reads the buffers late, so buffers reused too early show up as wrong
+ * pixels. It also reports the host time of each operation (driver work only:
+ * the mock doesn't decode while timing) and a checksum of the frame memory
+ * after it, so two versions of the driver can be checked to draw the same
+ * pixels (see build.sh).
+ *
+ * The ESP-EDU picture (esp_edu_pic.c) is drawn as RGB565 with
+ * ILI9341DrawPicture() and compressed (build/esp_edu_img.c, made by
+ * ili9341_image.py) with ILI9341DrawImage(), with and without the
+ * framebuffer. The compressed one must match the picture on every pixel whose
+ * color is in its palette.
+ *
+ * Then it checks the trace renderer: the top and bottom values of several
+ * ranges (up to the whole int32_t range) must land on the first and last
+ * rows of the plot. And images with a palette over ILI9341_PALETTE_MAX must
+ * not be drawn, and indexes past the palette must draw its last color. The
+ * exit status is 1 if a check fails.
+ *
+ * Build (from this folder): ./build.sh
+ *
+ * Usage:
+ *   ili9341_bus
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ili9341.h"
+#include "gpio_mcu.h"
+#include "delay_mcu.h"
+#include "driver/spi_master.h"
+#include "driver/gpio.h"
+/*==================[macros and definitions]=================================*/
+#define MEM_COLUMNS		320		/*!< Frame memory, in the addresses of both orientations */
+#define MEM_PAGES		320
+#define QUEUE_MAX		64
+#define TIMING_LOOPS	200
+
+#define CMD_COLUMN_ADDR_SET	0x2A
+#define CMD_PAGE_ADDR_SET	0x2B
+#define CMD_MEM_WRITE		0x2C
+
+struct spi_device_t {
+	spi_device_interface_config_t cfg;
+	spi_transaction_t *queue[QUEUE_MAX];	/*!< Transactions not collected yet, oldest first */
+	uint16_t first;
+	uint16_t qty;
+	uint16_t sent;						/*!< Transactions of queue already decoded */
+};
+
+typedef struct {
+	const char *name;
+	void (*draw)(void);
+} operation_t;
+/*==================[internal data definition]===============================*/
+#ifdef BUS_EXTRAS
+extern const uint8_t picture[];			/*!< esp_edu_pic.c */
+extern const ili9341_image_t esp_edu;	/*!< build/esp_edu_img.c */
+static uint16_t mem_picture[MEM_PAGES][MEM_COLUMNS];
+#endif
+static struct spi_device_t device;
+static bool device_used = false;
+static uint32_t dc_level;
+static uint16_t mem[MEM_PAGES][MEM_COLUMNS];	/*!< Frame memory (decoded) */
+static uint8_t cmd;								/*!< Last command */
+static uint8_t params[4];
+static uint32_t param_qty;
+static uint16_t col[2], page[2];				/*!< Address window */
+static uint16_t mem_x, mem_y;					/*!< Next pixel of a memory write */
+static uint8_t pixel_high;
+static bool pixel_half = false;
+static uint64_t bus_bytes;
+static uint64_t bus_trans;
+static bool decode = true;						/*!< Decode the transactions into mem */
+/*==================[internal functions definition]==========================*/
+static double Now(void){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static void DecodeByte(bool data, uint8_t byte){
+	if(!data){
+		cmd = byte;
+		param_qty = 0;
+		if(cmd == CMD_MEM_WRITE){
+			mem_x = col[0];
+			mem_y = page[0];
+			pixel_half = false;
+		}
+		return;
+	}
+	switch(cmd){
+		case CMD_COLUMN_ADDR_SET:
+		case CMD_PAGE_ADDR_SET:
+			if(param_qty < 4){
+				params[param_qty++] = byte;
+			}
+			if(param_qty == 4){
+				uint16_t *range = (cmd == CMD_COLUMN_ADDR_SET) ? col : page;
+				range[0] = (params[0] << 8) | params[1];
+				range[1] = (params[2] << 8) | params[3];
+			}
+		break;
+		case CMD_MEM_WRITE:
+			if(!pixel_half){
+				pixel_high = byte;
+				pixel_half = true;
+				break;
+			}
+			pixel_half = false;
+			if((mem_y < MEM_PAGES) && (mem_x < MEM_COLUMNS)){
+				mem[mem_y][mem_x] = (pixel_high << 8) | byte;
+			}
+			if(++mem_x > col[1]){
+				mem_x = col[0];
+				mem_y++;
+			}
+		break;
+		default:
+		break;
+	}
+}
+
+/**
+ * @brief Sends a queued transaction (decodes it into the frame memory)
+ */
+static void Send(spi_device_handle_t handle){
+	spi_transaction_t *t = handle->queue[(handle->first + handle->sent) % QUEUE_MAX];
+	const uint8_t *data = (t->flags & SPI_TRANS_USE_TXDATA) ? t->tx_data : t->tx_buffer;
+	if(handle->cfg.pre_cb != NULL){
+		handle->cfg.pre_cb(t);
+	}
+	for(uint32_t i = 0; decode && (i < t->length / 8); i++){
+		DecodeByte(dc_level, data[i]);
+	}
+	handle->sent++;
+}
+
+/**
+ * @brief Sends every queued transaction
+ */
+static void Drain(void){
+	while(device.sent < device.qty){
+		Send(&device);
+	}
+}
+
+static uint32_t MemChecksum(void){
+	uint32_t h = 2166136261u;
+	Drain();
+	for(uint16_t y = 0; y < MEM_PAGES; y++){
+		for(uint16_t x = 0; x < MEM_COLUMNS; x++){
+			h = (h ^ mem[y][x]) * 16777619u;
+		}
+	}
+	return h;
+}
+
+static void DrawLine45(void){
+	ILI9341DrawLine(10, 10, 109, 109, ILI9341_RED);
+}
+
+static void DrawLine200x37(void){
+	ILI9341DrawLine(20, 40, 219, 76, ILI9341_BLUE);
+}
+
+static void DrawLine13x150(void){
+	ILI9341DrawLine(100, 20, 112, 169, ILI9341_DARKGREEN);
+}
+
+static void DrawCircle50(void){
+	ILI9341DrawCircle(120, 160, 50, ILI9341_MAGENTA);
+}
+
+static void DrawCircle10(void){
+	ILI9341DrawCircle(60, 60, 10, ILI9341_NAVY);
+}
+
+static void DrawFilledCircle50(void){
+	ILI9341DrawFilledCircle(120, 160, 50, ILI9341_ORANGE);
+}
+
+static void DrawFilledCircle10(void){
+	ILI9341DrawFilledCircle(180, 60, 10, ILI9341_PURPLE);
+}
+
+static void DrawTriangle(void){
+	ILI9341DrawTriangle(20, 300, 120, 30, 220, 250, ILI9341_BLACK);
+}
+
+static const operation_t operations[] = {
+	{"line 45deg 100 px", DrawLine45},
+	{"line 200x37", DrawLine200x37},
+	{"line 13x150", DrawLine13x150},
+	{"circle r=50", DrawCircle50},
+	{"circle r=10", DrawCircle10},
+	{"filled circle r=50", DrawFilledCircle50},
+	{"filled circle r=10", DrawFilledCircle10},
+	{"triangle outline", DrawTriangle},
+};
+
+/**
+ * @brief Bytes and transactions of an operation, then time per call
+ */
+static void Run(const operation_t *op){
+	uint64_t bytes, trans;
+	double start;
+	bus_bytes = 0;
+	bus_trans = 0;
+	op->draw();
+	bytes = bus_bytes;
+	trans = bus_trans;
+	printf("  %-22s %7llu bytes %5llu transactions  checksum %08x", op->name,
+		   (unsigned long long)bytes, (unsigned long long)trans, MemChecksum());
+	decode = false;
+	start = Now();
+	for(uint32_t i = 0; i < TIMING_LOOPS; i++){
+		op->draw();
+	}
+	Drain();
+	printf("  %8.2f us\n", (Now() - start) / TIMING_LOOPS / 1000);
+	decode = true;
+}
+#ifdef BUS_EXTRAS
+static bool TracePixel(const ili9341_trace_config_t *cfg, uint16_t column, uint16_t row, bool lit){
+	uint16_t color = mem[cfg->y + row][cfg->x + column];
+	if((color == cfg->colors[0]) != lit){
+		printf("  range %d..%d: column %u row %u is %s\n", cfg->min, cfg->max, column, row, lit ? "off" : "on");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Rows of the top, bottom and middle values of several ranges
+ */
+static bool TraceCheck(void){
+	const int32_t ranges[][2] = {
+		{-100, 100},
+		{0, 20000000},				/* (height - 1) << 16 / range was 0 above ~15.6M */
+		{-1000000000, 1000000000},
+		{INT32_MIN, INT32_MAX},
+	};
+	ili9341_trace_config_t cfg = {
+		.x = 40, .width = 200, .y = 20, .height = 200, .decimation = 1, .traces = 1,
+		.colors = {ILI9341_RED}, .background = ILI9341_BLACK,
+	};
+	uint16_t last = cfg.height - 1;
+	bool ok = true;
+	ILI9341Rotate(ILI9341_Landscape_1);
+	for(uint8_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++){
+		int32_t mid;
+		cfg.min = ranges[i][0];
+		cfg.max = ranges[i][1];
+		mid = cfg.min + (int32_t)(((int64_t)cfg.max - cfg.min) / 2);
+		if(!ILI9341TraceInit(&cfg)){
+			printf("  range %d..%d: ILI9341TraceInit failed\n", cfg.min, cfg.max);
+			return false;
+		}
+		ILI9341TraceAdd(&cfg.max);
+		ILI9341TraceAdd(&cfg.min);
+		ILI9341TraceAdd(&mid);
+		Drain();
+		/* Each column is joined to the previous one */
+		ok &= TracePixel(&cfg, 0, 0, true) && TracePixel(&cfg, 0, 1, false) && TracePixel(&cfg, 0, last, false);
+		ok &= TracePixel(&cfg, 1, 0, true) && TracePixel(&cfg, 1, last, true);
+		ok &= TracePixel(&cfg, 2, last / 2 - 1, false) && TracePixel(&cfg, 2, last / 2 + 1, true) &&
+			  TracePixel(&cfg, 2, last, true);
+		ILI9341TraceStop();
+	}
+	ILI9341Rotate(ILI9341_Portrait_1);
+	return ok;
+}
+static void DrawPicture(void){
+	ILI9341DrawPicture(0, 0, 240, 320, picture);
+}
+
+static void DrawImage(void){
+	ILI9341DrawImage(0, 0, &esp_edu);
+}
+
+static void DrawImageFramebuffer(void){
+	ILI9341DrawImage(0, 0, &esp_edu);
+	ILI9341Flush();
+}
+
+static const operation_t images[] = {
+	{"picture (RGB565)", DrawPicture},
+	{"image (palette + RLE)", DrawImage},
+	{"image, framebuffer", DrawImageFramebuffer},
+};
+
+/**
+ * @brief Pixels of the image that differ from the picture (only allowed if the color isn't in the palette)
+ */
+static bool ImageCompare(uint32_t *changed){
+	*changed = 0;
+	Drain();
+	for(uint16_t y = 0; y < 320; y++){
+		for(uint16_t x = 0; x < 240; x++){
+			uint16_t color = mem_picture[y][x];
+			bool in_palette = false;
+			if(mem[y][x] == color){
+				continue;
+			}
+			for(uint16_t i = 0; i < esp_edu.palette_size; i++){
+				in_palette |= (esp_edu.palette[i] == color);
+			}
+			if(in_palette){
+				printf("  pixel %u,%u: %04x instead of %04x\n", x, y, mem[y][x], color);
+				return false;
+			}
+			(*changed)++;
+		}
+	}
+	return true;
+}
+
+static bool ImageBench(void){
+	uint32_t changed;
+	bool ok = true;
+	Run(&images[0]);
+	Drain();
+	memcpy(mem_picture, mem, sizeof(mem));
+	memset(mem, 0, sizeof(mem));
+	Run(&images[1]);
+	ok &= ImageCompare(&changed);
+	printf("  %u pixels changed by the palette reduction\n", changed);
+	if(!ILI9341FramebufferInit(0, 320)){
+		printf("  ILI9341FramebufferInit failed\n");
+		return false;
+	}
+	memset(mem, 0, sizeof(mem));
+	Run(&images[2]);
+	ILI9341FramebufferDeInit();
+	ok &= ImageCompare(&changed);
+	printf("  %u pixels changed by the palette reduction\n", changed);
+	return ok;
+}
+
+/**
+ * @brief Palettes out of range, indexes past the palette, data shorter than the image and too wide images
+ */
+static bool ImageCheck(void){
+	static const uint16_t colors[ILI9341_PALETTE_MAX + 1] = {ILI9341_RED, ILI9341_BLUE};
+	/* 4 literal pixels: indexes 0, 1, 2 and 255 */
+	static const uint8_t data[] = {0x03, 0, 1, 2, 255};
+	ili9341_image_t image = {.width = 4, .height = 1, .palette = colors, .data = data, .data_size = sizeof(data)};
+	const uint16_t expected[] = {ILI9341_RED, ILI9341_BLUE, ILI9341_BLUE, ILI9341_BLUE};
+	bool ok = true;
+
+	image.palette_size = ILI9341_PALETTE_MAX + 1;
+	bus_bytes = 0;
+	ILI9341DrawImage(0, 0, &image);
+	if(bus_bytes != 0){
+		printf("  palette of %u colors: %llu bytes sent\n", image.palette_size, (unsigned long long)bus_bytes);
+		ok = false;
+	}
+	image.palette_size = 0;
+	ILI9341DrawImage(0, 0, &image);
+	if(bus_bytes != 0){
+		printf("  empty palette: %llu bytes sent\n", (unsigned long long)bus_bytes);
+		ok = false;
+	}
+	image.palette_size = 2;
+	ILI9341DrawImage(10, 10, &image);
+	Drain();
+	for(uint8_t i = 0; i < 4; i++){
+		if(mem[10][10 + i] != expected[i]){
+			printf("  index %u of a 2 colors palette: %04x\n", data[1 + i], mem[10][10 + i]);
+			ok = false;
+		}
+	}
+	/* The literal packet is cut after index 1: pixels 2 and 3 get the first color */
+	image.data_size = 3;
+	ILI9341DrawImage(10, 20, &image);
+	Drain();
+	for(uint8_t i = 0; i < 4; i++){
+		uint16_t color = (i == 1) ? ILI9341_BLUE : ILI9341_RED;
+		if(mem[20][10 + i] != color){
+			printf("  pixel %u of an image cut after 3 bytes: %04x\n", i, mem[20][10 + i]);
+			ok = false;
+		}
+	}
+	image.data_size = sizeof(data);
+	image.width = 2047;
+	bus_bytes = 0;
+	ILI9341DrawImage(0, 0, &image);
+	if(bus_bytes != 0){
+		printf("  image of %u pixels width: %llu bytes sent\n", image.width, (unsigned long long)bus_bytes);
+		ok = false;
+	}
+	return ok;
+}
+
+/**
+ * @brief Numbers past the right edge and characters out of the font range
+ */
+static bool TextCheck(void){
+	uint32_t expected;
+	bool ok = true;
+
+	/* 8 digits of 11 pixels from x = 200: only 3 fit in the 240 pixels width */
+	ILI9341DrawInt(200, 0, 12345678, 8, &font_22, ILI9341_WHITE, ILI9341_BLACK);
+	Drain();
+	if(col[1] >= ILI9341_WIDTH){
+		printf("  number past the right edge: window up to column %u\n", col[1]);
+		ok = false;
+	}
+	ILI9341DrawString(0, 100, "A ", &font_22, ILI9341_WHITE, ILI9341_BLACK);
+	expected = MemChecksum();
+	ILI9341DrawString(0, 100, "A\x80", &font_22, ILI9341_RED, ILI9341_BLACK);
+	ILI9341DrawString(0, 100, "A\x80", &font_22, ILI9341_WHITE, ILI9341_BLACK);
+	if(MemChecksum() != expected){
+		printf("  character out of the font range not drawn as a space\n");
+		ok = false;
+	}
+	return ok;
+}
+#endif
+/*==================[mock platform]==========================================*/
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level){
+	dc_level = level;
+	return ESP_OK;
+}
+
+void GPIOInit(gpio_t pin, io_t io){}
+
+void GPIOOn(gpio_t pin){}
+
+void GPIOOff(gpio_t pin){}
+
+void DelayUs(uint16_t usec){}
+
+void DelayMs(uint16_t msec){}
+
+void SpiBusInit(void){}
+
+gpio_t SpiGetCsPin(spi_dev_t dev){
+	return GPIO_0;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config,
+							 spi_device_handle_t *handle){
+	if(device_used || (dev_config->queue_size > QUEUE_MAX)){
+		return ESP_FAIL;
+	}
+	memset(&device, 0, sizeof(device));
+	device.cfg = *dev_config;
+	device_used = true;
+	*handle = &device;
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle){
+	device_used = false;
+	return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *t, TickType_t ticks_to_wait){
+	if(handle->qty >= handle->cfg.queue_size){
+		/* The driver would block forever: nothing else collects the results */
+		fprintf(stderr, "transaction queue overflow\n");
+		exit(1);
+	}
+	handle->queue[(handle->first + handle->qty) % QUEUE_MAX] = t;
+	handle->qty++;
+	bus_bytes += t->length / 8;
+	bus_trans++;
+	return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **t, TickType_t ticks_to_wait){
+	if(handle->qty == 0){
+		fprintf(stderr, "waiting for a transaction that was never queued\n");
+		exit(1);
+	}
+	if(handle->sent == 0){
+		Send(handle);
+	}
+	*t = handle->queue[handle->first];
+	handle->first = (handle->first + 1) % QUEUE_MAX;
+	handle->qty--;
+	handle->sent--;
+	return ESP_OK;
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char **argv){
+	bool ok;
+	if(argc > 1){
+		fprintf(stderr, "usage: ili9341_bus\n");
+		return 1;
+	}
+	if(!ILI9341Init(SPI_1, GPIO_3, GPIO_9)){
+		fprintf(stderr, "ILI9341Init failed\n");
+		return 1;
+	}
+	printf("bytes and transactions on the bus, host time per call\n");
+	for(uint8_t i = 0; i < sizeof(operations) / sizeof(operations[0]); i++){
+		Run(&operations[i]);
+	}
+	ok = true;
+#ifdef BUS_EXTRAS
+	printf("ESP-EDU picture, 240x320\n");
+	ok &= ImageBench();
+	printf("image palette\n");
+	if(ImageCheck()){
+		printf("  ok\n");
+	} else{
+		ok = false;
+	}
+	printf("text clipping\n");
+	if(TextCheck()){
+		printf("  ok\n");
+	} else{
+		ok = false;
+	}
+	printf("trace renderer\n");
+	if(TraceCheck()){
+		printf("  ok\n");
+	} else{
+		ok = false;
+	}
+#endif
+	ILI9341DeInit();
+	if(!ok){
+		printf("FAILED\n");
+		return 1;
+	}
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+"""Converts images to the compressed format of the ILI9341 driver.
+
+Pixels are converted to RGB565 and replaced by indexes to a palette of up to
+256 colors (in images with more colors, the least used ones are replaced by
+the closest of the 256 most used). Indexes are stored as run length packets, see
+ili9341_image_t in ili9341.h.
+
+Inputs:
+  - PNG files (8 bits per channel gray, RGB, palette; with or without alpha,
+    which is blended over --background).
+  - C arrays of RGB565 pixels, 2 bytes per pixel high byte first (as used by
+    ILI9341DrawPicture()), with --raw WIDTHxHEIGHT.
+
+Usage:
+  ili9341_image.py logo.png -n logo -o logo.c
+  ili9341_image.py esp_edu_pic.c --raw 240x320 -n esp_edu -o esp_edu_img.c
+
+Only the Python standard library is needed.
+"""
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+MAX_COLORS = 256
+MAX_PACKET = 128
+MIN_RUN = 3         # shorter runs are cheaper inside literal packets
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path, background):
+    """Returns (width, height, list of (r, g, b) rows)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        sys.exit('%s: not a PNG file' % path)
+    pos = 8
+    idat = b''
+    palette = []
+    trns = b''
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE':
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b'tRNS':
+            trns = chunk
+        elif kind == b'IDAT':
+            idat += chunk
+        elif kind == b'IEND':
+            break
+    if depth != 8 or interlace:
+        sys.exit('%s: only 8 bits per channel, non interlaced PNG files are supported' % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    stride = width * channels
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        filt = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if filt == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filt == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filt == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif filt == 4:
+                line[i] = (line[i] + paeth(a, b, c)) & 0xFF
+        prev = line
+        row = []
+        for x in range(width):
+            px = line[x * channels:(x + 1) * channels]
+            alpha = 255
+            if color == 0:
+                rgb = (px[0],) * 3
+            elif color == 2:
+                rgb = tuple(px)
+            elif color == 3:
+                rgb = palette[px[0]]
+                if px[0] < len(trns):
+                    alpha = trns[px[0]]
+            elif color == 4:
+                rgb, alpha = (px[0],) * 3, px[1]
+            else:
+                rgb, alpha = tuple(px[:3]), px[3]
+            if alpha < 255:
+                rgb = tuple((v * alpha + bg * (255 - alpha)) // 255 for v, bg in zip(rgb, background))
+            row.append(rgb)
+        rows.append(row)
+    return width, height, rows
+
+
+def read_raw(path, size):
+    """C array (or binary file) of RGB565 pixels, high byte first."""
+    width, height = (int(v) for v in size.lower().split('x'))
+    with open(path, 'rb') as f:
+        data = f.read()
+    if path.endswith(('.c', '.h')):
+        data = bytes(int(v, 16) for v in re.findall(rb'0x([0-9a-fA-F]{1,2})\b', data))
+    if len(data) < width * height * 2:
+        sys.exit('%s: %d bytes, %dx%d needs %d' % (path, len(data), width, height, width * height * 2))
+    pixels = [data[i] << 8 | data[i + 1] for i in range(0, width * height * 2, 2)]
+    return width, height, pixels
+
+
+def rgb565(rgb):
+    r, g, b = rgb
+    return (r >> 3) << 11 | (g >> 2) << 5 | b >> 3
+
+
+def unpack565(color):
+    """RGB565 to 8 bits per channel."""
+    return (color >> 11) << 3, ((color >> 5) & 0x3F) << 2, (color & 0x1F) << 3
+
+
+def reduce_colors(pixels):
+    """Keeps the most used colors, the rest are replaced by the closest one."""
+    count = {}
+    for p in pixels:
+        count[p] = count.get(p, 0) + 1
+    if len(count) <= MAX_COLORS:
+        return pixels
+    kept = sorted(count, key=lambda c: -count[c])[:MAX_COLORS]
+    closest = {}
+    for color in count:
+        r, g, b = unpack565(color)
+        closest[color] = min(kept, key=lambda k: sum((u - v) ** 2 for u, v in zip(unpack565(k), (r, g, b))))
+    print('warning: %d colors, reduced to the %d most used' % (len(count), MAX_COLORS), file=sys.stderr)
+    return [closest[p] for p in pixels]
+
+
+def encode(indexes):
+    """Run length packets (see ili9341_image_t)."""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_PACKET]
+            del literal[:MAX_PACKET]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+
+    i = 0
+    while i < len(indexes):
+        run = 1
+        while i + run < len(indexes) and indexes[i + run] == indexes[i] and run < MAX_PACKET:
+            run += 1
+        if run >= MIN_RUN:
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.append(indexes[i])
+        else:
+            literal.extend(indexes[i:i + run])
+        i += run
+    flush_literal()
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Converts an image to a compressed ili9341_image_t.')
+    parser.add_argument('input', help='PNG file, or RGB565 C array/binary file with --raw')
+    parser.add_argument('-n', '--name', required=True, help='name of the ili9341_image_t variable')
+    parser.add_argument('-o', '--output', help='C file to write (default: stdout)')
+    parser.add_argument('--raw', metavar='WIDTHxHEIGHT', help='input is RGB565, high byte first')
+    parser.add_argument('--background', default='000000', help='RGB color under transparent pixels (hex)')
+    args = parser.parse_args()
+
+    if args.raw:
+        width, height, pixels = read_raw(args.input, args.raw)
+    else:
+        background = tuple(int(args.background[i:i + 2], 16) for i in (0, 2, 4))
+        width, height, rows = read_png(args.input, background)
+        pixels = [rgb565(px) for row in rows for px in row]
+    pixels = reduce_colors(pixels)
+    palette = sorted(set(pixels))
+    lookup = {color: i for i, color in enumerate(palette)}
+    data = encode([lookup[p] for p in pixels])
+
+    lines = ['/* Generated by ili9341_image.py from %s: %dx%d pixels, %d colors,' % (
+                 args.input.replace('\\', '/').split('/')[-1], width, height, len(palette)),
+             ' * %d bytes (%d bytes as RGB565) */' % (len(data) + 2 * len(palette), width * height * 2),
+             '#include "ili9341.h"',
+             '',
+             'static const uint16_t %s_palette[] = {' % args.name]
+    for i in range(0, len(palette), 12):
+        lines.append('\t' + ', '.join('0x%04X' % c for c in palette[i:i + 12]) + ',')
+    lines += ['};', '', 'static const uint8_t %s_data[] = {' % args.name]
+    for i in range(0, len(data), 16):
+        lines.append('\t' + ', '.join('0x%02X' % b for b in data[i:i + 16]) + ',')
+    lines += ['};', '',
+              'const ili9341_image_t %s = {' % args.name,
+              '\t.width = %d,' % width,
+              '\t.height = %d,' % height,
+              '\t.palette_size = %d,' % len(palette),
+              '\t.palette = %s_palette,' % args.name,
+              '\t.data = %s_data,' % args.name,
+              '\t.data_size = sizeof(%s_data),' % args.name,
+              '};', '']
+    text = '\n'.join(lines)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    print('%s: %dx%d, %d colors, %d bytes (RGB565: %d bytes)' % (
+        args.name, width, height, len(palette), len(data) + 2 * len(palette), width * height * 2),
+        file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
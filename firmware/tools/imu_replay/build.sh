@@ -0,0 +1,30 @@
+#!/bin/sh
+# Builds imu_replay for the host, with the ANSI C versions of the esp-dsp
+# functions used by the EKF. host/ has the few ESP-IDF headers they include.
+set -e
+cd "$(dirname "$0")"
+MW=../../middelware/signal_processing
+DSP=$MW/esp-dsp/modules
+INC="-Ihost -I$MW/inc $(find $DSP -type d -name include ! -path '*/test/*' | sed 's/^/-I/' | tr '\n' ' ')"
+CFLAGS="-O2"
+mkdir -p build
+for src in \
+	$DSP/matrix/mul/float/dspm_mult_f32_ansi.c \
+	$DSP/matrix/mul/float/dspm_mult_ex_f32_ansi.c \
+	$DSP/matrix/add/float/dspm_add_f32_ansi.c \
+	$DSP/matrix/addc/float/dspm_addc_f32_ansi.c \
+	$DSP/matrix/mulc/float/dspm_mulc_f32_ansi.c \
+	$DSP/matrix/sub/float/dspm_sub_f32_ansi.c \
+	$DSP/math/add/float/dsps_add_f32_ansi.c \
+	$DSP/math/addc/float/dsps_addc_f32_ansi.c \
+	$DSP/math/mulc/float/dsps_mulc_f32_ansi.c \
+	$DSP/math/sub/float/dsps_sub_f32_ansi.c; do
+	${CC:-cc} $CFLAGS $INC -c "$src" -o "build/$(basename "$src" .c).o"
+done
+${CXX:-c++} $CFLAGS $INC -o build/imu_replay imu_replay.cpp \
+	$MW/src/imu_fusion.cpp \
+	$DSP/matrix/mat/mat.cpp \
+	$DSP/kalman/ekf/common/ekf.cpp \
+	$DSP/kalman/ekf_imu13states/ekf_imu13states.cpp \
+	build/*.o -lm
+echo "build/imu_replay"
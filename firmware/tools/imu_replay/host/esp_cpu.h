@@ -0,0 +1,3 @@
+/* Host build of imu_replay: no cycle counter */
+#pragma once
+#define esp_cpu_get_cycle_count()	0
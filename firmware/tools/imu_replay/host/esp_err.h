@@ -0,0 +1,7 @@
+/* Host build of imu_replay: the part of esp_err.h used by esp-dsp */
+#pragma once
+#include <stddef.h>
+#include <stdlib.h>
+typedef int esp_err_t;
+#define ESP_OK		0
+#define ESP_FAIL	-1
@@ -0,0 +1,8 @@
+/* Host build of imu_replay: logs go to stderr */
+#pragma once
+#include <stdio.h>
+#define ESP_LOGE(tag, fmt, ...)	fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)	fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...)
+#define ESP_LOGD(tag, fmt, ...)
+#define ESP_LOGV(tag, fmt, ...)
@@ -0,0 +1,2 @@
+/* Host build of imu_replay: no target, ANSI C versions of esp-dsp */
+#pragma once
@@ -0,0 +1,277 @@
+/**
+ * @file imu_replay.cpp
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host replay of IMU logs through imu_fusion
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Feeds a recorded log of MPU6050 raw samples to the same imu_fusion and
+ * esp-dsp sources used by the firmware (ANSI C versions) and reports the
+ * processing rate, the time spent on each sample, and the final attitude.
+ *
+ * Log: one sample per line, "timestamp_us,ax,ay,az,gx,gy,gz" (raw counts,
+ * as delivered by MPU6050FifoRead()). Lines that don't start with a number
+ * (headers, comments) are skipped.
+ *
+ * Without a log (--synth SECONDS) a rotating sensor with a gyroscope bias is
+ * simulated, and the tilt error against the true attitude is reported too.
+ *
+ * Build (from this folder): ./build.sh
+ *
+ * Usage:
+ *   imu_replay log.csv [--rate 500] [--div 5] [--accel-fs 0] [--gyro-fs 0] [--gate 0.1] [-o attitude.csv]
+ *   imu_replay --synth 60 [--rate 1000] [--div 10]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "imu_fusion.h"
+/*==================[macros and definitions]=================================*/
+typedef struct {
+	uint32_t timestamp;
+	int16_t accel[3];
+	int16_t gyro[3];
+	float tilt[3];		/*!< True gravity direction (synthetic logs) */
+} record_t;
+
+typedef struct {
+	const char *log;
+	const char *output;
+	float synth_s;
+	imu_fusion_config_t fusion;
+} options_t;
+/*==================[internal functions definition]==========================*/
+static void Usage(void){
+	fprintf(stderr, "usage: imu_replay LOG.csv|--synth SECONDS [--rate HZ] [--div N] [--accel-fs 0-3] "
+					"[--gyro-fs 0-3] [--noise R] [--gate G] [-o ATTITUDE.csv]\n");
+	exit(1);
+}
+
+static bool ParseArgs(int argc, char **argv, options_t *opt){
+	memset(opt, 0, sizeof(*opt));
+	opt->fusion.rate_hz = 1000;
+	opt->fusion.update_divider = 10;
+	for(int i = 1; i < argc; i++){
+		const char *a = argv[i];
+		const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+		if(a[0] != '-'){
+			opt->log = a;
+			continue;
+		}
+		if(v == NULL){
+			return false;
+		}
+		if(!strcmp(a, "--synth")) opt->synth_s = atof(v);
+		else if(!strcmp(a, "--rate")) opt->fusion.rate_hz = atoi(v);
+		else if(!strcmp(a, "--div")) opt->fusion.update_divider = atoi(v);
+		else if(!strcmp(a, "--accel-fs")) opt->fusion.accel_range = atoi(v);
+		else if(!strcmp(a, "--gyro-fs")) opt->fusion.gyro_range = atoi(v);
+		else if(!strcmp(a, "--noise")) opt->fusion.accel_noise = atof(v);
+		else if(!strcmp(a, "--gate")) opt->fusion.accel_gate = atof(v);
+		else if(!strcmp(a, "-o")) opt->output = v;
+		else return false;
+		i++;
+	}
+	return (opt->log != NULL) != (opt->synth_s > 0);
+}
+
+static bool ReadLog(const char *path, std::vector<record_t> &log){
+	FILE *f = fopen(path, "r");
+	char line[256];
+	if(f == NULL){
+		perror(path);
+		return false;
+	}
+	while(fgets(line, sizeof(line), f) != NULL){
+		record_t r = {};
+		long v[7];
+		if(sscanf(line, "%ld,%ld,%ld,%ld,%ld,%ld,%ld", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6]) != 7){
+			continue;
+		}
+		r.timestamp = (uint32_t)v[0];
+		for(int i = 0; i < 3; i++){
+			r.accel[i] = (int16_t)v[1 + i];
+			r.gyro[i] = (int16_t)v[4 + i];
+		}
+		r.tilt[0] = NAN;
+		log.push_back(r);
+	}
+	fclose(f);
+	return true;
+}
+
+static int16_t Counts(float value, float per_unit){
+	float c = roundf(value * per_unit);
+	return (int16_t)std::max(-32768.0f, std::min(32767.0f, c));
+}
+
+/**
+ * @brief Sensor turning around the three axes (with pauses) with a constant gyroscope bias
+ */
+static void Synthesize(const options_t *opt, std::vector<record_t> &log){
+	const float accel_lsb = 16384.0f / (1 << opt->fusion.accel_range);		/* counts per g */
+	const float gyro_lsb = 131.0f / (1 << opt->fusion.gyro_range) * 180.0f / (float)M_PI;	/* counts per rad/s */
+	const float bias[3] = {0.02f, -0.015f, 0.01f};
+	uint32_t n = (uint32_t)(opt->synth_s * opt->fusion.rate_hz);
+	double dt = 1.0 / opt->fusion.rate_hz;
+	double q[4] = {1, 0, 0, 0};
+	unsigned seed = 1;
+
+	for(uint32_t k = 0; k < n; k++){
+		double t = k * dt;
+		double w[3] = {0, 0, 0};
+		record_t r;
+		/* 4 s moving, 2 s still */
+		if(fmod(t, 6.0) < 4.0){
+			w[0] = 0.8 * sin(2 * M_PI * 0.25 * t);
+			w[1] = 0.6 * sin(2 * M_PI * 0.4 * t + 1);
+			w[2] = 0.5 * cos(2 * M_PI * 0.3 * t);
+		}
+		/* Gravity in the sensor frame: R' * (0, 0, 1) */
+		r.tilt[0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+		r.tilt[1] = 2 * (q[2] * q[3] + q[0] * q[1]);
+		r.tilt[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+		r.timestamp = (uint32_t)(t * 1e6);
+		for(int i = 0; i < 3; i++){
+			float noise = ((rand_r(&seed) / (float)RAND_MAX) - 0.5f) * 0.01f;
+			r.accel[i] = Counts(r.tilt[i] + noise, accel_lsb);
+			r.gyro[i] = Counts(w[i] + bias[i] + noise, gyro_lsb);
+		}
+		log.push_back(r);
+
+		/* qdot = 0.5 * q x (0, w) */
+		double dq[4] = {
+			-q[1] * w[0] - q[2] * w[1] - q[3] * w[2],
+			 q[0] * w[0] + q[2] * w[2] - q[3] * w[1],
+			 q[0] * w[1] - q[1] * w[2] + q[3] * w[0],
+			 q[0] * w[2] + q[1] * w[1] - q[2] * w[0],
+		};
+		double norm = 0;
+		for(int i = 0; i < 4; i++){
+			q[i] += 0.5 * dq[i] * dt;
+			norm += q[i] * q[i];
+		}
+		for(int i = 0; i < 4; i++){
+			q[i] /= sqrt(norm);
+		}
+	}
+}
+
+/**
+ * @brief Angle (deg) between the estimated and the true gravity directions
+ */
+static float TiltError(const float q[4], const float tilt[3]){
+	float g[3] = {
+		2 * (q[1] * q[3] - q[0] * q[2]),
+		2 * (q[2] * q[3] + q[0] * q[1]),
+		q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3],
+	};
+	float dot = g[0] * tilt[0] + g[1] * tilt[1] + g[2] * tilt[2];
+	return acosf(std::max(-1.0f, std::min(1.0f, dot))) * 180.0f / (float)M_PI;
+}
+
+static void Percentiles(const char *name, std::vector<float> &t){
+	if(t.empty()){
+		return;
+	}
+	std::sort(t.begin(), t.end());
+	double sum = 0;
+	for(float v : t){
+		sum += v;
+	}
+	printf("  %-18s %8zu samples  mean %7.2f us  p50 %7.2f us  p99 %7.2f us  max %7.2f us\n", name, t.size(),
+		   sum / t.size(), t[t.size() / 2], t[t.size() * 99 / 100], t.back());
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char **argv){
+	options_t opt;
+	std::vector<record_t> log;
+	std::vector<float> predict_us, update_us;
+	imu_fusion_attitude_t att;
+	uint32_t updates = 0;
+	double total_us = 0, tilt_sum = 0, tilt_max = 0;
+	uint32_t tilt_n = 0;
+	FILE *out = NULL;
+
+	if(!ParseArgs(argc, argv, &opt)){
+		Usage();
+	}
+	if(opt.log != NULL){
+		if(!ReadLog(opt.log, log)){
+			return 1;
+		}
+	} else {
+		Synthesize(&opt, log);
+	}
+	if(log.size() < 2){
+		fprintf(stderr, "not enough samples\n");
+		return 1;
+	}
+	if(!ImuFusionInit(&opt.fusion)){
+		fprintf(stderr, "invalid configuration\n");
+		return 1;
+	}
+	if(opt.output != NULL){
+		out = fopen(opt.output, "w");
+		if(out == NULL){
+			perror(opt.output);
+			return 1;
+		}
+		fprintf(out, "timestamp_us,qw,qx,qy,qz,updated\n");
+	}
+
+	predict_us.reserve(log.size());
+	for(size_t k = 0; k < log.size(); k++){
+		const record_t &r = log[k];
+		auto start = std::chrono::steady_clock::now();
+		ImuFusionProcess(r.accel, r.gyro, r.timestamp, &att);
+		float us = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+		total_us += us;
+		if(att.updated){
+			updates++;
+			update_us.push_back(us);
+		} else {
+			predict_us.push_back(us);
+		}
+		if(out != NULL){
+			fprintf(out, "%u,%.6f,%.6f,%.6f,%.6f,%d\n", att.timestamp, att.q[0], att.q[1], att.q[2], att.q[3], att.updated);
+		}
+		/* Tilt error after the first second (convergence) */
+		if(!std::isnan(r.tilt[0]) && (r.timestamp >= 1000000)){
+			float e = TiltError(att.q, r.tilt);
+			tilt_sum += e;
+			tilt_max = std::max(tilt_max, (double)e);
+			tilt_n++;
+		}
+	}
+	if(out != NULL){
+		fclose(out);
+	}
+
+	float bias[3];
+	double span_s = (uint32_t)(log.back().timestamp - log.front().timestamp) * 1e-6;
+	ImuFusionGyroBias(bias);
+	printf("%zu samples, %.1f s of data (%.0f Hz), %u accelerometer updates (divider %u)\n", log.size(), span_s,
+		   (log.size() - 1) / span_s, updates, opt.fusion.update_divider);
+	printf("processing: %.1f ms total, %.0f samples/s, %.0f updates/s (%.1fx real time)\n", total_us / 1000,
+		   log.size() / (total_us * 1e-6), updates / (total_us * 1e-6), span_s / (total_us * 1e-6));
+	printf("latency per sample (host):\n");
+	Percentiles("prediction", predict_us);
+	Percentiles("prediction+update", update_us);
+	printf("final attitude q = [%.4f %.4f %.4f %.4f], gyro bias = [%.4f %.4f %.4f] rad/s\n",
+		   att.q[0], att.q[1], att.q[2], att.q[3], bias[0], bias[1], bias[2]);
+	if(tilt_n > 0){
+		printf("tilt error: mean %.2f deg, max %.2f deg\n", tilt_sum / tilt_n, tilt_max);
+	}
+	return 0;
+}
+
+/*==================[end of file]============================================*/
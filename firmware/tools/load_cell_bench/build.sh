@@ -0,0 +1,8 @@
+#!/bin/sh
+# Builds load_cell_bench for the host with the load_cell_filter source.
+set -e
+cd "$(dirname "$0")"
+MW=../../middelware/signal_processing
+mkdir -p build
+${CC:-cc} -O2 -I$MW/inc -o build/load_cell_bench load_cell_bench.c $MW/src/load_cell_filter.c -lm
+echo "build/load_cell_bench"
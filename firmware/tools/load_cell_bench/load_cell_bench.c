@@ -0,0 +1,248 @@
+/**
+ * @file load_cell_bench.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host benchmark of load_cell_filter against a block average
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Runs a trace of HX711 samples through load_cell_filter (the same source
+ * used by the firmware, up to LoadCellFilterUnits()) and through the
+ * arithmetic of HX711_getUnits(10): integer average of 10 samples, double
+ * OFFSET subtraction and float SCALE division. Both get the samples the way
+ * HX711_read() returns them (offset binary, 0 at 0x800000), are tared to
+ * 0x800000 and have scale 1, so the outputs stay in counts. It reports for
+ * each one:
+ * - settling: samples after a load change until the output stays within
+ *   +-tolerance counts of the true load up to the next change,
+ * - rms error over the second half of every load (stable output),
+ * - host time per sample.
+ *
+ * The host has hardware double and float, so the time doesn't show the
+ * soft-float cost of HX711_getUnits() on the ESP32-C6 (no FPU).
+ *
+ * Trace: one sample per line, "raw,true" (counts). The true load is only
+ * used for the error figures; a recorded log can set it to the reference
+ * weight times the counts per unit. Lines that don't start with a number are
+ * skipped. steps_synthetic.csv was made with --synth: 30-count gaussian
+ * noise, 1% spikes of +-5000 counts and 0 / 42000 count steps every 1000
+ * samples.
+ *
+ * Build (from this folder): ./build.sh
+ *
+ * Usage:
+ *   load_cell_bench steps_synthetic.csv [--tolerance 42]
+ *   load_cell_bench --synth > trace.csv
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "load_cell_filter.h"
+/*==================[macros and definitions]=================================*/
+#define SAMPLES_MAX		100000
+#define BLOCK			10		/*!< Samples of HX711_getUnits(10) */
+#define HX711_ZERO		0x800000	/*!< HX711_read() of a 0 count sample */
+#define TIMING_LOOPS	200		/*!< Trace repetitions for the time per sample */
+#define SYNTH_SEGMENT	1000
+#define SYNTH_SEGMENTS	6
+#define SYNTH_LOAD		42000
+#define SYNTH_NOISE		30.0
+#define SYNTH_SPIKE		5000
+
+typedef struct {
+	const char *name;
+	double settle_mean;
+	uint32_t settle_max;
+	uint32_t unsettled;		/*!< Loads where the output never settled */
+	double rms;
+	double ns_per_sample;
+} result_t;
+/*==================[internal data definition]===============================*/
+static int32_t raw[SAMPLES_MAX];
+static int32_t truth[SAMPLES_MAX];
+static int32_t out[SAMPLES_MAX];
+static uint32_t samples;
+double hx711_offset = HX711_ZERO;	/*!< OFFSET of hx711.c (not static, so it isn't folded) */
+float hx711_scale = 1;			/*!< SCALE of hx711.c */
+static const load_cell_filter_config_t filter_cfg = {
+	.median_size = 3,
+	.min_window_log2 = 0,
+	.max_window_log2 = 5,
+	.step_threshold = 500,
+};
+/*==================[internal functions definition]==========================*/
+static uint32_t Lcg(uint32_t *seed){
+	*seed = *seed * 1664525u + 1013904223u;
+	return *seed >> 8;
+}
+
+static double Uniform(uint32_t *seed){
+	return (Lcg(seed) + 0.5) / (double)(1u << 24);
+}
+
+static void Synthesize(void){
+	uint32_t seed = 1;
+	printf("raw,true\n");
+	for(uint32_t k = 0; k < SYNTH_SEGMENT * SYNTH_SEGMENTS; k++){
+		int32_t load = ((k / SYNTH_SEGMENT) % 2) ? SYNTH_LOAD : 0;
+		/* Box-Muller */
+		double noise = SYNTH_NOISE * sqrt(-2 * log(Uniform(&seed))) * cos(2 * M_PI * Uniform(&seed));
+		int32_t r = load + (int32_t)lround(noise);
+		if(Uniform(&seed) < 0.01){
+			r += (Uniform(&seed) < 0.5) ? SYNTH_SPIKE : -SYNTH_SPIKE;
+		}
+		printf("%d,%d\n", r, load);
+	}
+}
+
+static bool ReadTrace(const char *path){
+	FILE *f = fopen(path, "r");
+	char line[128];
+	if(f == NULL){
+		perror(path);
+		return false;
+	}
+	samples = 0;
+	while((fgets(line, sizeof(line), f) != NULL) && (samples < SAMPLES_MAX)){
+		long r, t;
+		if(sscanf(line, "%ld,%ld", &r, &t) == 2){
+			raw[samples] = r;
+			truth[samples] = t;
+			samples++;
+		}
+	}
+	fclose(f);
+	return samples > 0;
+}
+
+static void RunFilter(void){
+	load_cell_filter_t filter;
+	LoadCellFilterInit(&filter, &filter_cfg);
+	LoadCellFilterSetOffset(&filter, HX711_ZERO);
+	for(uint32_t k = 0; k < samples; k++){
+		LoadCellFilterUpdate(&filter, raw[k] + HX711_ZERO);
+		out[k] = LoadCellFilterUnits(&filter);
+	}
+}
+
+/**
+ * @brief HX711_getUnits(BLOCK): readAverage() / getValue() / getUnits() arithmetic
+ */
+static void RunBlock(void){
+	uint32_t sum = 0;
+	int32_t value = raw[0];
+	for(uint32_t k = 0; k < samples; k++){
+		sum += (uint32_t)(raw[k] + HX711_ZERO);
+		if((k % BLOCK) == BLOCK - 1){
+			double counts = (sum / BLOCK) - hx711_offset;
+			float units = counts / hx711_scale;
+			value = (int32_t)units;
+			sum = 0;
+		}
+		out[k] = value;
+	}
+}
+
+static double NsPerSample(void (*run)(void)){
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(uint32_t i = 0; i < TIMING_LOOPS; i++){
+		run();
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / ((double)TIMING_LOOPS * samples);
+}
+
+/**
+ * @brief Error figures of out[] for every constant load of the trace
+ */
+static void Evaluate(result_t *res, int32_t tolerance){
+	uint32_t begin = 0, loads = 0, rms_n = 0;
+	double settle_sum = 0, rms_sum = 0;
+	res->settle_max = 0;
+	res->unsettled = 0;
+	while(begin < samples){
+		uint32_t end = begin;
+		uint32_t settle = 0;
+		while((end < samples) && (truth[end] == truth[begin])){
+			end++;
+		}
+		/* Last sample out of tolerance */
+		for(uint32_t k = begin; k < end; k++){
+			if(abs(out[k] - truth[k]) > tolerance){
+				settle = k - begin + 1;
+			}
+		}
+		if(begin > 0){
+			if(settle == end - begin){
+				res->unsettled++;
+			} else{
+				settle_sum += settle;
+				loads++;
+				if(settle > res->settle_max){
+					res->settle_max = settle;
+				}
+			}
+		}
+		for(uint32_t k = begin + (end - begin) / 2; k < end; k++){
+			double e = out[k] - truth[k];
+			rms_sum += e * e;
+			rms_n++;
+		}
+		begin = end;
+	}
+	res->settle_mean = loads ? settle_sum / loads : NAN;
+	res->rms = rms_n ? sqrt(rms_sum / rms_n) : NAN;
+}
+
+static void Report(const result_t *r){
+	printf("  %-30s settling mean %6.1f max %4u samples (%u loads never settled)  rms %7.1f counts  %5.1f ns/sample\n",
+		   r->name, r->settle_mean, r->settle_max, r->unsettled, r->rms, r->ns_per_sample);
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char **argv){
+	const char *trace = NULL;
+	int32_t tolerance = 42;
+	result_t filter_res = {.name = "median3 + window 1..32"};
+	result_t block_res = {.name = "HX711_getUnits(10)"};
+
+	for(int i = 1; i < argc; i++){
+		if(!strcmp(argv[i], "--synth")){
+			Synthesize();
+			return 0;
+		} else if(!strcmp(argv[i], "--tolerance") && (i + 1 < argc)){
+			tolerance = atoi(argv[++i]);
+		} else if(argv[i][0] != '-'){
+			trace = argv[i];
+		} else{
+			trace = NULL;
+			break;
+		}
+	}
+	if(trace == NULL){
+		fprintf(stderr, "usage: load_cell_bench TRACE.csv [--tolerance COUNTS] | --synth\n");
+		return 1;
+	}
+	if(!ReadTrace(trace)){
+		fprintf(stderr, "no samples\n");
+		return 1;
+	}
+
+	printf("%u samples, tolerance +-%d counts\n", samples, tolerance);
+	RunFilter();
+	Evaluate(&filter_res, tolerance);
+	filter_res.ns_per_sample = NsPerSample(RunFilter);
+	RunBlock();
+	Evaluate(&block_res, tolerance);
+	block_res.ns_per_sample = NsPerSample(RunBlock);
+	Report(&filter_res);
+	Report(&block_res);
+	return 0;
+}
+
+/*==================[end of file]============================================*/
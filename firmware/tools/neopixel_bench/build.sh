@@ -0,0 +1,11 @@
+#!/bin/sh
+# Builds neopixel_bench for the host with the NeoPixel effects and color
+# sources. host/ has the ESP-IDF headers included by neopixel_stripe.h.
+set -e
+cd "$(dirname "$0")"
+DRV=../../drivers
+mkdir -p build
+${CC:-cc} -O2 -Ihost -I$DRV/devices/inc -I$DRV/microcontroller/inc -o build/neopixel_bench neopixel_bench.c \
+	$DRV/devices/src/neopixel_fx_render.c \
+	$DRV/devices/src/neopixel_color.c
+echo "build/neopixel_bench"
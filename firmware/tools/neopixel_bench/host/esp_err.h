@@ -0,0 +1,5 @@
+/* Host build of neopixel_bench: the part of esp_err.h used by neopixel_stripe.h */
+#pragma once
+typedef int esp_err_t;
+#define ESP_OK		0
+#define ESP_FAIL	-1
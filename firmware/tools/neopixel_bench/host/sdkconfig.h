@@ -0,0 +1,2 @@
+/* Host build of neopixel_bench: no target */
+#pragma once
@@ -0,0 +1,166 @@
+/**
+ * @file neopixel_bench.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host benchmark of the NeoPixel effects rendering
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+/*
+ * Renders frames with neopixel_fx_render (the same source used by the
+ * firmware, without the task and the mutex of neopixel_effects) and reports
+ * the host time per frame of each effect. For comparison it also times the
+ * rainbow loops of NeoPixelRainbow(): the current one (hue step per led) and
+ * the one before the effects engine (multiply and divide per led), both
+ * calling NeoPixelHSV2Color() for every led.
+ *
+ * Only the rendering is timed: encoding and sending a frame are done by
+ * neopixel_stripe and are the same for every effect.
+ *
+ * Build (from this folder): ./build.sh
+ *
+ * Usage:
+ *   neopixel_bench [--leds 300] [--frames 100000]
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "neopixel_fx_render.h"
+/*==================[macros and definitions]=================================*/
+#define LEDS_MAX		1024
+/*==================[internal data definition]===============================*/
+static neopixel_color_t frame[LEDS_MAX];
+static uint16_t leds = 300;
+static uint32_t frames = 100000;
+static uint32_t checksum;		/*!< Keeps the compiler from dropping the frames */
+/*==================[internal functions definition]==========================*/
+static double Now(void){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static void Sum(void){
+	for(uint16_t i = 0; i < leds; i++){
+		checksum += frame[i];
+	}
+}
+
+/**
+ * @brief Time per frame (us) with the given layers
+ */
+static double BenchLayers(const neopixel_fx_t *fx, uint8_t qty){
+	double start;
+	NeoPixelFxRenderInit(frame, leds);
+	for(uint8_t l = 0; l < qty; l++){
+		if(!NeoPixelFxRenderSetLayer(l, &fx[l])){
+			fprintf(stderr, "invalid layer %u\n", l);
+			exit(1);
+		}
+	}
+	start = Now();
+	for(uint32_t f = 0; f < frames; f++){
+		NeoPixelFxRenderFrame();
+	}
+	start = (Now() - start) / frames / 1000;
+	Sum();
+	return start;
+}
+
+/**
+ * @brief Time per frame (us) of the NeoPixelRainbow() loop
+ *
+ * @param incremental   true: hue step per led (current), false: multiply and divide per led (before)
+ */
+static double BenchHsvLoop(bool incremental){
+	const uint8_t reps = 1;
+	double start = Now();
+	for(uint32_t f = 0; f < frames; f++){
+		uint16_t first_hue = f * 64;
+		if(incremental){
+			uint32_t hue = (uint32_t)first_hue << 16;
+			uint32_t step = (uint32_t)(((uint64_t)reps << 32) / leds);
+			for(uint16_t i = 0; i < leds; i++){
+				frame[i] = NeoPixelHSV2Color(hue >> 16, 255, 255);
+				hue += step;
+			}
+		} else{
+			for(uint16_t i = 0; i < leds; i++){
+				uint16_t hue = first_hue + (i * reps * 65536) / leds;
+				frame[i] = NeoPixelHSV2Color(hue, 255, 255);
+			}
+		}
+		/* Like NeoPixelSetArray(), the frame is read after each loop */
+		checksum += frame[f % leds];
+	}
+	start = (Now() - start) / frames / 1000;
+	Sum();
+	return start;
+}
+
+static void Usage(void){
+	fprintf(stderr, "usage: neopixel_bench [--leds N] [--frames N]\n");
+	exit(1);
+}
+/*==================[external functions definition]==========================*/
+int main(int argc, char **argv){
+	const neopixel_fx_t rainbow = {
+		.type = NEOPIXEL_FX_RAINBOW, .period = 300, .sat = 255, .val = 255, .reps = 1,
+	};
+	const neopixel_fx_t rainbow_sv = {
+		.type = NEOPIXEL_FX_RAINBOW, .period = 300, .sat = 200, .val = 128, .reps = 2,
+	};
+	const neopixel_fx_t chase = {
+		.type = NEOPIXEL_FX_CHASE, .period = 3, .color = NEOPIXEL_COLOR_ORANGE, .size = 3, .spacing = 5,
+	};
+	const neopixel_fx_t fade = {
+		.type = NEOPIXEL_FX_FADE, .period = (uint16_t)-1, .color = NEOPIXEL_COLOR_BLUE,
+		.color_end = NEOPIXEL_COLOR_RED,
+	};
+	const neopixel_fx_t breathe = {
+		.type = NEOPIXEL_FX_BREATHE, .period = 120, .color = NEOPIXEL_COLOR_CYAN,
+	};
+	const neopixel_fx_t sparkle = {
+		.type = NEOPIXEL_FX_SPARKLE, .period = 20, .color = NEOPIXEL_COLOR_WHITE, .density = 20,
+	};
+	const neopixel_fx_t stack[NEOPIXEL_FX_LAYERS] = {
+		rainbow_sv,
+		{.type = NEOPIXEL_FX_CHASE, .blend = NEOPIXEL_BLEND_ADD, .period = 3, .color = NEOPIXEL_COLOR_ROSE,
+		 .size = 2, .spacing = 10},
+		{.type = NEOPIXEL_FX_BREATHE, .blend = NEOPIXEL_BLEND_ALPHA, .alpha = 96, .period = 120,
+		 .color = NEOPIXEL_COLOR_BLUE},
+		{.type = NEOPIXEL_FX_SPARKLE, .blend = NEOPIXEL_BLEND_MAX, .period = 20, .color = NEOPIXEL_COLOR_WHITE,
+		 .density = 20},
+	};
+
+	for(int i = 1; i < argc; i += 2){
+		if(i + 1 >= argc) Usage();
+		long v = atol(argv[i + 1]);
+		if(!strcmp(argv[i], "--leds")) leds = v;
+		else if(!strcmp(argv[i], "--frames")) frames = v;
+		else Usage();
+	}
+	if((leds == 0) || (leds > LEDS_MAX) || (frames == 0)){
+		Usage();
+	}
+
+	printf("%u leds, %u frames, render time per frame\n", leds, frames);
+	printf("  %-36s %6.2f us\n", "rainbow", BenchLayers(&rainbow, 1));
+	printf("  %-36s %6.2f us\n", "rainbow with sat/val", BenchLayers(&rainbow_sv, 1));
+	printf("  %-36s %6.2f us\n", "HSV2Color per led, hue step", BenchHsvLoop(true));
+	printf("  %-36s %6.2f us\n", "HSV2Color per led, multiply/divide", BenchHsvLoop(false));
+	printf("  %-36s %6.2f us\n", "chase", BenchLayers(&chase, 1));
+	printf("  %-36s %6.2f us\n", "fade", BenchLayers(&fade, 1));
+	printf("  %-36s %6.2f us\n", "breathe", BenchLayers(&breathe, 1));
+	printf("  %-36s %6.2f us\n", "sparkle", BenchLayers(&sparkle, 1));
+	printf("  %-36s %6.2f us\n", "4 blended layers", BenchLayers(stack, NEOPIXEL_FX_LAYERS));
+	printf("(checksum %08x)\n", checksum);
+	return 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,10 @@
+#!/bin/sh
+# Builds spi_batch_check for the host with the spi_mcu source and a mock
+# SPI master. host/ has the ESP-IDF headers spi_mcu includes.
+set -e
+cd "$(dirname "$0")"
+DRV=../../drivers
+mkdir -p build
+${CC:-cc} -O2 -Ihost -I$DRV/microcontroller/inc -o build/spi_batch_check spi_batch_check.c \
+	$DRV/microcontroller/src/spi_mcu.c
+echo "build/spi_batch_check"
@@ -0,0 +1,6 @@
+/* Host build of spi_batch_check: ticks are milliseconds */
+#pragma once
+#include <stdint.h>
+typedef uint32_t TickType_t;
+#define portMAX_DELAY			((TickType_t)0xFFFFFFFF)
+#define pdMS_TO_TICKS(ms)		((TickType_t)(ms))
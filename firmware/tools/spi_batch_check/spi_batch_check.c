@@ -0,0 +1,244 @@
+/**
+ * @file spi_batch_check.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host checks of the SPI batches of spi_mcu
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+/*
+ * Runs spi_mcu (the same source used by the firmware) on a mock SPI master.
+ * Like the ESP-IDF driver, each device holds at most queue_size transactions
+ * that were queued and not collected with spi_device_get_trans_result():
+ * queueing one more would block forever, and the mock reports it as a
+ * deadlock. Transactions end as soon as they are queued; the mock answers
+ * each byte with its complement.
+ *
+ * Checks:
+ * - a batch of SPI_BATCH_MAX transfers on a single device,
+ * - a batch spread over the three devices, with data inside and outside the
+ *   transactions,
+ * - batches that must be rejected (too long, device not initialized).
+ *
+ * Build (from this folder): ./build.sh
+ *
+ * Usage:
+ *   spi_batch_check        (exit status 1 if a check fails)
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "spi_mcu.h"
+#include "driver/spi_master.h"
+/*==================[macros and definitions]=================================*/
+#define DEVICES_MAX		3
+#define QUEUE_MAX		64
+#define DATA_MAX		16
+
+struct spi_device_t {
+	spi_device_interface_config_t cfg;
+	spi_transaction_t *queue[QUEUE_MAX];	/*!< Transactions not collected yet, oldest first */
+	uint16_t first;
+	uint16_t qty;
+	bool used;
+};
+/*==================[internal data definition]===============================*/
+static struct spi_device_t devices[DEVICES_MAX];
+static bool deadlock = false;
+static uint32_t done_calls = 0;
+/*==================[internal functions definition]==========================*/
+static void BatchDone(void *param){
+	done_calls++;
+}
+
+static bool Check(bool condition, const char *what){
+	if(!condition){
+		printf("    FAILED: %s\n", what);
+	}
+	return condition;
+}
+
+static bool InitDevice(spi_dev_t device){
+	spi_mcu_config_t cfg = {
+		.device = device,
+		.clk_mode = MODE0,
+		.bitrate = 1000000,
+		.transfer_mode = SPI_POLLING,
+	};
+	return SpiInit(&cfg) == 0;
+}
+
+/**
+ * @brief Runs a batch where transfer i writes size bytes of value i (and reads them back complemented)
+ */
+static bool RunBatch(const spi_dev_t *device_of, uint8_t count, const uint32_t *sizes){
+	static uint8_t tx[SPI_BATCH_MAX][DATA_MAX];
+	static uint8_t rx[SPI_BATCH_MAX][DATA_MAX];
+	spi_transfer_t transfers[SPI_BATCH_MAX];
+	bool ok = true;
+
+	memset(rx, 0, sizeof(rx));
+	deadlock = false;
+	done_calls = 0;
+	for(uint8_t i = 0; i < count; i++){
+		memset(tx[i], i, sizes[i]);
+		transfers[i] = (spi_transfer_t){
+			.device = device_of[i], .tx_buffer = tx[i], .rx_buffer = rx[i], .size = sizes[i],
+		};
+	}
+	ok &= Check(SpiBatchStart(transfers, count, BatchDone, NULL), "SpiBatchStart()");
+	ok &= Check(!deadlock, "no device queue overflow");
+	if(!ok){
+		return false;
+	}
+	ok &= Check(SpiBatchWait(100), "SpiBatchWait()");
+	ok &= Check(done_calls == 1, "done callback called once");
+	for(uint8_t i = 0; i < count; i++){
+		for(uint32_t j = 0; j < sizes[i]; j++){
+			if(rx[i][j] != (uint8_t)~i){
+				printf("    FAILED: transfer %u byte %u: %02x\n", i, j, rx[i][j]);
+				return false;
+			}
+		}
+	}
+	return ok;
+}
+
+static bool SingleDeviceBatch(void){
+	spi_dev_t device_of[SPI_BATCH_MAX];
+	uint32_t sizes[SPI_BATCH_MAX];
+	for(uint8_t i = 0; i < SPI_BATCH_MAX; i++){
+		device_of[i] = SPI_1;
+		sizes[i] = (i % 2) ? 2 : 6;
+	}
+	return RunBatch(device_of, SPI_BATCH_MAX, sizes);
+}
+
+static bool MultiDeviceBatch(void){
+	spi_dev_t device_of[SPI_BATCH_MAX];
+	uint32_t sizes[SPI_BATCH_MAX];
+	for(uint8_t i = 0; i < SPI_BATCH_MAX; i++){
+		device_of[i] = (spi_dev_t)(i % DEVICES_MAX);
+		sizes[i] = 1 + (i % DATA_MAX);
+	}
+	/* Twice: the second batch starts after the first one was collected */
+	return RunBatch(device_of, SPI_BATCH_MAX, sizes) && RunBatch(device_of, SPI_BATCH_MAX / 2, sizes);
+}
+
+static bool RejectedBatches(void){
+	spi_transfer_t transfers[SPI_BATCH_MAX + 1];
+	uint8_t data[1] = {0};
+	bool ok = true;
+	for(uint8_t i = 0; i < SPI_BATCH_MAX + 1; i++){
+		transfers[i] = (spi_transfer_t){.device = SPI_1, .tx_buffer = data, .size = 1};
+	}
+	ok &= Check(!SpiBatchStart(transfers, SPI_BATCH_MAX + 1, NULL, NULL), "batch over SPI_BATCH_MAX rejected");
+	ok &= Check(!SpiBatchStart(transfers, 0, NULL, NULL), "empty batch rejected");
+	SpiDeInit(SPI_3);
+	transfers[3].device = SPI_3;
+	ok &= Check(!SpiBatchStart(transfers, 4, NULL, NULL), "batch with a device not initialized rejected");
+	ok &= Check(InitDevice(SPI_3), "SpiInit()");
+	return ok;
+}
+/*==================[mock platform]==========================================*/
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan){
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config,
+							 spi_device_handle_t *handle){
+	for(uint8_t i = 0; i < DEVICES_MAX; i++){
+		if(!devices[i].used){
+			if((dev_config->queue_size <= 0) || (dev_config->queue_size > QUEUE_MAX)){
+				return ESP_FAIL;
+			}
+			memset(&devices[i], 0, sizeof(devices[i]));
+			devices[i].cfg = *dev_config;
+			devices[i].used = true;
+			*handle = &devices[i];
+			return ESP_OK;
+		}
+	}
+	return ESP_FAIL;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle){
+	handle->used = false;
+	return ESP_OK;
+}
+
+/**
+ * @brief Ends a transaction: received bytes are the complement of the sent ones
+ */
+static void Execute(spi_device_handle_t handle, spi_transaction_t *t){
+	const uint8_t *tx = (t->flags & SPI_TRANS_USE_TXDATA) ? t->tx_data : t->tx_buffer;
+	uint8_t *rx = (t->flags & SPI_TRANS_USE_RXDATA) ? t->rx_data : t->rx_buffer;
+	for(uint32_t i = 0; (rx != NULL) && (i < t->rxlength / 8); i++){
+		rx[i] = (tx != NULL) ? ~tx[i] : 0xFF;
+	}
+	if(handle->cfg.post_cb != NULL){
+		handle->cfg.post_cb(t);
+	}
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *t, TickType_t ticks_to_wait){
+	if(handle->qty >= handle->cfg.queue_size){
+		/* Would wait for a slot that only spi_device_get_trans_result() frees */
+		deadlock = true;
+		return ESP_ERR_TIMEOUT;
+	}
+	handle->queue[(handle->first + handle->qty) % QUEUE_MAX] = t;
+	handle->qty++;
+	Execute(handle, t);
+	return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **t, TickType_t ticks_to_wait){
+	if(handle->qty == 0){
+		return ESP_ERR_TIMEOUT;
+	}
+	*t = handle->queue[handle->first];
+	handle->first = (handle->first + 1) % QUEUE_MAX;
+	handle->qty--;
+	return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *t){
+	Execute(handle, t);
+	return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *t){
+	Execute(handle, t);
+	return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait){
+	return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t dev){}
+/*==================[external functions definition]==========================*/
+int main(int argc, char **argv){
+	bool ok = true;
+	for(uint8_t d = 0; d < DEVICES_MAX; d++){
+		if(!InitDevice((spi_dev_t)d)){
+			printf("SpiInit(%u) failed\n", d);
+			return 1;
+		}
+	}
+	printf("batch of %u transfers on one device\n", SPI_BATCH_MAX);
+	ok &= SingleDeviceBatch();
+	printf("batch of %u transfers on %u devices\n", SPI_BATCH_MAX, DEVICES_MAX);
+	ok &= MultiDeviceBatch();
+	printf("rejected batches\n");
+	ok &= RejectedBatches();
+	printf("%s\n", ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+/*==================[end of file]============================================*/